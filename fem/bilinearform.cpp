@@ -141,6 +141,14 @@ void BilinearForm::SetAssemblyLevel(AssemblyLevel assembly_level)
    }
 }
 
+void BilinearForm::EnableIncrementalPA(bool enable)
+{
+   PABilinearFormExtension *pa_ext =
+      dynamic_cast<PABilinearFormExtension*>(ext);
+   MFEM_VERIFY(pa_ext, "partial assembly is not enabled");
+   pa_ext->EnableIncrementalAssembly(enable);
+}
+
 void BilinearForm::EnableStaticCondensation()
 {
    delete static_cond;
@@ -995,6 +1003,19 @@ void BilinearForm::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void BilinearForm::ArrayMult(const Array<const Vector *> &X,
+                             Array<Vector *> &Y) const
+{
+   if (ext)
+   {
+      ext->ArrayMult(X, Y);
+   }
+   else
+   {
+      mat->ArrayMult(X, Y);
+   }
+}
+
 void BilinearForm::Update(FiniteElementSpace *nfes)
 {
    bool full_update;
@@ -156,6 +156,15 @@ public:
    /// Get the assembly level
    AssemblyLevel GetAssemblyLevel() {return assembly;}
 
+   /** @brief Reuse the partial assembly data of the elements that did not
+       change in a mesh refinement, see PABilinearFormExtension::Update(). */
+   /** This method requires AssemblyLevel::PARTIAL. When enabled, Update()
+       and Assemble() after a single refinement of the mesh recompute the data
+       only for the new elements, if supported by the integrators. The
+       coefficients must not have changed on the other elements since the
+       previous Assemble(). */
+   void EnableIncrementalPA(bool enable = true);
+
    /** Enable the use of static condensation. For details see the description
        for class StaticCondensation in fem/staticcond.hpp This method should be
        called before assembly. If the number of unknowns after static
@@ -232,6 +241,10 @@ public:
    /// Matrix vector multiplication.
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /// Matrix multiplication with a set of vectors, see Operator::ArrayMult().
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    void FullMult(const Vector &x, Vector &y) const
    { mat->Mult(x, y); mat_e->AddMult(x, y); }
 
@@ -40,7 +40,9 @@ const Operator *BilinearFormExtension::GetRestriction() const
 PABilinearFormExtension::PABilinearFormExtension(BilinearForm *form)
    : BilinearFormExtension(form),
      trialFes(a->FESpace()),
-     testFes(a->FESpace())
+     testFes(a->FESpace()),
+     incremental(false),
+     assembled_sequence(-1)
 {
    const Operator* elem_restrict =
       trialFes->GetElementRestriction(UsesTensorBasis(*a->FESpace())?
@@ -60,10 +62,14 @@ void PABilinearFormExtension::Assemble()
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
    const int integratorCount = integrators.Size();
+   const bool update = (old_elem.Size() > 0);
    for (int i = 0; i < integratorCount; ++i)
    {
-      integrators[i]->AssemblePA(*a->FESpace());
+      if (update) { integrators[i]->UpdatePA(*a->FESpace(), old_elem); }
+      else { integrators[i]->AssemblePA(*a->FESpace()); }
    }
+   old_elem.DeleteAll();
+   assembled_sequence = a->FESpace()->GetMesh()->GetSequence();
 }
 
 void PABilinearFormExtension::AssembleDiagonal(Vector &y) const
@@ -110,6 +116,36 @@ void PABilinearFormExtension::Update()
       localX.SetSize(elem_restrict_lex->Height());
       localY.SetSize(elem_restrict_lex->Height());
    }
+
+   old_elem.DeleteAll();
+   Mesh *mesh = fes->GetMesh();
+   if (incremental && mesh->GetLastOperation() == Mesh::REFINE &&
+       mesh->GetSequence() == assembled_sequence + 1)
+   {
+      // an element did not change if its embedding in the parent element is
+      // the identity (each vertex maps to itself)
+      const CoarseFineTransformations &rtrans =
+         mesh->GetRefinementTransforms();
+      old_elem.SetSize(mesh->GetNE());
+      for (int e = 0; e < mesh->GetNE(); e++)
+      {
+         const Embedding &emb = rtrans.embeddings[e];
+         const Geometry::Type geom = mesh->GetElementBaseGeometry(e);
+         const DenseMatrix &pm = rtrans.point_matrices[geom](emb.matrix);
+         const IntegrationRule *vert = Geometries.GetVertices(geom);
+         bool identity = true;
+         for (int j = 0; j < pm.Width(); j++)
+         {
+            const IntegrationPoint &ip = vert->IntPoint(j);
+            const double x[3] = { ip.x, ip.y, ip.z };
+            for (int d = 0; d < pm.Height(); d++)
+            {
+               if (pm(d,j) != x[d]) { identity = false; }
+            }
+         }
+         old_elem[e] = identity ? emb.parent : -1;
+      }
+   }
 }
 
 void PABilinearFormExtension::FormSystemMatrix(const Array<int> &ess_tdof_list,
@@ -157,6 +193,64 @@ void PABilinearFormExtension::Mult(const Vector &x, Vector &y) const
    }
 }
 
+void PABilinearFormExtension::ArrayMult(const Array<const Vector *> &X,
+                                        Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "incompatible sizes");
+   const int nv = X.Size();
+   if (DeviceCanUseCeed() || !elem_restrict_lex || nv < 2)
+   {
+      Operator::ArrayMult(X, Y);
+      return;
+   }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int esize = elem_restrict_lex->Height();
+   arrayX.SetSize(nv*esize, Device::GetMemoryType());
+   arrayY.SetSize(nv*esize, Device::GetMemoryType());
+   arrayY.UseDevice(true);
+   Vector xe, ye;
+   for (int v = 0; v < nv; v++)
+   {
+      xe.NewMemoryAndSize(Memory<double>(arrayX.GetMemory(), v*esize, esize),
+                          esize, false);
+      elem_restrict_lex->Mult(*X[v], xe);
+   }
+   arrayY = 0.0;
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      integrators[i]->AddArrayMultPA(nv, arrayX, arrayY);
+   }
+   for (int v = 0; v < nv; v++)
+   {
+      ye.NewMemoryAndSize(Memory<double>(arrayY.GetMemory(), v*esize, esize),
+                          esize, false);
+      elem_restrict_lex->MultTranspose(ye, *Y[v]);
+   }
+}
+
+bool PABilinearFormExtension::SupportsElements() const
+{
+   if (!elem_restrict_lex) { return false; }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   for (int i = 0; i < integrators.Size(); ++i)
+   {
+      if (!integrators[i]->SupportsElementsPA()) { return false; }
+   }
+   return true;
+}
+
+void PABilinearFormExtension::AddMultElements(const Vector &lx, Vector &ly,
+                                              const Array<int> &elems) const
+{
+   if (elems.Size() == 0) { return; }
+   Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
+   const int iSz = integrators.Size();
+   for (int i = 0; i < iSz; ++i)
+   {
+      integrators[i]->AddMultElementsPA(lx, ly, elems);
+   }
+}
+
 void PABilinearFormExtension::MultTranspose(const Vector &x, Vector &y) const
 {
    Array<BilinearFormIntegrator*> &integrators = *a->GetDBFI();
@@ -104,8 +104,13 @@ class PABilinearFormExtension : public BilinearFormExtension
 protected:
    const FiniteElementSpace *trialFes, *testFes; // Not owned
    mutable Vector localX, localY;
+   mutable Vector arrayX, arrayY; ///< E-vectors used by ArrayMult()
    const ElementRestriction *elem_restrict_lex; // Not owned
 
+   bool incremental; ///< see EnableIncrementalAssembly()
+   long assembled_sequence; ///< Mesh sequence of the last Assemble()
+   Array<int> old_elem; ///< unchanged elements, see Update()
+
 public:
    PABilinearFormExtension(BilinearForm*);
 
@@ -119,7 +124,38 @@ public:
 
    void Mult(const Vector &x, Vector &y) const;
    void MultTranspose(const Vector &x, Vector &y) const;
+
+   /** @brief Apply the operator to a set of vectors, reading the partial
+       assembly data once for all vectors, see
+       BilinearFormIntegrator::AddArrayMultPA(). */
+   void ArrayMult(const Array<const Vector *> &X, Array<Vector *> &Y) const;
+
+   /** @brief Update the operator after its space was updated. If incremental
+       assembly is enabled and the mesh was refined once since the last
+       Assemble(), record the elements that did not change so that the next
+       Assemble() can call BilinearFormIntegrator::UpdatePA(). */
    void Update();
+
+   /// Enable the reuse of the data of the unchanged elements, see Update().
+   void EnableIncrementalAssembly(bool enable = true)
+   { incremental = enable; }
+
+   /// Return the restriction from L-vectors to E-vectors used by Mult().
+   /** Returns NULL if the E-vectors are not formed explicitly. */
+   const ElementRestriction *GetElementRestriction() const
+   { return elem_restrict_lex; }
+
+   /** @brief Returns true if the integrators can be applied to a subset of the
+       elements, see AddMultElements(). */
+   bool SupportsElements() const;
+
+   /** @brief Add the action of the integrators on the elements listed in
+       @a elems to the E-vector @a ly, given the E-vector @a lx. */
+   /** The E-vectors are for all elements, as returned by
+       GetElementRestriction(); the entries of @a ly of the other elements are
+       not changed. */
+   void AddMultElements(const Vector &lx, Vector &ly,
+                        const Array<int> &elems) const;
 };
 
 
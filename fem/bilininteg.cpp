@@ -33,6 +33,63 @@ void BilinearFormIntegrator::AssemblePA(const FiniteElementSpace&,
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::UpdatePA(const FiniteElementSpace &fes,
+                                      const Array<int> &)
+{
+   AssemblePA(fes);
+}
+
+void BilinearFormIntegrator::GetPAElementData(const FiniteElementSpace &fes,
+                                              const IntegrationRule &ir,
+                                              Coefficient *Q,
+                                              const Array<int> &elems,
+                                              Vector &J, Vector &coeff)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int sdim = mesh->SpaceDimension();
+   const int dim = mesh->Dimension();
+   const int NQ = ir.GetNPoints();
+   const int NE = elems.Size();
+   ConstantCoefficient *cQ = dynamic_cast<ConstantCoefficient*>(Q);
+
+   J.SetSize(NQ*sdim*dim*NE);
+   coeff.SetSize((Q && !cQ) ? NQ*NE : 1);
+   double *h_J = J.HostWrite(), *h_C = coeff.HostWrite();
+   if (coeff.Size() == 1) { h_C[0] = cQ ? cQ->constant : 1.0; }
+   for (int i = 0; i < NE; i++)
+   {
+      ElementTransformation &T = *fes.GetElementTransformation(elems[i]);
+      for (int q = 0; q < NQ; q++)
+      {
+         const IntegrationPoint &ip = ir.IntPoint(q);
+         T.SetIntPoint(&ip);
+         const double *Jq = T.Jacobian().Data();
+         for (int k = 0; k < sdim*dim; k++)
+         {
+            h_J[q + NQ*(k + sdim*dim*i)] = Jq[k];
+         }
+         if (coeff.Size() > 1) { h_C[q + NQ*i] = Q->Eval(T, ip); }
+      }
+   }
+}
+
+void BilinearFormIntegrator::MergePAData(const Array<int> &old_elem,
+                                         const int size,
+                                         const Vector &old_data,
+                                         const Vector &new_data,
+                                         Vector &pa_data)
+{
+   const double *h_old = old_data.HostRead(), *h_new = new_data.HostRead();
+   double *h_pa = pa_data.HostWrite();
+   for (int e = 0, i = 0; e < old_elem.Size(); e++)
+   {
+      const double *src;
+      if (old_elem[e] >= 0) { src = h_old + size*old_elem[e]; }
+      else { src = h_new + size*(i++); }
+      std::copy(src, src + size, h_pa + size*e);
+   }
+}
+
 void BilinearFormIntegrator::AssembleDiagonalPA(Vector &)
 {
    MFEM_ABORT("BilinearFormIntegrator::AssembleDiagonalPA (...)\n"
@@ -45,6 +102,28 @@ void BilinearFormIntegrator::AddMultPA(const Vector &, Vector &) const
                "   is not implemented for this class.");
 }
 
+void BilinearFormIntegrator::AddMultElementsPA(const Vector &, Vector &,
+                                               const Array<int> &) const
+{
+   mfem_error ("BilinearFormIntegrator::AddMultElementsPA (...)\n"
+               "   is not implemented for this class.");
+}
+
+void BilinearFormIntegrator::AddArrayMultPA(const int nv, const Vector &x,
+                                            Vector &y) const
+{
+   const int size = x.Size() / nv;
+   Vector xv, yv;
+   for (int v = 0; v < nv; v++)
+   {
+      xv.NewMemoryAndSize(Memory<double>(x.GetMemory(), v*size, size), size,
+                          false);
+      yv.NewMemoryAndSize(Memory<double>(y.GetMemory(), v*size, size), size,
+                          false);
+      AddMultPA(xv, yv);
+   }
+}
+
 void BilinearFormIntegrator::AddMultTransposePA(const Vector &, Vector &) const
 {
    mfem_error ("BilinearFormIntegrator::MultAssembledTranspose (...)\n"
@@ -27,6 +27,23 @@ protected:
    BilinearFormIntegrator(const IntegrationRule *ir = NULL)
       : NonlinearFormIntegrator(ir) { }
 
+   /** @brief Helper for UpdatePA(): evaluate the Jacobians @a J (with the
+       layout of GeometricFactors::J) and the coefficient @a Q at the points of
+       @a ir in the elements @a elems. */
+   /** If @a Q is NULL or constant, @a coeff is set to a single value. */
+   static void GetPAElementData(const FiniteElementSpace &fes,
+                                const IntegrationRule &ir, Coefficient *Q,
+                                const Array<int> &elems,
+                                Vector &J, Vector &coeff);
+
+   /** @brief Helper for UpdatePA(): copy the partial assembly data of @a size
+       entries per element from @a old_data for the elements with
+       @a old_elem[e] >= 0, and from the consecutive entries of @a new_data for
+       the other elements, to @a pa_data. */
+   static void MergePAData(const Array<int> &old_elem, const int size,
+                           const Vector &old_data, const Vector &new_data,
+                           Vector &pa_data);
+
 public:
    // TODO: add support for other assembly levels (in addition to PA) and their
    // actions.
@@ -50,6 +67,15 @@ public:
    virtual void AssemblePA(const FiniteElementSpace &trial_fes,
                            const FiniteElementSpace &test_fes);
 
+   /// Method updating the partial assembly after a refinement of the mesh.
+   /** The elements with @a old_elem[e] >= 0 did not change in the refinement
+       and may keep the data of the element @a old_elem[e] of the previous
+       AssemblePA() or UpdatePA() call on the same integrator; the data of the
+       other elements is recomputed. The default implementation calls
+       AssemblePA(). */
+   virtual void UpdatePA(const FiniteElementSpace &fes,
+                         const Array<int> &old_elem);
+
    /// Assemble diagonal and add it to Vector @a diag.
    virtual void AssembleDiagonalPA(Vector &diag);
 
@@ -62,6 +88,25 @@ public:
        called. */
    virtual void AddMultPA(const Vector &x, Vector &y) const;
 
+   /// Method for partially assembled action on a subset of the elements.
+   /** Same as AddMultPA(), but only the elements listed in @a elems are
+       processed; the entries of @a y of the other elements are not changed.
+       The E-vectors @a x and @a y are still for all elements.
+
+       This method is available only if SupportsElementsPA() returns true. */
+   virtual void AddMultElementsPA(const Vector &x, Vector &y,
+                                  const Array<int> &elems) const;
+
+   /// Returns true if the integrator implements AddMultElementsPA().
+   virtual bool SupportsElementsPA() const { return false; }
+
+   /// Method for partially assembled action on several vectors.
+   /** Same as AddMultPA(), applied to the @a nv E-vectors stored consecutively
+       in @a x and @a y. Integrators can override it to read their partial
+       assembly data once for all vectors. The default implementation calls
+       AddMultPA() for each vector. */
+   virtual void AddArrayMultPA(const int nv, const Vector &x, Vector &y) const;
+
    /// Method for partially assembled transposed action.
    /** Perform the transpose action of integrator on the input @a x and add the
        result to the output @a y. Both @a x and @a y are E-vectors, i.e. they
@@ -1830,9 +1875,16 @@ public:
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
+   virtual void UpdatePA(const FiniteElementSpace &fes,
+                         const Array<int> &old_elem);
+
    virtual void AssembleDiagonalPA(Vector &diag);
 
    virtual void AddMultPA(const Vector&, Vector&) const;
+   virtual void AddMultElementsPA(const Vector &x, Vector &y,
+                                  const Array<int> &elems) const;
+   virtual bool SupportsElementsPA() const;
+   virtual void AddArrayMultPA(const int nv, const Vector &x, Vector &y) const;
 
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe);
@@ -1903,9 +1955,16 @@ public:
 
    virtual void AssemblePA(const FiniteElementSpace &fes);
 
+   virtual void UpdatePA(const FiniteElementSpace &fes,
+                         const Array<int> &old_elem);
+
    virtual void AssembleDiagonalPA(Vector &diag);
 
    virtual void AddMultPA(const Vector&, Vector&) const;
+   virtual void AddMultElementsPA(const Vector &x, Vector &y,
+                                  const Array<int> &elems) const;
+   virtual bool SupportsElementsPA() const;
+   virtual void AddArrayMultPA(const int nv, const Vector &x, Vector &y) const;
 
    static const IntegrationRule &GetRule(const FiniteElement &trial_fe,
                                          const FiniteElement &test_fe,
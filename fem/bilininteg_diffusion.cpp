@@ -261,6 +261,42 @@ void DiffusionIntegrator::AssemblePA(const FiniteElementSpace &fes)
    SetupPA(fes);
 }
 
+void DiffusionIntegrator::UpdatePA(const FiniteElementSpace &fes,
+                                   const Array<int> &old_elem)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int NE = mesh->GetNE();
+   if (NE == 0 || DeviceCanUseCeed() || !pa_data.Size())
+   {
+      SetupPA(fes);
+      return;
+   }
+   const FiniteElement &el = *fes.GetFE(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el);
+   const int dims = el.GetDim();
+   const int size = (dims * (dims + 1)) / 2 * ir->GetNPoints();
+   if (pa_data.Size() != size*ne) { SetupPA(fes); return; }
+
+   // compute the data of the new elements only
+   Array<int> elems;
+   for (int e = 0; e < NE; e++)
+   {
+      if (old_elem[e] < 0) { elems.Append(e); }
+   }
+   Vector J, coeff, new_data(size*elems.Size());
+   GetPAElementData(fes, *ir, Q, elems, J, coeff);
+   PADiffusionSetup(dim, dofs1D, quad1D, elems.Size(), ir->GetWeights(), J,
+                    coeff, new_data);
+
+   Vector old_data;
+   old_data.Swap(pa_data);
+   pa_data.SetSize(size*NE, Device::GetMemoryType());
+   MergePAData(old_elem, size, old_data, new_data, pa_data);
+   fespace = &fes;
+   ne = NE;
+   geom = NULL;
+}
+
 
 template<int T_D1D = 0, int T_Q1D = 0>
 static void PADiffusionDiagonal2D(const int NE,
@@ -795,6 +831,7 @@ static void PADiffusionApply2D(const int NE,
                                const Vector &d_,
                                const Vector &x_,
                                Vector &y_,
+                               const Array<int> *elems,
                                const int d1d = 0,
                                const int q1d = 0)
 {
@@ -809,8 +846,11 @@ static void PADiffusionApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL(iel, NS,
    {
+      const int e = E ? E[iel] : iel;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -915,6 +955,7 @@ static void SmemPADiffusionApply2D(const int NE,
                                    const Vector &d_,
                                    const Vector &x_,
                                    Vector &y_,
+                                   const Array<int> *elems,
                                    const int d1d = 0,
                                    const int q1d = 0)
 {
@@ -930,8 +971,11 @@ static void SmemPADiffusionApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D, 3, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL_2D(iel, NS, Q1D, Q1D, NBZ,
    {
+      const int e = E ? E[iel] : iel;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1073,6 +1117,7 @@ static void PADiffusionApply3D(const int NE,
                                const Vector &d_,
                                const Vector &x_,
                                Vector &y_,
+                               const Array<int> *elems,
                                int d1d = 0, int q1d = 0)
 {
    const int D1D = T_D1D ? T_D1D : d1d;
@@ -1086,8 +1131,11 @@ static void PADiffusionApply3D(const int NE,
    auto D = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL(iel, NS,
    {
+      const int e = E ? E[iel] : iel;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -1262,6 +1310,7 @@ static void SmemPADiffusionApply3D(const int NE,
                                    const Vector &d_,
                                    const Vector &x_,
                                    Vector &y_,
+                                   const Array<int> *elems,
                                    const int d1d = 0,
                                    const int q1d = 0)
 {
@@ -1276,8 +1325,11 @@ static void SmemPADiffusionApply3D(const int NE,
    auto d = Reshape(d_.Read(), Q1D*Q1D*Q1D, 6, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL_3D(iel, NS, Q1D, Q1D, Q1D,
    {
+      const int e = E ? E[iel] : iel;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1503,10 +1555,11 @@ static void PADiffusionApply(const int dim,
                              const Array<double> &Gt,
                              const Vector &D,
                              const Vector &X,
-                             Vector &Y)
+                             Vector &Y,
+                             const Array<int> *E = NULL)
 {
 #ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   if (DeviceCanUseOcca() && E == NULL)
    {
       if (dim == 2)
       {
@@ -1525,36 +1578,400 @@ static void PADiffusionApply(const int dim,
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,B,G,Bt,Gt,D,X,Y);
-         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x22: return SmemPADiffusionApply2D<2,2,16>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x33: return SmemPADiffusionApply2D<3,3,16>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x44: return SmemPADiffusionApply2D<4,4,8>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x55: return SmemPADiffusionApply2D<5,5,8>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x66: return SmemPADiffusionApply2D<6,6,4>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x77: return SmemPADiffusionApply2D<7,7,4>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x88: return SmemPADiffusionApply2D<8,8,2>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x99: return SmemPADiffusionApply2D<9,9,2>(NE,B,G,Bt,Gt,D,X,Y,E);
+         default:   return PADiffusionApply2D(NE,B,G,Bt,Gt,D,X,Y,E,D1D,Q1D);
       }
    }
    else if (dim == 3)
    {
       switch ((D1D << 4 ) | Q1D)
       {
-         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,B,G,Bt,Gt,D,X,Y);
-         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,B,G,Bt,Gt,D,X,Y);
-         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,D1D,Q1D);
+         case 0x23: return SmemPADiffusionApply3D<2,3>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x34: return SmemPADiffusionApply3D<3,4>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x45: return SmemPADiffusionApply3D<4,5>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x46: return SmemPADiffusionApply3D<4,6>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x56: return SmemPADiffusionApply3D<5,6>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x58: return SmemPADiffusionApply3D<5,8>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x67: return SmemPADiffusionApply3D<6,7>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x78: return SmemPADiffusionApply3D<7,8>(NE,B,G,Bt,Gt,D,X,Y,E);
+         case 0x89: return SmemPADiffusionApply3D<8,9>(NE,B,G,Bt,Gt,D,X,Y,E);
+         default:   return PADiffusionApply3D(NE,B,G,Bt,Gt,D,X,Y,E,D1D,Q1D);
       }
    }
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Diffusion Apply 2D kernel for NV E-vectors stored consecutively in x_ and
+// y_. The vectors are processed in blocks of NB: the basis and the quadrature
+// data of an element are read once per block instead of once per vector. The
+// contractions follow SmemPADiffusionApply2D.
+template<int T_D1D, int T_Q1D>
+static void PADiffusionApplyVectors2D(const int NE,
+                                      const int NV,
+                                      const Array<double> &b_,
+                                      const Array<double> &g_,
+                                      const Vector &d_,
+                                      const Vector &x_,
+                                      Vector &y_)
+{
+   auto b = Reshape(b_.Read(), T_Q1D, T_D1D);
+   auto g = Reshape(g_.Read(), T_Q1D, T_D1D);
+   auto d = Reshape(d_.Read(), T_Q1D*T_Q1D, 3, NE);
+   auto x = Reshape(x_.Read(), T_D1D, T_D1D, NE, NV);
+   auto y = Reshape(y_.ReadWrite(), T_D1D, T_D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int D1D = T_D1D;
+      constexpr int Q1D = T_Q1D;
+      constexpr int NB = 4;
+      double B[Q1D][D1D], G[Q1D][D1D], Bt[D1D][Q1D], Gt[D1D][Q1D];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int dd = 0; dd < D1D; ++dd)
+         {
+            B[q][dd] = Bt[dd][q] = b(q,dd);
+            G[q][dd] = Gt[dd][q] = g(q,dd);
+         }
+      }
+      for (int v0 = 0; v0 < NV; v0 += NB)
+      {
+         const int nb = (NV - v0 < NB) ? NV - v0 : NB;
+         double QQ[NB][2][Q1D][Q1D];
+         for (int v = 0; v < nb; ++v)
+         {
+            double DQ0[D1D][Q1D], DQ1[D1D][Q1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  double u = 0.0;
+                  double w = 0.0;
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     const double coords = x(dx,dy,e,v0+v);
+                     u += B[qx][dx] * coords;
+                     w += G[qx][dx] * coords;
+                  }
+                  DQ0[dy][qx] = u;
+                  DQ1[dy][qx] = w;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  double u = 0.0;
+                  double w = 0.0;
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     u += DQ1[dy][qx] * B[qy][dy];
+                     w += DQ0[dy][qx] * G[qy][dy];
+                  }
+                  QQ[v][0][qy][qx] = u;
+                  QQ[v][1][qy][qx] = w;
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const int q = qx + qy * Q1D;
+               const double O11 = d(q,0,e);
+               const double O12 = d(q,1,e);
+               const double O22 = d(q,2,e);
+               for (int v = 0; v < nb; ++v)
+               {
+                  const double gX = QQ[v][0][qy][qx];
+                  const double gY = QQ[v][1][qy][qx];
+                  QQ[v][0][qy][qx] = (O11 * gX) + (O12 * gY);
+                  QQ[v][1][qy][qx] = (O12 * gX) + (O22 * gY);
+               }
+            }
+         }
+         for (int v = 0; v < nb; ++v)
+         {
+            double QD0[Q1D][D1D], QD1[Q1D][D1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  double w = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     u += Gt[dx][qx] * QQ[v][0][qy][qx];
+                     w += Bt[dx][qx] * QQ[v][1][qy][qx];
+                  }
+                  QD0[qy][dx] = u;
+                  QD1[qy][dx] = w;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  double w = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     u += QD0[qy][dx] * Bt[dy][qy];
+                     w += QD1[qy][dx] * Gt[dy][qy];
+                  }
+                  y(dx,dy,e,v0+v) += (u + w);
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Diffusion Apply 3D kernel for NV E-vectors, see
+// PADiffusionApplyVectors2D.
+template<int T_D1D, int T_Q1D>
+static void PADiffusionApplyVectors3D(const int NE,
+                                      const int NV,
+                                      const Array<double> &b_,
+                                      const Array<double> &g_,
+                                      const Vector &d_,
+                                      const Vector &x_,
+                                      Vector &y_)
+{
+   auto b = Reshape(b_.Read(), T_Q1D, T_D1D);
+   auto g = Reshape(g_.Read(), T_Q1D, T_D1D);
+   auto d = Reshape(d_.Read(), T_Q1D*T_Q1D*T_Q1D, 6, NE);
+   auto x = Reshape(x_.Read(), T_D1D, T_D1D, T_D1D, NE, NV);
+   auto y = Reshape(y_.ReadWrite(), T_D1D, T_D1D, T_D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int D1D = T_D1D;
+      constexpr int Q1D = T_Q1D;
+      constexpr int NB = 4;
+      double B[Q1D][D1D], G[Q1D][D1D], Bt[D1D][Q1D], Gt[D1D][Q1D];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int dd = 0; dd < D1D; ++dd)
+         {
+            B[q][dd] = Bt[dd][q] = b(q,dd);
+            G[q][dd] = Gt[dd][q] = g(q,dd);
+         }
+      }
+      for (int v0 = 0; v0 < NV; v0 += NB)
+      {
+         const int nb = (NV - v0 < NB) ? NV - v0 : NB;
+         double QQQ[NB][3][Q1D][Q1D][Q1D];
+         for (int v = 0; v < nb; ++v)
+         {
+            double DDQ0[D1D][D1D][Q1D], DDQ1[D1D][D1D][Q1D];
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     double u = 0.0;
+                     double w = 0.0;
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        const double coords = x(dx,dy,dz,e,v0+v);
+                        u += coords * B[qx][dx];
+                        w += coords * G[qx][dx];
+                     }
+                     DDQ0[dz][dy][qx] = u;
+                     DDQ1[dz][dy][qx] = w;
+                  }
+               }
+            }
+            double DQQ0[D1D][Q1D][Q1D], DQQ1[D1D][Q1D][Q1D],
+                   DQQ2[D1D][Q1D][Q1D];
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     double u = 0.0;
+                     double w = 0.0;
+                     double z = 0.0;
+                     for (int dy = 0; dy < D1D; ++dy)
+                     {
+                        u += DDQ1[dz][dy][qx] * B[qy][dy];
+                        w += DDQ0[dz][dy][qx] * G[qy][dy];
+                        z += DDQ0[dz][dy][qx] * B[qy][dy];
+                     }
+                     DQQ0[dz][qy][qx] = u;
+                     DQQ1[dz][qy][qx] = w;
+                     DQQ2[dz][qy][qx] = z;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     double u = 0.0;
+                     double w = 0.0;
+                     double z = 0.0;
+                     for (int dz = 0; dz < D1D; ++dz)
+                     {
+                        u += DQQ0[dz][qy][qx] * B[qz][dz];
+                        w += DQQ1[dz][qy][qx] * B[qz][dz];
+                        z += DQQ2[dz][qy][qx] * G[qz][dz];
+                     }
+                     QQQ[v][0][qz][qy][qx] = u;
+                     QQQ[v][1][qz][qy][qx] = w;
+                     QQQ[v][2][qz][qy][qx] = z;
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const int q = qx + ((qy*Q1D) + (qz*Q1D*Q1D));
+                  const double O11 = d(q,0,e);
+                  const double O12 = d(q,1,e);
+                  const double O13 = d(q,2,e);
+                  const double O22 = d(q,3,e);
+                  const double O23 = d(q,4,e);
+                  const double O33 = d(q,5,e);
+                  for (int v = 0; v < nb; ++v)
+                  {
+                     const double gX = QQQ[v][0][qz][qy][qx];
+                     const double gY = QQQ[v][1][qz][qy][qx];
+                     const double gZ = QQQ[v][2][qz][qy][qx];
+                     QQQ[v][0][qz][qy][qx] = (O11*gX) + (O12*gY) + (O13*gZ);
+                     QQQ[v][1][qz][qy][qx] = (O12*gX) + (O22*gY) + (O23*gZ);
+                     QQQ[v][2][qz][qy][qx] = (O13*gX) + (O23*gY) + (O33*gZ);
+                  }
+               }
+            }
+         }
+         for (int v = 0; v < nb; ++v)
+         {
+            double QQD0[Q1D][Q1D][D1D], QQD1[Q1D][Q1D][D1D],
+                   QQD2[Q1D][Q1D][D1D];
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     double w = 0.0;
+                     double z = 0.0;
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        u += QQQ[v][0][qz][qy][qx] * Gt[dx][qx];
+                        w += QQQ[v][1][qz][qy][qx] * Bt[dx][qx];
+                        z += QQQ[v][2][qz][qy][qx] * Bt[dx][qx];
+                     }
+                     QQD0[qz][qy][dx] = u;
+                     QQD1[qz][qy][dx] = w;
+                     QQD2[qz][qy][dx] = z;
+                  }
+               }
+            }
+            double QDD0[Q1D][D1D][D1D], QDD1[Q1D][D1D][D1D],
+                   QDD2[Q1D][D1D][D1D];
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     double w = 0.0;
+                     double z = 0.0;
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        u += QQD0[qz][qy][dx] * Bt[dy][qy];
+                        w += QQD1[qz][qy][dx] * Gt[dy][qy];
+                        z += QQD2[qz][qy][dx] * Bt[dy][qy];
+                     }
+                     QDD0[qz][dy][dx] = u;
+                     QDD1[qz][dy][dx] = w;
+                     QDD2[qz][dy][dx] = z;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     double w = 0.0;
+                     double z = 0.0;
+                     for (int qz = 0; qz < Q1D; ++qz)
+                     {
+                        u += QDD0[qz][dy][dx] * Bt[dz][qz];
+                        w += QDD1[qz][dy][dx] * Bt[dz][qz];
+                        z += QDD2[qz][dy][dx] * Gt[dz][qz];
+                     }
+                     y(dx,dy,dz,e,v0+v) += (u + w + z);
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Returns false if there is no kernel for the given sizes.
+static bool PADiffusionApplyVectors(const int dim,
+                                    const int D1D,
+                                    const int Q1D,
+                                    const int NE,
+                                    const int NV,
+                                    const Array<double> &B,
+                                    const Array<double> &G,
+                                    const Vector &D,
+                                    const Vector &X,
+                                    Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x22: PADiffusionApplyVectors2D<2,2>(NE,NV,B,G,D,X,Y); return true;
+         case 0x33: PADiffusionApplyVectors2D<3,3>(NE,NV,B,G,D,X,Y); return true;
+         case 0x44: PADiffusionApplyVectors2D<4,4>(NE,NV,B,G,D,X,Y); return true;
+         case 0x55: PADiffusionApplyVectors2D<5,5>(NE,NV,B,G,D,X,Y); return true;
+         case 0x66: PADiffusionApplyVectors2D<6,6>(NE,NV,B,G,D,X,Y); return true;
+         case 0x77: PADiffusionApplyVectors2D<7,7>(NE,NV,B,G,D,X,Y); return true;
+         case 0x88: PADiffusionApplyVectors2D<8,8>(NE,NV,B,G,D,X,Y); return true;
+         case 0x99: PADiffusionApplyVectors2D<9,9>(NE,NV,B,G,D,X,Y); return true;
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4 ) | Q1D)
+      {
+         case 0x23: PADiffusionApplyVectors3D<2,3>(NE,NV,B,G,D,X,Y); return true;
+         case 0x34: PADiffusionApplyVectors3D<3,4>(NE,NV,B,G,D,X,Y); return true;
+         case 0x45: PADiffusionApplyVectors3D<4,5>(NE,NV,B,G,D,X,Y); return true;
+         case 0x46: PADiffusionApplyVectors3D<4,6>(NE,NV,B,G,D,X,Y); return true;
+         case 0x56: PADiffusionApplyVectors3D<5,6>(NE,NV,B,G,D,X,Y); return true;
+         case 0x67: PADiffusionApplyVectors3D<6,7>(NE,NV,B,G,D,X,Y); return true;
+      }
+   }
+   return false;
+}
+
 // PA Diffusion Apply kernel
 void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
@@ -1594,4 +2011,28 @@ void DiffusionIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+void DiffusionIntegrator::AddMultElementsPA(const Vector &x, Vector &y,
+                                            const Array<int> &elems) const
+{
+   PADiffusionApply(dim, dofs1D, quad1D, ne,
+                    maps->B, maps->G, maps->Bt, maps->Gt,
+                    pa_data, x, y, &elems);
+}
+
+void DiffusionIntegrator::AddArrayMultPA(const int nv, const Vector &x,
+                                         Vector &y) const
+{
+   if (DeviceCanUseCeed() ||
+       !PADiffusionApplyVectors(dim, dofs1D, quad1D, ne, nv, maps->B, maps->G,
+                                pa_data, x, y))
+   {
+      BilinearFormIntegrator::AddArrayMultPA(nv, x, y);
+   }
+}
+
+bool DiffusionIntegrator::SupportsElementsPA() const
+{
+   return !DeviceCanUseCeed();
+}
+
 } // namespace mfem
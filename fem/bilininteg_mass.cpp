@@ -23,6 +23,61 @@ namespace mfem
 
 // PA Mass Assemble kernel
 
+static void PAMassSetup(const int dim,
+                        const int NQ,
+                        const int NE,
+                        const Array<double> &w,
+                        const Vector &j,
+                        const Vector &coeff,
+                        Vector &op)
+{
+   if (dim==2)
+   {
+      const bool const_c = coeff.Size() == 1;
+      auto W = w.Read();
+      auto J = Reshape(j.Read(), NQ,2,2,NE);
+      auto C =
+         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
+      auto v = Reshape(op.Write(), NQ, NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e);
+            const double J12 = J(q,1,0,e);
+            const double J21 = J(q,0,1,e);
+            const double J22 = J(q,1,1,e);
+            const double detJ = (J11*J22)-(J21*J12);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            v(q,e) =  W[q] * coeff * detJ;
+         }
+      });
+   }
+   if (dim==3)
+   {
+      const bool const_c = coeff.Size() == 1;
+      auto W = w.Read();
+      auto J = Reshape(j.Read(), NQ,3,3,NE);
+      auto C =
+         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
+      auto v = Reshape(op.Write(), NQ,NE);
+      MFEM_FORALL(e, NE,
+      {
+         for (int q = 0; q < NQ; ++q)
+         {
+            const double J11 = J(q,0,0,e), J12 = J(q,0,1,e), J13 = J(q,0,2,e);
+            const double J21 = J(q,1,0,e), J22 = J(q,1,1,e), J23 = J(q,1,2,e);
+            const double J31 = J(q,2,0,e), J32 = J(q,2,1,e), J33 = J(q,2,2,e);
+            const double detJ = J11 * (J22 * J33 - J32 * J23) -
+            /* */               J21 * (J12 * J33 - J32 * J13) +
+            /* */               J31 * (J12 * J23 - J22 * J13);
+            const double coeff = const_c ? C(0,0) : C(q,e);
+            v(q,e) = W[q] * coeff * detJ;
+         }
+      });
+   }
+}
+
 void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
 {
    // Assuming the same element type
@@ -76,55 +131,42 @@ void MassIntegrator::SetupPA(const FiniteElementSpace &fes, const bool force)
       }
    }
    if (dim==1) { MFEM_ABORT("Not supported yet... stay tuned!"); }
-   if (dim==2)
+   PAMassSetup(dim, nq, ne, ir->GetWeights(), geom->J, coeff, pa_data);
+}
+
+void MassIntegrator::UpdatePA(const FiniteElementSpace &fes,
+                              const Array<int> &old_elem)
+{
+   Mesh *mesh = fes.GetMesh();
+   const int NE = mesh->GetNE();
+   if (NE == 0 || DeviceCanUseCeed() || !pa_data.Size() ||
+       pa_data.Size() != nq*ne)
    {
-      const int NE = ne;
-      const int NQ = nq;
-      const bool const_c = coeff.Size() == 1;
-      auto w = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,2,2,NE);
-      auto C =
-         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
-      auto v = Reshape(pa_data.Write(), NQ, NE);
-      MFEM_FORALL(e, NE,
-      {
-         for (int q = 0; q < NQ; ++q)
-         {
-            const double J11 = J(q,0,0,e);
-            const double J12 = J(q,1,0,e);
-            const double J21 = J(q,0,1,e);
-            const double J22 = J(q,1,1,e);
-            const double detJ = (J11*J22)-(J21*J12);
-            const double coeff = const_c ? C(0,0) : C(q,e);
-            v(q,e) =  w[q] * coeff * detJ;
-         }
-      });
+      SetupPA(fes);
+      return;
    }
-   if (dim==3)
+   const FiniteElement &el = *fes.GetFE(0);
+   ElementTransformation *T = mesh->GetElementTransformation(0);
+   const IntegrationRule *ir = IntRule ? IntRule : &GetRule(el, el, *T);
+   if (ir->GetNPoints() != nq) { SetupPA(fes); return; }
+
+   // compute the data of the new elements only
+   Array<int> elems;
+   for (int e = 0; e < NE; e++)
    {
-      const int NE = ne;
-      const int NQ = nq;
-      const bool const_c = coeff.Size() == 1;
-      auto W = ir->GetWeights().Read();
-      auto J = Reshape(geom->J.Read(), NQ,3,3,NE);
-      auto C =
-         const_c ? Reshape(coeff.Read(), 1,1) : Reshape(coeff.Read(), NQ,NE);
-      auto v = Reshape(pa_data.Write(), NQ,NE);
-      MFEM_FORALL(e, NE,
-      {
-         for (int q = 0; q < NQ; ++q)
-         {
-            const double J11 = J(q,0,0,e), J12 = J(q,0,1,e), J13 = J(q,0,2,e);
-            const double J21 = J(q,1,0,e), J22 = J(q,1,1,e), J23 = J(q,1,2,e);
-            const double J31 = J(q,2,0,e), J32 = J(q,2,1,e), J33 = J(q,2,2,e);
-            const double detJ = J11 * (J22 * J33 - J32 * J23) -
-            /* */               J21 * (J12 * J33 - J32 * J13) +
-            /* */               J31 * (J12 * J23 - J22 * J13);
-            const double coeff = const_c ? C(0,0) : C(q,e);
-            v(q,e) = W[q] * coeff * detJ;
-         }
-      });
+      if (old_elem[e] < 0) { elems.Append(e); }
    }
+   Vector J, coeff, new_data(nq*elems.Size());
+   GetPAElementData(fes, *ir, Q, elems, J, coeff);
+   PAMassSetup(dim, nq, elems.Size(), ir->GetWeights(), J, coeff, new_data);
+
+   Vector old_data;
+   old_data.Swap(pa_data);
+   pa_data.SetSize(nq*NE, Device::GetMemoryType());
+   MergePAData(old_elem, nq, old_data, new_data, pa_data);
+   fespace = &fes;
+   ne = NE;
+   geom = NULL;
 }
 
 void MassIntegrator::AssemblePA(const FiniteElementSpace &fes)
@@ -544,6 +586,7 @@ static void PAMassApply2D(const int NE,
                           const Vector &d_,
                           const Vector &x_,
                           Vector &y_,
+                          const Array<int> *elems,
                           const int d1d = 0,
                           const int q1d = 0)
 {
@@ -556,8 +599,11 @@ static void PAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL(iel, NS,
    {
+      const int e = E ? E[iel] : iel;
       const int D1D = T_D1D ? T_D1D : d1d; // nvcc workaround
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       // the following variables are evaluated at compile time
@@ -636,6 +682,7 @@ static void SmemPAMassApply2D(const int NE,
                               const Vector &d_,
                               const Vector &x_,
                               Vector &y_,
+                              const Array<int> *elems,
                               const int d1d = 0,
                               const int q1d = 0)
 {
@@ -650,8 +697,11 @@ static void SmemPAMassApply2D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, NE);
-   MFEM_FORALL_2D(e, NE, Q1D, Q1D, NBZ,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL_2D(iel, NS, Q1D, Q1D, NBZ,
    {
+      const int e = E ? E[iel] : iel;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -758,6 +808,7 @@ static void PAMassApply3D(const int NE,
                           const Vector &d_,
                           const Vector &x_,
                           Vector &y_,
+                          const Array<int> *elems,
                           const int d1d = 0,
                           const int q1d = 0)
 {
@@ -770,8 +821,11 @@ static void PAMassApply3D(const int NE,
    auto D = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto X = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto Y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL(e, NE,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL(iel, NS,
    {
+      const int e = E ? E[iel] : iel;
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
       constexpr int max_D1D = T_D1D ? T_D1D : MAX_D1D;
@@ -899,6 +953,7 @@ static void SmemPAMassApply3D(const int NE,
                               const Vector &d_,
                               const Vector &x_,
                               Vector &y_,
+                              const Array<int> *elems,
                               const int d1d = 0,
                               const int q1d = 0)
 {
@@ -912,8 +967,11 @@ static void SmemPAMassApply3D(const int NE,
    auto d = Reshape(d_.Read(), Q1D, Q1D, Q1D, NE);
    auto x = Reshape(x_.Read(), D1D, D1D, D1D, NE);
    auto y = Reshape(y_.ReadWrite(), D1D, D1D, D1D, NE);
-   MFEM_FORALL_3D(e, NE, Q1D, Q1D, Q1D,
+   const int NS = elems ? elems->Size() : NE;
+   const int *E = elems ? elems->Read() : NULL;
+   MFEM_FORALL_3D(iel, NS, Q1D, Q1D, Q1D,
    {
+      const int e = E ? E[iel] : iel;
       const int tidz = MFEM_THREAD_ID(z);
       const int D1D = T_D1D ? T_D1D : d1d;
       const int Q1D = T_Q1D ? T_Q1D : q1d;
@@ -1069,10 +1127,11 @@ static void PAMassApply(const int dim,
                         const Array<double> &Bt,
                         const Vector &D,
                         const Vector &X,
-                        Vector &Y)
+                        Vector &Y,
+                        const Array<int> *E = NULL)
 {
 #ifdef MFEM_USE_OCCA
-   if (DeviceCanUseOcca())
+   if (DeviceCanUseOcca() && E == NULL)
    {
       if (dim == 2)
       {
@@ -1089,34 +1148,325 @@ static void PAMassApply(const int dim,
    {
       switch ((D1D << 4) | Q1D)
       {
-         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y);
-         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y);
-         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y);
-         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y);
-         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y);
-         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y);
-         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y);
-         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x22: return SmemPAMassApply2D<2,2,16>(NE,B,Bt,D,X,Y,E);
+         case 0x33: return SmemPAMassApply2D<3,3,16>(NE,B,Bt,D,X,Y,E);
+         case 0x44: return SmemPAMassApply2D<4,4,8>(NE,B,Bt,D,X,Y,E);
+         case 0x55: return SmemPAMassApply2D<5,5,8>(NE,B,Bt,D,X,Y,E);
+         case 0x66: return SmemPAMassApply2D<6,6,4>(NE,B,Bt,D,X,Y,E);
+         case 0x77: return SmemPAMassApply2D<7,7,4>(NE,B,Bt,D,X,Y,E);
+         case 0x88: return SmemPAMassApply2D<8,8,2>(NE,B,Bt,D,X,Y,E);
+         case 0x99: return SmemPAMassApply2D<9,9,2>(NE,B,Bt,D,X,Y,E);
+         default:   return PAMassApply2D(NE,B,Bt,D,X,Y,E,D1D,Q1D);
       }
    }
    else if (dim == 3)
    {
       switch ((D1D << 4) | Q1D)
       {
-         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y);
-         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y);
-         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y);
-         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y);
-         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y);
-         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y);
-         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y);
-         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,D1D,Q1D);
+         case 0x23: return SmemPAMassApply3D<2,3>(NE,B,Bt,D,X,Y,E);
+         case 0x34: return SmemPAMassApply3D<3,4>(NE,B,Bt,D,X,Y,E);
+         case 0x45: return SmemPAMassApply3D<4,5>(NE,B,Bt,D,X,Y,E);
+         case 0x56: return SmemPAMassApply3D<5,6>(NE,B,Bt,D,X,Y,E);
+         case 0x67: return SmemPAMassApply3D<6,7>(NE,B,Bt,D,X,Y,E);
+         case 0x78: return SmemPAMassApply3D<7,8>(NE,B,Bt,D,X,Y,E);
+         case 0x89: return SmemPAMassApply3D<8,9>(NE,B,Bt,D,X,Y,E);
+         default:   return PAMassApply3D(NE,B,Bt,D,X,Y,E,D1D,Q1D);
       }
    }
    MFEM_ABORT("Unknown kernel.");
 }
 
+// PA Mass Apply 2D kernel for NV E-vectors stored consecutively in x_ and y_.
+// The vectors are processed in blocks of NB: the basis and the quadrature data
+// of an element are read once per block instead of once per vector. The
+// contractions follow SmemPAMassApply2D.
+template<int T_D1D, int T_Q1D>
+static void PAMassApplyVectors2D(const int NE,
+                                 const int NV,
+                                 const Array<double> &b_,
+                                 const Vector &d_,
+                                 const Vector &x_,
+                                 Vector &y_)
+{
+   auto b = Reshape(b_.Read(), T_Q1D, T_D1D);
+   auto d = Reshape(d_.Read(), T_Q1D, T_Q1D, NE);
+   auto x = Reshape(x_.Read(), T_D1D, T_D1D, NE, NV);
+   auto y = Reshape(y_.ReadWrite(), T_D1D, T_D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int D1D = T_D1D;
+      constexpr int Q1D = T_Q1D;
+      constexpr int NB = 4;
+      double B[Q1D][D1D], Bt[D1D][Q1D];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int dd = 0; dd < D1D; ++dd)
+         {
+            B[q][dd] = Bt[dd][q] = b(q,dd);
+         }
+      }
+      for (int v0 = 0; v0 < NV; v0 += NB)
+      {
+         const int nb = (NV - v0 < NB) ? NV - v0 : NB;
+         double QQ[NB][Q1D][Q1D];
+         for (int v = 0; v < nb; ++v)
+         {
+            double DQ[D1D][Q1D];
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  double u = 0.0;
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     u += x(dx,dy,e,v0+v) * B[qx][dx];
+                  }
+                  DQ[dy][qx] = u;
+               }
+            }
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  double u = 0.0;
+                  for (int dy = 0; dy < D1D; ++dy)
+                  {
+                     u += DQ[dy][qx] * B[qy][dy];
+                  }
+                  QQ[v][qy][qx] = u;
+               }
+            }
+         }
+         for (int qy = 0; qy < Q1D; ++qy)
+         {
+            for (int qx = 0; qx < Q1D; ++qx)
+            {
+               const double D = d(qx,qy,e);
+               for (int v = 0; v < nb; ++v)
+               {
+                  QQ[v][qy][qx] *= D;
+               }
+            }
+         }
+         for (int v = 0; v < nb; ++v)
+         {
+            double QD[Q1D][D1D];
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     u += QQ[v][qy][qx] * Bt[dx][qx];
+                  }
+                  QD[qy][dx] = u;
+               }
+            }
+            for (int dy = 0; dy < D1D; ++dy)
+            {
+               for (int dx = 0; dx < D1D; ++dx)
+               {
+                  double u = 0.0;
+                  for (int qy = 0; qy < Q1D; ++qy)
+                  {
+                     u += QD[qy][dx] * Bt[dy][qy];
+                  }
+                  y(dx,dy,e,v0+v) += u;
+               }
+            }
+         }
+      }
+   });
+}
+
+// PA Mass Apply 3D kernel for NV E-vectors, see PAMassApplyVectors2D.
+template<int T_D1D, int T_Q1D>
+static void PAMassApplyVectors3D(const int NE,
+                                 const int NV,
+                                 const Array<double> &b_,
+                                 const Vector &d_,
+                                 const Vector &x_,
+                                 Vector &y_)
+{
+   auto b = Reshape(b_.Read(), T_Q1D, T_D1D);
+   auto d = Reshape(d_.Read(), T_Q1D, T_Q1D, T_Q1D, NE);
+   auto x = Reshape(x_.Read(), T_D1D, T_D1D, T_D1D, NE, NV);
+   auto y = Reshape(y_.ReadWrite(), T_D1D, T_D1D, T_D1D, NE, NV);
+   MFEM_FORALL(e, NE,
+   {
+      constexpr int D1D = T_D1D;
+      constexpr int Q1D = T_Q1D;
+      constexpr int NB = 4;
+      double B[Q1D][D1D], Bt[D1D][Q1D];
+      for (int q = 0; q < Q1D; ++q)
+      {
+         for (int dd = 0; dd < D1D; ++dd)
+         {
+            B[q][dd] = Bt[dd][q] = b(q,dd);
+         }
+      }
+      for (int v0 = 0; v0 < NV; v0 += NB)
+      {
+         const int nb = (NV - v0 < NB) ? NV - v0 : NB;
+         double QQQ[NB][Q1D][Q1D][Q1D];
+         for (int v = 0; v < nb; ++v)
+         {
+            double DDQ[D1D][D1D][Q1D];
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     double u = 0.0;
+                     for (int dx = 0; dx < D1D; ++dx)
+                     {
+                        u += x(dx,dy,dz,e,v0+v) * B[qx][dx];
+                     }
+                     DDQ[dz][dy][qx] = u;
+                  }
+               }
+            }
+            double DQQ[D1D][Q1D][Q1D];
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     double u = 0.0;
+                     for (int dy = 0; dy < D1D; ++dy)
+                     {
+                        u += DDQ[dz][dy][qx] * B[qy][dy];
+                     }
+                     DQQ[dz][qy][qx] = u;
+                  }
+               }
+            }
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int qx = 0; qx < Q1D; ++qx)
+                  {
+                     double u = 0.0;
+                     for (int dz = 0; dz < D1D; ++dz)
+                     {
+                        u += DQQ[dz][qy][qx] * B[qz][dz];
+                     }
+                     QQQ[v][qz][qy][qx] = u;
+                  }
+               }
+            }
+         }
+         for (int qz = 0; qz < Q1D; ++qz)
+         {
+            for (int qy = 0; qy < Q1D; ++qy)
+            {
+               for (int qx = 0; qx < Q1D; ++qx)
+               {
+                  const double D = d(qx,qy,qz,e);
+                  for (int v = 0; v < nb; ++v)
+                  {
+                     QQQ[v][qz][qy][qx] *= D;
+                  }
+               }
+            }
+         }
+         for (int v = 0; v < nb; ++v)
+         {
+            double QQD[Q1D][Q1D][D1D];
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int qy = 0; qy < Q1D; ++qy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     for (int qx = 0; qx < Q1D; ++qx)
+                     {
+                        u += QQQ[v][qz][qy][qx] * Bt[dx][qx];
+                     }
+                     QQD[qz][qy][dx] = u;
+                  }
+               }
+            }
+            double QDD[Q1D][D1D][D1D];
+            for (int qz = 0; qz < Q1D; ++qz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     for (int qy = 0; qy < Q1D; ++qy)
+                     {
+                        u += QQD[qz][qy][dx] * Bt[dy][qy];
+                     }
+                     QDD[qz][dy][dx] = u;
+                  }
+               }
+            }
+            for (int dz = 0; dz < D1D; ++dz)
+            {
+               for (int dy = 0; dy < D1D; ++dy)
+               {
+                  for (int dx = 0; dx < D1D; ++dx)
+                  {
+                     double u = 0.0;
+                     for (int qz = 0; qz < Q1D; ++qz)
+                     {
+                        u += QDD[qz][dy][dx] * Bt[dz][qz];
+                     }
+                     y(dx,dy,dz,e,v0+v) += u;
+                  }
+               }
+            }
+         }
+      }
+   });
+}
+
+// Returns false if there is no kernel for the given sizes.
+static bool PAMassApplyVectors(const int dim,
+                               const int D1D,
+                               const int Q1D,
+                               const int NE,
+                               const int NV,
+                               const Array<double> &B,
+                               const Vector &D,
+                               const Vector &X,
+                               Vector &Y)
+{
+   if (dim == 2)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x22: PAMassApplyVectors2D<2,2>(NE,NV,B,D,X,Y); return true;
+         case 0x33: PAMassApplyVectors2D<3,3>(NE,NV,B,D,X,Y); return true;
+         case 0x44: PAMassApplyVectors2D<4,4>(NE,NV,B,D,X,Y); return true;
+         case 0x55: PAMassApplyVectors2D<5,5>(NE,NV,B,D,X,Y); return true;
+         case 0x66: PAMassApplyVectors2D<6,6>(NE,NV,B,D,X,Y); return true;
+         case 0x77: PAMassApplyVectors2D<7,7>(NE,NV,B,D,X,Y); return true;
+         case 0x88: PAMassApplyVectors2D<8,8>(NE,NV,B,D,X,Y); return true;
+         case 0x99: PAMassApplyVectors2D<9,9>(NE,NV,B,D,X,Y); return true;
+      }
+   }
+   else if (dim == 3)
+   {
+      switch ((D1D << 4) | Q1D)
+      {
+         case 0x23: PAMassApplyVectors3D<2,3>(NE,NV,B,D,X,Y); return true;
+         case 0x34: PAMassApplyVectors3D<3,4>(NE,NV,B,D,X,Y); return true;
+         case 0x45: PAMassApplyVectors3D<4,5>(NE,NV,B,D,X,Y); return true;
+         case 0x56: PAMassApplyVectors3D<5,6>(NE,NV,B,D,X,Y); return true;
+         case 0x67: PAMassApplyVectors3D<6,7>(NE,NV,B,D,X,Y); return true;
+      }
+   }
+   return false;
+}
+
 void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
 {
 #ifdef MFEM_USE_CEED
@@ -1153,4 +1503,27 @@ void MassIntegrator::AddMultPA(const Vector &x, Vector &y) const
    }
 }
 
+void MassIntegrator::AddMultElementsPA(const Vector &x, Vector &y,
+                                       const Array<int> &elems) const
+{
+   PAMassApply(dim, dofs1D, quad1D, ne, maps->B, maps->Bt, pa_data, x, y,
+               &elems);
+}
+
+void MassIntegrator::AddArrayMultPA(const int nv, const Vector &x,
+                                    Vector &y) const
+{
+   if (DeviceCanUseCeed() ||
+       !PAMassApplyVectors(dim, dofs1D, quad1D, ne, nv, maps->B, pa_data,
+                           x, y))
+   {
+      BilinearFormIntegrator::AddArrayMultPA(nv, x, y);
+   }
+}
+
+bool MassIntegrator::SupportsElementsPA() const
+{
+   return !DeviceCanUseCeed();
+}
+
 } // namespace mfem
@@ -16,12 +16,18 @@
 #include "../mesh/nurbs.hpp"
 #include "bilininteg.hpp"
 #include <cmath>
+#include <mutex>
 
 namespace mfem
 {
 
 using namespace std;
 
+// Serializes the lookup and creation of the DofToQuad maps cached in the
+// elements, so that GetDofToQuad() can be called from multiple threads. The
+// maps are requested once per integrator setup, so a lock is cheap enough.
+static std::mutex dof2quad_mutex;
+
 FiniteElement::FiniteElement(int D, Geometry::Type G, int Do, int O, int F)
    : Nodes(Do)
 {
@@ -463,6 +469,7 @@ const DofToQuad &ScalarFiniteElement::GetDofToQuad(const IntegrationRule &ir,
 {
    MFEM_VERIFY(mode == DofToQuad::FULL, "invalid mode requested");
 
+   std::lock_guard<std::mutex> lock(dof2quad_mutex);
    for (int i = 0; i < dof2quad_array.Size(); i++)
    {
       const DofToQuad &d2q = *dof2quad_array[i];
@@ -512,6 +519,7 @@ const DofToQuad &ScalarFiniteElement::GetTensorDofToQuad(
 {
    MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
 
+   std::lock_guard<std::mutex> lock(dof2quad_mutex);
    for (int i = 0; i < dof2quad_array.Size(); i++)
    {
       const DofToQuad &d2q = *dof2quad_array[i];
@@ -11537,10 +11545,12 @@ const DofToQuad &VectorTensorFiniteElement::GetTensorDofToQuad(
 {
    MFEM_VERIFY(mode == DofToQuad::TENSOR, "invalid mode requested");
 
-   for (int i = 0; i < closed ? dof2quad_array.Size() : dof2quad_array_open.Size();
-        i++)
+   std::lock_guard<std::mutex> lock(dof2quad_mutex);
+   const Array<DofToQuad*> &d2q_array =
+      closed ? dof2quad_array : dof2quad_array_open;
+   for (int i = 0; i < d2q_array.Size(); i++)
    {
-      const DofToQuad &d2q = closed ? *dof2quad_array[i] : *dof2quad_array_open[i];
+      const DofToQuad &d2q = *d2q_array[i];
       if (d2q.IntRule == &ir && d2q.mode == mode) { return d2q; }
    }
 
@@ -534,7 +534,9 @@ public:
 
    /** Return a DofToQuad structure corresponding to the given IntegrationRule
        using the given DofToQuad::Mode. */
-   /** See the documentation for DofToQuad for more details. */
+   /** See the documentation for DofToQuad for more details. The returned
+       objects are cached in the element; this method can be called from
+       multiple threads. */
    virtual const DofToQuad &GetDofToQuad(const IntegrationRule &ir,
                                          DofToQuad::Mode mode) const;
 
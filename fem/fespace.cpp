@@ -61,6 +61,7 @@ FiniteElementSpace::FiniteElementSpace()
      ndofs(0), nvdofs(0), nedofs(0), nfdofs(0), nbdofs(0),
      fdofs(NULL), bdofs(NULL),
      elem_dof(NULL), bdrElem_dof(NULL),
+     dof_renum_type(DofRenumbering::NONE),
      NURBSext(NULL), own_ext(false),
      cP(NULL), cR(NULL), cP_is_set(false),
      Th(Operator::ANY_TYPE),
@@ -90,6 +91,10 @@ FiniteElementSpace::FiniteElementSpace(const FiniteElementSpace &orig,
       }
    }
    Constructor(mesh, NURBSext, fec, orig.vdim, orig.ordering);
+   if (orig.dof_renum_type != DofRenumbering::NONE)
+   {
+      RenumberDofs(orig.dof_renum_type);
+   }
 }
 
 int FiniteElementSpace::GetOrder(int i) const
@@ -242,6 +247,17 @@ void FiniteElementSpace::RebuildElementToDofTable()
 
 void FiniteElementSpace::ReorderElementToDofTable()
 {
+   bool renumber = !NURBSext && mesh->Conforming();
+#ifdef MFEM_USE_MPI
+   renumber = renumber && dynamic_cast<ParFiniteElementSpace*>(this) == NULL;
+#endif
+   if (renumber)
+   {
+      RenumberDofs(DofRenumbering::ELEMENT);
+      return;
+   }
+
+   // Spaces not supported by RenumberDofs(): permute only the table.
    Array<int> dof_marker(ndofs);
 
    dof_marker = -1;
@@ -260,6 +276,155 @@ void FiniteElementSpace::ReorderElementToDofTable()
    }
 }
 
+void FiniteElementSpace::RenumberDofs(DofRenumbering type)
+{
+   MFEM_VERIFY(!NURBSext, "DOF renumbering is not supported for NURBS spaces");
+   MFEM_VERIFY(mesh->Conforming(),
+               "DOF renumbering is not supported on nonconforming meshes");
+
+   dof_renum_type = type;
+   dof_renum.DeleteAll();
+   RebuildElementToDofTable();
+   if (type != DofRenumbering::NONE) { BuildDofRenumbering(); }
+
+   // drop the data depending on the numbering
+   Th.Clear();
+   L2E_nat.Clear();
+   L2E_lex.Clear();
+   dof_elem_array.DeleteAll();
+   dof_ldof_array.DeleteAll();
+}
+
+// Reverse Cuthill-McKee ordering of the graph 'adj' (which may include the
+// diagonal): on return, 'order' lists the vertices in the new order.
+static void ReverseCuthillMcKee(const Table &adj, Array<int> &order)
+{
+   const int n = adj.Size();
+   Array<int> level(n), queue(n), nbr;
+   level = -1;
+   order.SetSize(0);
+   order.Reserve(n);
+   for (int root = 0; root < n; root++)
+   {
+      if (level[root] >= 0) { continue; }
+
+      // Find a pseudo-peripheral vertex of the component of 'root': repeat
+      // breadth-first searches from a vertex of minimum degree in the last
+      // level, while the eccentricity grows.
+      int start = root, ecc = -1;
+      for (int it = 0; it < 8; it++)
+      {
+         int head = 0, tail = 0;
+         queue[tail++] = start;
+         level[start] = 0;
+         while (head < tail)
+         {
+            const int v = queue[head++];
+            const int *row = adj.GetRow(v);
+            for (int j = 0; j < adj.RowSize(v); j++)
+            {
+               if (level[row[j]] < 0)
+               {
+                  level[row[j]] = level[v] + 1;
+                  queue[tail++] = row[j];
+               }
+            }
+         }
+         const int last = level[queue[tail-1]];
+         int next = queue[tail-1];
+         for (int k = tail-1; k >= 0 && level[queue[k]] == last; k--)
+         {
+            if (adj.RowSize(queue[k]) < adj.RowSize(next)) { next = queue[k]; }
+         }
+         for (int k = 0; k < tail; k++) { level[queue[k]] = -1; }
+         if (last <= ecc) { break; }
+         ecc = last;
+         start = next;
+      }
+
+      // Cuthill-McKee: breadth-first search visiting the neighbors in the
+      // order of increasing degree
+      int head = order.Size();
+      order.Append(start);
+      level[start] = 0;
+      while (head < order.Size())
+      {
+         const int v = order[head++];
+         const int *row = adj.GetRow(v);
+         nbr.SetSize(0);
+         for (int j = 0; j < adj.RowSize(v); j++)
+         {
+            if (level[row[j]] < 0)
+            {
+               level[row[j]] = 0;
+               nbr.Append(row[j]);
+            }
+         }
+         nbr.Sort([&](int a, int b)
+         {
+            return adj.RowSize(a) < adj.RowSize(b) ||
+                   (adj.RowSize(a) == adj.RowSize(b) && a < b);
+         });
+         order.Append(nbr);
+      }
+   }
+
+   // reverse the order
+   for (int i = 0, j = n-1; i < j; i++, j--)
+   {
+      Swap(order[i], order[j]);
+   }
+}
+
+void FiniteElementSpace::BuildDofRenumbering()
+{
+   // element-to-dof table without the signs of the dofs
+   Table el_dof(*elem_dof);
+   int *J = el_dof.GetJ();
+   for (int k = 0; k < el_dof.Size_of_connections(); k++)
+   {
+      if (J[k] < 0) { J[k] = -1-J[k]; }
+   }
+
+   Array<int> order;
+   switch (dof_renum_type)
+   {
+      case DofRenumbering::ELEMENT:
+      {
+         Array<int> mark(ndofs);
+         mark = 0;
+         order.Reserve(ndofs);
+         for (int k = 0; k < el_dof.Size_of_connections(); k++)
+         {
+            if (!mark[J[k]]) { mark[J[k]] = 1; order.Append(J[k]); }
+         }
+         // dofs not used by any element keep their relative order
+         for (int i = 0; i < ndofs; i++)
+         {
+            if (!mark[i]) { order.Append(i); }
+         }
+         break;
+      }
+      case DofRenumbering::RCM:
+      {
+         Table dof_el, dof_dof;
+         Transpose(el_dof, dof_el, ndofs);
+         Mult(dof_el, el_dof, dof_dof);
+         ReverseCuthillMcKee(dof_dof, order);
+         break;
+      }
+      default:
+         return;
+   }
+
+   dof_renum.SetSize(ndofs);
+   for (int i = 0; i < ndofs; i++)
+   {
+      dof_renum[order[i]] = i;
+   }
+   RebuildElementToDofTable();
+}
+
 void FiniteElementSpace::BuildDofToArrays()
 {
    if (dof_elem_array.Size()) { return; }
@@ -1349,6 +1514,7 @@ void FiniteElementSpace::Constructor(Mesh *mesh, NURBSExtension *NURBSext,
    this->ordering = (Ordering::Type) ordering;
 
    elem_dof = NULL;
+   dof_renum_type = DofRenumbering::NONE;
    sequence = mesh->GetSequence();
    Th.SetType(Operator::ANY_TYPE);
 
@@ -1419,6 +1585,7 @@ void FiniteElementSpace::Construct()
 
    elem_dof = NULL;
    bdrElem_dof = NULL;
+   dof_renum.DeleteAll();
 
    ndofs = 0;
    nedofs = nfdofs = nbdofs = 0;
@@ -1576,6 +1743,7 @@ void FiniteElementSpace::GetElementDofs(int i, Array<int> &dofs) const
             dofs[ne+j] = k + j;
          }
       }
+      ApplyDofRenumbering(dofs);
    }
 }
 
@@ -1676,6 +1844,7 @@ void FiniteElementSpace::GetBdrElementDofs(int i, Array<int> &dofs) const
             }
          }
       }
+      ApplyDofRenumbering(dofs);
    }
 }
 
@@ -1736,6 +1905,7 @@ void FiniteElementSpace::GetFaceDofs(int i, Array<int> &dofs) const
          dofs[ne+k] = j;
       }
    }
+   ApplyDofRenumbering(dofs);
 }
 
 void FiniteElementSpace::GetEdgeDofs(int i, Array<int> &dofs) const
@@ -1765,6 +1935,7 @@ void FiniteElementSpace::GetEdgeDofs(int i, Array<int> &dofs) const
    {
       dofs[nv+j] = k;
    }
+   ApplyDofRenumbering(dofs);
 }
 
 void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
@@ -1777,6 +1948,7 @@ void FiniteElementSpace::GetVertexDofs(int i, Array<int> &dofs) const
    {
       dofs[j] = i*nv+j;
    }
+   ApplyDofRenumbering(dofs);
 }
 
 void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
@@ -1790,6 +1962,7 @@ void FiniteElementSpace::GetElementInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k + j;
    }
+   ApplyDofRenumbering(dofs);
 }
 
 void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
@@ -1802,6 +1975,7 @@ void FiniteElementSpace::GetEdgeInteriorDofs (int i, Array<int> &dofs) const
    {
       dofs[j] = k;
    }
+   ApplyDofRenumbering(dofs);
 }
 
 void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
@@ -1817,6 +1991,7 @@ void FiniteElementSpace::GetFaceInteriorDofs (int i, Array<int> &dofs) const
          dofs[j] = k;
       }
    }
+   ApplyDofRenumbering(dofs);
 }
 
 const FiniteElement *FiniteElementSpace::GetBE (int i) const
@@ -2013,6 +2188,12 @@ void FiniteElementSpace::Update(bool want_transform)
    Destroy(); // calls Th.Clear()
    Construct();
    BuildElementToDofTable();
+   if (dof_renum_type != DofRenumbering::NONE)
+   {
+      MFEM_VERIFY(mesh->Conforming(), "DOF renumbering is not supported on "
+                  "nonconforming meshes");
+      BuildDofRenumbering();
+   }
 
    if (want_transform)
    {
@@ -2066,6 +2247,7 @@ void FiniteElementSpace::Save(std::ostream &out) const
    if (!NURBSext)
    {
       // TODO: if this is a variable-order FE space, use fes_format = 100.
+      if (dof_renum_type != DofRenumbering::NONE) { fes_format = 100; }
    }
    else
    {
@@ -2095,6 +2277,10 @@ void FiniteElementSpace::Save(std::ostream &out) const
       if (!NURBSext)
       {
          // TODO: this is a variable-order FE space --> write 'element_orders'.
+         if (dof_renum_type != DofRenumbering::NONE)
+         {
+            out << "dof_renumbering\n" << int(dof_renum_type) << '\n';
+         }
       }
       else if (NURBSext != mesh->NURBSext)
       {
@@ -2131,6 +2317,7 @@ FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input)
    string buff;
    int fes_format = 0, ord;
    FiniteElementCollection *r_fec;
+   DofRenumbering renum_type = DofRenumbering::NONE;
 
    Destroy();
 
@@ -2211,6 +2398,15 @@ FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input)
                         "with a NURBS FE collection");
             MFEM_ABORT("element_orders: not implemented yet!");
          }
+         else if (buff == "dof_renumbering")
+         {
+            int type;
+            input >> type;
+            MFEM_VERIFY(type > int(DofRenumbering::NONE) &&
+                        type <= int(DofRenumbering::RCM),
+                        "dof_renumbering: invalid type " << type);
+            renum_type = DofRenumbering(type);
+         }
          else if (buff == "End: MFEM FiniteElementSpace v1.0")
          {
             break;
@@ -2223,6 +2419,7 @@ FiniteElementCollection *FiniteElementSpace::Load(Mesh *m, std::istream &input)
    }
 
    Constructor(m, NURBSext, r_fec, vdim, ord);
+   if (renum_type != DofRenumbering::NONE) { RenumberDofs(renum_type); }
 
    return r_fec;
 }
@@ -2861,6 +3058,36 @@ void ElementRestriction::Mult(const Vector& x, Vector& y) const
    });
 }
 
+void ElementRestriction::MultDofs(const Vector& x, Vector& y,
+                                  const Array<int> &dofs) const
+{
+   const int nd = dof;
+   const int vd = vdim;
+   const bool t = byvdim;
+   auto d_offsets = offsets.Read();
+   auto d_indices = indices.Read();
+   auto d_dofs = dofs.Read();
+   auto d_x = Reshape(x.Read(), t?vd:ndofs, t?ndofs:vd);
+   auto d_y = Reshape(y.ReadWrite(), nd, vd, ne);
+
+   MFEM_FORALL(k, dofs.Size(),
+   {
+      const int i = d_dofs[k];
+      const int offset = d_offsets[i];
+      const int nextOffset = d_offsets[i+1];
+      for (int c = 0; c < vd; ++c)
+      {
+         const double dofValue = d_x(t?c:i,t?i:c);
+         for (int j = offset; j < nextOffset; ++j)
+         {
+            const bool positive = (d_indices[j] >= 0);
+            const int idx_j = positive ? d_indices[j] : -1 - d_indices[j];
+            d_y(idx_j % nd, c, idx_j / nd) = positive ? dofValue : -dofValue;
+         }
+      }
+   });
+}
+
 void ElementRestriction::MultTranspose(const Vector& x, Vector& y) const
 {
    // Assumes all elements have the same number of dofs
@@ -72,6 +72,22 @@ enum class ElementDofOrdering
    LEXICOGRAPHIC
 };
 
+/// Constants describing the possible numberings of the scalar DOFs of a
+/// FiniteElementSpace, see FiniteElementSpace::RenumberDofs().
+enum class DofRenumbering
+{
+   /// Numbering by entity: vertex, edge, face and element interior DOFs.
+   NONE,
+   /// DOFs numbered by their first appearance in a traversal of the elements.
+   /** Combined with an element ordering that follows a space-filling curve,
+       e.g. Mesh::GetHilbertElementOrdering(), this keeps the DOFs of each
+       element close together. */
+   ELEMENT,
+   /// Reverse Cuthill-McKee ordering of the graph of DOFs sharing an element.
+   /** This ordering reduces the bandwidth of the assembled matrices. */
+   RCM
+};
+
 
 // Forward declarations
 class NURBSExtension;
@@ -112,6 +128,11 @@ protected:
 
    Array<int> dof_elem_array, dof_ldof_array;
 
+   /** Renumbering of the scalar DOFs, see RenumberDofs(): if not empty, DOF i
+       of the entity-based numbering has the index dof_renum[i]. */
+   Array<int> dof_renum;
+   DofRenumbering dof_renum_type;
+
    NURBSExtension *NURBSext;
    int own_ext;
 
@@ -140,6 +161,21 @@ protected:
 
    void BuildElementToDofTable() const;
 
+   /** Compute #dof_renum from the entity-based #elem_dof table according to
+       #dof_renum_type, then rebuild #elem_dof. */
+   void BuildDofRenumbering();
+
+   /// Map the (signed) entity-based DOFs in @a dofs to their new indices.
+   inline void ApplyDofRenumbering(Array<int> &dofs) const
+   {
+      if (dof_renum.Size() == 0) { return; }
+      for (int i = 0; i < dofs.Size(); i++)
+      {
+         const int d = dofs[i];
+         dofs[i] = (d >= 0) ? dof_renum[d] : -1-dof_renum[-1-d];
+      }
+   }
+
    /// Helper to remove encoded sign from a DOF
    static inline int DecodeDof(int dof, double& sign)
    { return (dof >= 0) ? (sign = 1, dof) : (sign = -1, (-1 - dof)); }
@@ -479,11 +515,29 @@ public:
        ordered in the Mesh; 2) for each element, assign new indices to all of
        its current DOFs that are still unassigned; the new indices we assign are
        simply the sequence `0,1,2,...`; if there are any signed DOFs their sign
-       is preserved. */
+       is preserved. For the spaces supported by RenumberDofs() this is
+       RenumberDofs(DofRenumbering::ELEMENT), so the new numbering is used by
+       all methods returning DOFs and is kept after Update(). For parallel,
+       nonconforming and NURBS spaces, only the element-to-DOF table is
+       permuted. */
    void ReorderElementToDofTable();
 
    void BuildDofToArrays();
 
+   /** @brief Renumber the scalar DOFs of the space to improve the memory
+       locality of the gather/scatter in the element restriction and the
+       bandwidth of the assembled matrices, see DofRenumbering. */
+   /** The numbering is used by all methods returning DOFs, and hence by the
+       element-to-DOF table, the ElementRestriction and the assembly of
+       SparseMatrix objects. It is recomputed after Update() and recorded by
+       Save(), so that Load() restores it. The method should be called before
+       creating GridFunctions, forms or other objects on the space. Only
+       conforming, non-NURBS, serial spaces are supported. */
+   virtual void RenumberDofs(DofRenumbering type);
+
+   /// Return the current DOF renumbering, see RenumberDofs().
+   DofRenumbering GetDofRenumbering() const { return dof_renum_type; }
+
    const Table &GetElementToDofTable() const { return *elem_dof; }
    const Table &GetBdrElementToDofTable() const { return *bdrElem_dof; }
 
@@ -903,6 +957,11 @@ public:
 
    /// Compute MultTranspose without applying signs based on DOF orientations.
    void MultTransposeUnsigned(const Vector &x, Vector &y) const;
+
+   /** @brief Same as Mult(), but only the entries of the E-vector @a y that
+       correspond to the (scalar) L-vector dofs in @a dofs are set. */
+   /** All vector components of the listed dofs are set. */
+   void MultDofs(const Vector &x, Vector &y, const Array<int> &dofs) const;
 };
 
 /// Operator that converts L2 FiniteElementSpace L-vectors to E-vectors.
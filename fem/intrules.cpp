@@ -856,6 +856,13 @@ IntegrationRules RefinedIntRules(1, Quadrature1D::GaussLegendre);
 IntegrationRules::IntegrationRules(int Ref, int _type):
    quad_type(_type)
 {
+   static_assert(Geometry::NumGeom == LookupGeoms,
+                 "invalid size of the lookup table");
+   for (int g = 0; g < LookupGeoms; g++)
+   {
+      for (int o = 0; o < LookupOrders; o++) { lookup[g][o] = NULL; }
+   }
+
    refined = Ref;
 
    if (refined < 0) { own_rules = 0; return; }
@@ -909,27 +916,35 @@ const IntegrationRule &IntegrationRules::Get(int GeomType, int Order)
       Order = 0;
    }
 
+   const bool use_lookup = (Order < LookupOrders);
+   if (use_lookup)
+   {
+      const IntegrationRule *ir =
+         lookup[GeomType][Order].load(std::memory_order_acquire);
+      if (ir) { return *ir; }
+   }
+
+   std::lock_guard<std::recursive_mutex> lock(gen_mutex);
    if (!HaveIntRule(*ir_array, Order))
    {
-#ifdef MFEM_USE_LEGACY_OPENMP
-      #pragma omp critical
-#endif
+      IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
+      int RealOrder = Order;
+      while (RealOrder+1 < ir_array->Size() &&
+      /*  */ (*ir_array)[RealOrder+1] == ir)
       {
-         if (!HaveIntRule(*ir_array, Order))
-         {
-            IntegrationRule *ir = GenerateIntegrationRule(GeomType, Order);
-            int RealOrder = Order;
-            while (RealOrder+1 < ir_array->Size() &&
-            /*  */ (*ir_array)[RealOrder+1] == ir)
-            {
-               RealOrder++;
-            }
-            ir->SetOrder(RealOrder);
-         }
+         RealOrder++;
       }
+      ir->SetOrder(RealOrder);
    }
 
-   return *(*ir_array)[Order];
+   const IntegrationRule *ir = (*ir_array)[Order];
+   // create the lazily built data before the rule is shared between threads
+   ir->GetWeights();
+   if (use_lookup)
+   {
+      lookup[GeomType][Order].store(ir, std::memory_order_release);
+   }
+   return *ir;
 }
 
 void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
@@ -950,6 +965,7 @@ void IntegrationRules::Set(int GeomType, int Order, IntegrationRule &IntRule)
          ir_array = NULL;
    }
 
+   std::lock_guard<std::recursive_mutex> lock(gen_mutex);
    if (HaveIntRule(*ir_array, Order))
    {
       MFEM_ABORT("Overwriting set rules is not supported!");
@@ -14,6 +14,8 @@
 
 #include "../config/config.hpp"
 #include "../general/array.hpp"
+#include <atomic>
+#include <mutex>
 
 namespace mfem
 {
@@ -93,7 +95,8 @@ private:
    friend class IntegrationRules;
    int Order;
    /** @brief The quadrature weights gathered as a contiguous array. Created
-       by request with the method GetWeights(). */
+       by request with the method GetWeights(), or by IntegrationRules::Get()
+       for the rules it returns. */
    mutable Array<double> weights;
 
    /// Sets the indices of each quadrature point on initialization.
@@ -252,7 +255,9 @@ public:
 
    /// Return the quadrature weights in a contiguous array.
    /** If a contiguous array is not required, the weights can be accessed with
-       a call like this: `IntPoint(i).weight`. */
+       a call like this: `IntPoint(i).weight`. The array is created on the
+       first call, which is not thread-safe, except for the rules returned by
+       IntegrationRules::Get() where it is created in advance. */
    const Array<double> &GetWeights() const;
 
    /// Destroys an IntegrationRule object
@@ -325,6 +330,20 @@ private:
    Array<IntegrationRule *> PrismIntRules;
    Array<IntegrationRule *> CubeIntRules;
 
+   /// Size of the lock-free lookup table of Get(), see lookup.
+   enum { LookupGeoms = 7, LookupOrders = 64 };
+
+   /** @brief The rules returned by Get() for orders below LookupOrders,
+       indexed by geometry type and order. */
+   /** A rule is stored here only after it is fully constructed, so that Get()
+       can return it without locking. The arrays above are accessed only while
+       holding gen_mutex. */
+   std::atomic<const IntegrationRule *> lookup[LookupGeoms][LookupOrders];
+
+   /** @brief Serializes the generation of rules in Get() and Set(); recursive
+       since some rules are built from other rules obtained with Get(). */
+   std::recursive_mutex gen_mutex;
+
    void AllocIntRule(Array<IntegrationRule *> &ir_array, int Order)
    {
       if (ir_array.Size() <= Order)
@@ -362,6 +381,9 @@ public:
                              int type = Quadrature1D::GaussLegendre);
 
    /// Returns an integration rule for given GeomType and Order.
+   /** This method is thread-safe: rules that were already generated are
+       returned without locking and new rules are generated by one thread at
+       a time. */
    const IntegrationRule &Get(int GeomType, int Order);
 
    void Set(int GeomType, int Order, IntegrationRule &IntRule);
@@ -19,6 +19,76 @@
 namespace mfem
 {
 
+ParPAOverlapOperator::ParPAOverlapOperator(
+   const ParFiniteElementSpace &pfes, const PABilinearFormExtension &pa,
+   const ConformingProlongationOperator &P_)
+   : Operator(P_.Width()), pa_ext(pa), P(P_), R(*pa.GetElementRestriction())
+{
+   MFEM_VERIFY(pa.SupportsElements(),
+               "the PA integrators do not support element subsets");
+   MFEM_VERIFY(pfes.GetVDim() == 1, "vector spaces are not supported");
+
+   // Mark the scalar dofs of the external vector dofs
+   const Array<int> &ext_ldofs = P.GetExternalLDofs();
+   Array<int> is_ext(pfes.GetNDofs());
+   is_ext = 0;
+   for (int i = 0; i < ext_ldofs.Size(); i++)
+   {
+      is_ext[pfes.VDofToDof(ext_ldofs[i])] = 1;
+   }
+   for (int i = 0; i < is_ext.Size(); i++)
+   {
+      if (is_ext[i]) { ext_dofs.Append(i); }
+   }
+
+   Array<int> dofs;
+   for (int e = 0; e < pfes.GetNE(); e++)
+   {
+      pfes.GetElementDofs(e, dofs);
+      bool bdr = false;
+      for (int j = 0; j < dofs.Size() && !bdr; j++)
+      {
+         const int d = dofs[j];
+         bdr = is_ext[(d >= 0) ? d : -1-d];
+      }
+      (bdr ? bdr_elems : int_elems).Append(e);
+   }
+
+   const MemoryType mt = Device::GetMemoryType();
+   xl.SetSize(P.Height(), mt);
+   yl.SetSize(P.Height(), mt);
+   xe.SetSize(R.Height(), mt);
+   ye.SetSize(R.Height(), mt);
+   ye.UseDevice(true); // ensure 'ye = 0.0' is done on device
+}
+
+void ParPAOverlapOperator::Mult(const Vector &x, Vector &y) const
+{
+   // Start the exchange of the external dofs. The E-vector entries of the
+   // interior elements only depend on owned dofs, so these elements can be
+   // applied while the messages are in flight.
+   P.MultBegin(x, xl);
+   R.Mult(xl, xe);
+   ye = 0.0;
+   pa_ext.AddMultElements(xe, ye, int_elems);
+
+   // Set the E-vector entries of the external dofs and apply the boundary
+   // elements
+   P.MultEnd(xl);
+   R.MultDofs(xl, xe, ext_dofs);
+   pa_ext.AddMultElements(xe, ye, bdr_elems);
+
+   R.MultTranspose(ye, yl);
+   P.MultTranspose(yl, y);
+}
+
+void ParPAOverlapOperator::MultTranspose(const Vector &x, Vector &y) const
+{
+   P.Mult(x, xl);
+   pa_ext.MultTranspose(xl, yl);
+   P.MultTranspose(yl, y);
+}
+
 void ParBilinearForm::pAllocMat()
 {
    int nbr_size = pfes->GetFaceNbrVSize();
@@ -287,13 +357,39 @@ const
    pfes->Dof_TrueDof_Matrix()->MultTranspose(a, Y, 1.0, y);
 }
 
+Operator *ParBilinearForm::NewPAOverlapOperator() const
+{
+   if (!pa_overlap || pfes->GetVDim() > 1) { return NULL; }
+   const PABilinearFormExtension *pa_ext =
+      dynamic_cast<const PABilinearFormExtension*>(ext);
+   if (!pa_ext || !pa_ext->SupportsElements()) { return NULL; }
+   const ConformingProlongationOperator *P =
+      dynamic_cast<const ConformingProlongationOperator*>(
+         pfes->GetProlongationMatrix());
+   if (!P) { return NULL; }
+   return new ParPAOverlapOperator(*pfes, *pa_ext, *P);
+}
+
 void ParBilinearForm::FormLinearSystem(
    const Array<int> &ess_tdof_list, Vector &x, Vector &b,
    OperatorHandle &A, Vector &X, Vector &B, int copy_interior)
 {
    if (ext)
    {
-      ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
+      Operator *oper = NewPAOverlapOperator();
+      if (!oper)
+      {
+         ext->FormLinearSystem(ess_tdof_list, x, b, A, X, B, copy_interior);
+         return;
+      }
+      const Operator *P = pfes->GetProlongationMatrix();
+      const Operator *R = pfes->GetRestrictionMatrix();
+      oper->InitTVectors(P, R, P, x, b, X, B);
+      if (!copy_interior) { X.SetSubVectorComplement(ess_tdof_list, 0.0); }
+      ConstrainedOperator *A_c = new ConstrainedOperator(oper, ess_tdof_list,
+                                                         true);
+      A_c->EliminateRHS(X, B);
+      A.Reset(A_c);
       return;
    }
 
@@ -342,6 +438,12 @@ void ParBilinearForm::FormSystemMatrix(const Array<int> &ess_tdof_list,
 {
    if (ext)
    {
+      Operator *oper = NewPAOverlapOperator();
+      if (oper)
+      {
+         A.Reset(new ConstrainedOperator(oper, ess_tdof_list, true));
+         return;
+      }
       ext->FormSystemMatrix(ess_tdof_list, A);
       return;
    }
@@ -24,6 +24,48 @@
 namespace mfem
 {
 
+/** @brief The true dof action, P^t A P, of a partially assembled
+    ParBilinearForm, that overlaps the exchange of the external dofs in the
+    prolongation P with the element kernels. */
+/** The elements are split into interior elements, whose dofs are all owned by
+    this processor, and boundary elements, which have external dofs. The
+    kernels of the interior elements are applied while the values of the
+    external dofs are in flight and the boundary elements are applied after
+    they have arrived. The result is the same as with the RAPOperator. */
+class ParPAOverlapOperator : public Operator
+{
+protected:
+   const PABilinearFormExtension &pa_ext;
+   const ConformingProlongationOperator &P;
+   const ElementRestriction &R;
+   Array<int> int_elems, bdr_elems;
+   Array<int> ext_dofs; ///< Scalar dofs with vector dofs owned by other ranks
+   mutable Vector xl, yl, xe, ye;
+
+public:
+   /** @brief Construct the operator for the partially assembled @a pa, given
+       the prolongation @a P of the space @a pfes. */
+   /** The E-vector restriction of @a pa must be set and the integrators must
+       support element subsets, see PABilinearFormExtension::SupportsElements().
+       The space @a pfes must be scalar (vdim = 1). */
+   ParPAOverlapOperator(const ParFiniteElementSpace &pfes,
+                        const PABilinearFormExtension &pa,
+                        const ConformingProlongationOperator &P);
+
+   /// Return the number of elements without external dofs.
+   int GetNumInteriorElements() const { return int_elems.Size(); }
+
+   /// Return the number of elements with external dofs.
+   int GetNumBoundaryElements() const { return bdr_elems.Size(); }
+
+   virtual MemoryClass GetMemoryClass() const
+   { return Device::GetMemoryClass(); }
+
+   virtual void Mult(const Vector &x, Vector &y) const;
+
+   virtual void MultTranspose(const Vector &x, Vector &y) const;
+};
+
 /// Class for parallel bilinear form
 class ParBilinearForm : public BilinearForm
 {
@@ -37,11 +79,18 @@ protected:
 
    bool keep_nbr_block;
 
+   bool pa_overlap; ///< Use ParPAOverlapOperator, see EnablePAOverlap()
+
    // Allocate mat - called when (mat == NULL && fbfi.Size() > 0)
    void pAllocMat();
 
    void AssembleSharedFaces(int skip_zeros = 1);
 
+   /** Return a new ParPAOverlapOperator for the partially assembled form, or
+       NULL if it is not enabled or if the assembly level or the space do not
+       support it. */
+   Operator *NewPAOverlapOperator() const;
+
 private:
    /// Copy construction is not supported; body is undefined.
    ParBilinearForm(const ParBilinearForm &);
@@ -55,7 +104,7 @@ public:
    ParBilinearForm(ParFiniteElementSpace *pf)
       : BilinearForm(pf), pfes(pf),
         p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
-   { keep_nbr_block = false; }
+   { keep_nbr_block = false; pa_overlap = false; }
 
    /** @brief Create a ParBilinearForm on the ParFiniteElementSpace @a *pf,
        using the same integrators as the ParBilinearForm @a *bf.
@@ -67,7 +116,7 @@ public:
    ParBilinearForm(ParFiniteElementSpace *pf, ParBilinearForm *bf)
       : BilinearForm(pf, bf), pfes(pf),
         p_mat(Operator::Hypre_ParCSR), p_mat_e(Operator::Hypre_ParCSR)
-   { keep_nbr_block = false; }
+   { keep_nbr_block = false; pa_overlap = false; }
 
    /** When set to true and the ParBilinearForm has interior face integrators,
        the local SparseMatrix will include the rows (in addition to the columns)
@@ -75,6 +124,15 @@ public:
        those rows. Must be called before the first Assemble call. */
    void KeepNbrBlock(bool knb = true) { keep_nbr_block = knb; }
 
+   /** @brief Use a ParPAOverlapOperator as the true dof operator of the
+       partially assembled form in FormLinearSystem() and FormSystemMatrix().
+       Disabled by default. */
+   /** The operator overlaps the exchange of the shared dofs with the element
+       kernels. It is used only if all integrators support element subsets and
+       the space is scalar; otherwise the default (prolongation based) operator
+       is used. */
+   void EnablePAOverlap(bool enable = true) { pa_overlap = enable; }
+
    /** @brief Set the operator type id for the parallel matrix/operator when
        using AssemblyLevel::FULL. */
    /** If using static condensation or hybridization, call this method *after*
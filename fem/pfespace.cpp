@@ -2991,6 +2991,35 @@ void ConformingProlongationOperator::Mult(const Vector &x, Vector &y) const
    gc.BcastEnd(ydata, out_layout);
 }
 
+void ConformingProlongationOperator::MultBegin(const Vector &x,
+                                               Vector &y) const
+{
+   MFEM_ASSERT(x.Size() == Width(), "");
+   MFEM_ASSERT(y.Size() == Height(), "");
+
+   const double *xdata = x.HostRead();
+   double *ydata = y.HostWrite();
+   const int m = external_ldofs.Size();
+
+   const int in_layout = 2; // 2 - input is ltdofs array
+   gc.BcastBegin(const_cast<double*>(xdata), in_layout);
+
+   int j = 0;
+   for (int i = 0; i < m; i++)
+   {
+      const int end = external_ldofs[i];
+      std::copy(xdata+j-i, xdata+end-i, ydata+j);
+      j = end+1;
+   }
+   std::copy(xdata+j-m, xdata+Width(), ydata+j);
+}
+
+void ConformingProlongationOperator::MultEnd(Vector &y) const
+{
+   const int out_layout = 0; // 0 - output is ldofs array
+   gc.BcastEnd(y.HostReadWrite(), out_layout);
+}
+
 void ConformingProlongationOperator::MultTranspose(
    const Vector &x, Vector &y) const
 {
@@ -3083,6 +3112,7 @@ DeviceConformingProlongationOperator::DeviceConformingProlongationOperator(
       if (recv_size > 0) { req_counter++; }
    }
    requests = new MPI_Request[req_counter];
+   bcast_requests = 0;
 }
 
 static void ExtractSubVector(const int N,
@@ -3164,6 +3194,44 @@ void DeviceConformingProlongationOperator::Mult(const Vector &x,
    BcastEndCopy(y); // copy from 'ext_buf'
 }
 
+void DeviceConformingProlongationOperator::MultBegin(const Vector &x,
+                                                     Vector &y) const
+{
+   const GroupTopology &gtopo = gc.GetGroupTopology();
+   BcastBeginCopy(x); // copy to 'shr_buf'
+   int req_counter = 0;
+   for (int nbr = 1; nbr < gtopo.GetNumNeighbors(); nbr++)
+   {
+      const int send_offset = shr_buf_offsets[nbr];
+      const int send_size = shr_buf_offsets[nbr+1] - send_offset;
+      if (send_size > 0)
+      {
+         auto send_buf = mpi_gpu_aware ? shr_buf.Read() : shr_buf.HostRead();
+         MPI_Isend(send_buf + send_offset, send_size, MPI_DOUBLE,
+                   gtopo.GetNeighborRank(nbr), 41822,
+                   gtopo.GetComm(), &requests[req_counter++]);
+      }
+      const int recv_offset = ext_buf_offsets[nbr];
+      const int recv_size = ext_buf_offsets[nbr+1] - recv_offset;
+      if (recv_size > 0)
+      {
+         auto recv_buf = mpi_gpu_aware ? ext_buf.Write() : ext_buf.HostWrite();
+         MPI_Irecv(recv_buf + recv_offset, recv_size, MPI_DOUBLE,
+                   gtopo.GetNeighborRank(nbr), 41822,
+                   gtopo.GetComm(), &requests[req_counter++]);
+      }
+   }
+   BcastLocalCopy(x, y);
+   bcast_requests = req_counter;
+}
+
+void DeviceConformingProlongationOperator::MultEnd(Vector &y) const
+{
+   MPI_Waitall(bcast_requests, requests, MPI_STATUSES_IGNORE);
+   bcast_requests = 0;
+   BcastEndCopy(y); // copy from 'ext_buf'
+}
+
 DeviceConformingProlongationOperator::~DeviceConformingProlongationOperator()
 {
    delete [] requests;
@@ -356,6 +356,13 @@ public:
        /rebalance matrices, unless want_transform is false. */
    virtual void Update(bool want_transform = true);
 
+   /// DOF renumbering is not supported for parallel spaces.
+   virtual void RenumberDofs(DofRenumbering type)
+   {
+      MFEM_VERIFY(type == DofRenumbering::NONE,
+                  "DOF renumbering is not supported in parallel");
+   }
+
    /// Free ParGridFunction transformation matrix (if any), to save memory.
    virtual void UpdatesFinished()
    {
@@ -382,8 +389,23 @@ protected:
 public:
    ConformingProlongationOperator(const ParFiniteElementSpace &pfes);
 
+   /// Return the sorted list of ldofs owned by other processors.
+   const Array<int> &GetExternalLDofs() const { return external_ldofs; }
+
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   /** @brief Start the action of the operator: set the ldofs of @a y owned by
+       this processor and start the exchange of the external ldofs. */
+   /** Until the matching call to MultEnd(), which must be made with the same
+       @a y, the external ldofs of @a y are not set and @a y must not be
+       modified. MultBegin() followed by MultEnd() gives the same result as
+       Mult(), which is kept as a single call. The split form is used only by
+       ParPAOverlapOperator, see ParBilinearForm::EnablePAOverlap(). */
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   /// Finish the action started with MultBegin(): set the external ldofs.
+   virtual void MultEnd(Vector &y) const;
+
    virtual void MultTranspose(const Vector &x, Vector &y) const;
 };
 
@@ -399,6 +421,7 @@ protected:
    Array<int> ltdof_ldof, unq_ltdof;
    Array<int> unq_shr_i, unq_shr_j;
    MPI_Request *requests;
+   mutable int bcast_requests; // number of requests posted by MultBegin()
    // Kernel: copy ltdofs from 'src' to 'shr_buf' - prepare for send.
    //         shr_buf[i] = src[shr_ltdof[i]]
    void BcastBeginCopy(const Vector &src) const;
@@ -430,6 +453,10 @@ public:
 
    virtual void Mult(const Vector &x, Vector &y) const;
 
+   virtual void MultBegin(const Vector &x, Vector &y) const;
+
+   virtual void MultEnd(Vector &y) const;
+
    virtual void MultTranspose(const Vector &x, Vector &y) const;
 };
 
@@ -466,6 +466,9 @@ public:
    /// Destroy all items, set size to zero.
    void DeleteAll() { Destroy(); blocks.DeleteAll(); size = 0; }
 
+   /// Destroy the items with index >= @a new_size and free the unused blocks.
+   void Truncate(int new_size);
+
    void Swap(BlockArray<T> &other);
 
    long MemoryUsage() const;
@@ -995,6 +998,24 @@ void BlockArray<T>::Swap(BlockArray<T> &other)
    std::swap(mask, other.mask);
 }
 
+template<typename T>
+void BlockArray<T>::Truncate(int new_size)
+{
+   MFEM_ASSERT(new_size >= 0 && new_size <= size,
+               "invalid size: " << new_size << ", size = " << size);
+   for (int i = new_size; i < size; i++)
+   {
+      At(i).~T();
+   }
+   const int new_blocks = (new_size + mask) >> shift;
+   for (int i = new_blocks; i < blocks.Size(); i++)
+   {
+      delete [] (char*) blocks[i];
+   }
+   blocks.SetSize(new_blocks);
+   size = new_size;
+}
+
 template<typename T>
 long BlockArray<T>::MemoryUsage() const
 {
@@ -14,6 +14,7 @@
 
 #include "../config/config.hpp"
 
+#include <cstddef>
 #include <iostream>
 #include <vector>
 
@@ -39,6 +40,21 @@ inline T read(std::istream& is)
    return value;
 }
 
+/// Write the @a n values of the array @a data in binary form.
+template<typename T>
+inline void write(std::ostream& os, const T *data, std::size_t n)
+{
+   os.write((const char*) data, n*sizeof(T));
+}
+
+/// Read @a n values into the array @a data; returns false on failure.
+template<typename T>
+inline bool read(std::istream& is, T *data, std::size_t n)
+{
+   is.read((char*) data, n*sizeof(T));
+   return is.good() && std::size_t(is.gcount()) == n*sizeof(T);
+}
+
 template <typename T>
 void AppendBytes(std::vector<char> &vec, const T &val)
 {
@@ -120,6 +120,14 @@ public:
    void Reparent(int id, int new_p1, int new_p2);
    void Reparent(int id, int new_p1, int new_p2, int new_p3, int new_p4 = -1);
 
+   /** @brief Remove the unused ids: renumber the items consecutively, keeping
+       their order, free the unused blocks and shrink the hash table. */
+   /** On return, @a id_map maps the old ids to the new ones (-1 for unused
+       ids). If @a parent_map is given, it is applied to the parent IDs of all
+       items and must preserve their order; it may point to @a id_map if the
+       parents are items of this table. */
+   void Compact(Array<int> &id_map, const Array<int> *parent_map = NULL);
+
    /// Return total size of allocated memory (tables plus items), in bytes.
    long MemoryUsage() const;
 
@@ -190,6 +198,12 @@ protected:
    inline int Hash(const Hashed4& item) const
    { return Hash(item.p1, item.p2, item.p3); }
 
+   inline static void MapParents(Hashed2 &item, const Array<int> &map)
+   { item.p1 = map[item.p1]; item.p2 = map[item.p2]; }
+
+   inline static void MapParents(Hashed4 &item, const Array<int> &map)
+   { item.p1 = map[item.p1]; item.p2 = map[item.p2]; item.p3 = map[item.p3]; }
+
    int SearchList(int id, int p1, int p2) const;
    int SearchList(int id, int p1, int p2, int p3) const;
 
@@ -514,6 +528,55 @@ void HashTable<T>::Reparent(int id,
    Insert(new_idx, id, item);
 }
 
+template<typename T>
+void HashTable<T>::Compact(Array<int> &id_map, const Array<int> *parent_map)
+{
+   const int num_ids = Base::Size();
+   id_map.SetSize(num_ids);
+   int new_size = 0;
+   for (int id = 0; id < num_ids; id++)
+   {
+      id_map[id] = IdExists(id) ? new_size++ : -1;
+   }
+
+   // move the items down to their new ids
+   for (int id = 0; id < num_ids; id++)
+   {
+      const int new_id = id_map[id];
+      if (new_id >= 0 && new_id != id) { Base::At(new_id) = Base::At(id); }
+   }
+   for (int id = new_size; id < num_ids; id++)
+   {
+      Base::At(id) = T(); // reset the leftover copies before destroying them
+   }
+   Base::Truncate(new_size);
+   unused.DeleteAll();
+
+   if (parent_map)
+   {
+      for (int id = 0; id < new_size; id++)
+      {
+         MapParents(Base::At(id), *parent_map);
+      }
+   }
+
+   // shrink the table to about one list per item and relink all items
+   int table_size = 16;
+   while (table_size < new_size) { table_size *= 2; }
+   if (table_size < mask+1)
+   {
+      delete [] table;
+      table = new int[table_size];
+      mask = table_size-1;
+   }
+   for (int i = 0; i <= mask; i++) { table[i] = -1; }
+   for (int id = 0; id < new_size; id++)
+   {
+      T &item = Base::At(id);
+      Insert(Hash(item), id, item);
+   }
+}
+
 template<typename T>
 long HashTable<T>::MemoryUsage() const
 {
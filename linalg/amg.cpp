@@ -0,0 +1,419 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of the serial smoothed aggregation AMG preconditioner
+
+#include "amg.hpp"
+
+#include <cmath>
+
+namespace mfem
+{
+
+SmoothedAggregationAMG::SmoothedAggregationAMG()
+   : vdim(1), order_bynodes(false), theta(0.08),
+     smoother_type(SmootherType::CHEBYSHEV), smoother_sweeps(1),
+     cheby_order(2), p_omega(4.0/3.0), max_levels(25), max_coarse_size(100)
+{ }
+
+SmoothedAggregationAMG::SmoothedAggregationAMG(const SparseMatrix &A_)
+   : SmoothedAggregationAMG()
+{
+   SetOperator(A_);
+}
+
+void SmoothedAggregationAMG::SetSystemsOptions(int dim, bool order_bynodes_)
+{
+   vdim = dim;
+   order_bynodes = order_bynodes_;
+}
+
+void SmoothedAggregationAMG::SetSmoother(SmootherType type, int sweeps,
+                                         int cheby_order_)
+{
+   smoother_type = type;
+   smoother_sweeps = sweeps;
+   cheby_order = cheby_order_;
+}
+
+void SmoothedAggregationAMG::Clear()
+{
+   for (int l = 1; l < A.Size(); l++) { delete A[l]; }
+   for (int l = 0; l < P.Size(); l++) { delete P[l]; }
+   for (int l = 0; l < dinv.Size(); l++) { delete dinv[l]; }
+   for (int l = 0; l < b_l.Size(); l++)
+   {
+      delete b_l[l];
+      delete x_l[l];
+      delete r_l[l];
+      delete d_l[l];
+      delete z_l[l];
+   }
+   A.SetSize(0);
+   P.SetSize(0);
+   dinv.SetSize(0);
+   lambda_max.SetSize(0);
+   b_l.SetSize(0);
+   x_l.SetSize(0);
+   r_l.SetSize(0);
+   d_l.SetSize(0);
+   z_l.SetSize(0);
+}
+
+SmoothedAggregationAMG::~SmoothedAggregationAMG()
+{
+   Clear();
+}
+
+void SmoothedAggregationAMG::SetOperator(const Operator &op)
+{
+   const SparseMatrix *A0 = dynamic_cast<const SparseMatrix *>(&op);
+   if (A0 == NULL)
+   {
+      MFEM_ABORT("SmoothedAggregationAMG::SetOperator : not a SparseMatrix!");
+   }
+   MFEM_VERIFY(A0->Finalized(), "Matrix must be finalized.");
+   MFEM_VERIFY(A0->Height() % vdim == 0,
+               "The vector dimension must divide the matrix size.");
+
+   Clear();
+   height = width = A0->Height();
+
+   A.Append(const_cast<SparseMatrix *>(A0));
+   for (int l = 0; true; l++)
+   {
+      const int n = A[l]->Height();
+      Vector *d = new Vector;
+      A[l]->GetDiag(*d);
+      for (int i = 0; i < n; i++)
+      {
+         MFEM_VERIFY((*d)(i) != 0.0, "SmoothedAggregationAMG: zero diagonal "
+                     "entry in row " << i << " of level " << l);
+         (*d)(i) = 1.0/(*d)(i);
+      }
+      dinv.Append(d);
+      lambda_max.Append(EstimateLargestEigenvalue(l));
+
+      if (n <= max_coarse_size || l+1 == max_levels) { break; }
+
+      // On the coarse levels, the unknowns are always ordered by vdim.
+      SparseMatrix *Pl = BuildProlongation(l, (l == 0) && order_bynodes);
+      if (Pl->Width() == 0 || Pl->Width() >= n)
+      {
+         // Coarsening stagnated
+         delete Pl;
+         break;
+      }
+      P.Append(Pl);
+      A.Append(RAP(*Pl, *A[l], *Pl));
+   }
+
+   coarse_solver.SetOperator(*A.Last());
+
+   const int num_levels = A.Size();
+   b_l.SetSize(num_levels);
+   x_l.SetSize(num_levels);
+   r_l.SetSize(num_levels);
+   d_l.SetSize(num_levels);
+   z_l.SetSize(num_levels);
+   for (int l = 0; l < num_levels; l++)
+   {
+      const int n = A[l]->Height();
+      b_l[l] = new Vector(n);
+      x_l[l] = new Vector(n);
+      r_l[l] = new Vector(n);
+      d_l[l] = new Vector(n);
+      z_l[l] = new Vector(n);
+   }
+}
+
+int SmoothedAggregationAMG::Aggregate(const SparseMatrix &Al, int nnodes,
+                                      bool bynodes, Array<int> &aggregate) const
+{
+   const int n = Al.Height();
+   const int *I = Al.GetI(), *J = Al.GetJ();
+   const double *V = Al.GetData();
+
+   // Node-level matrix: the Frobenius norms of the vdim x vdim blocks.
+   SparseMatrix *S_own = NULL;
+   const SparseMatrix *S = &Al;
+   if (vdim > 1)
+   {
+      S_own = new SparseMatrix(nnodes, nnodes);
+      for (int i = 0; i < n; i++)
+      {
+         const int ni = bynodes ? i % nnodes : i / vdim;
+         for (int k = I[i]; k < I[i+1]; k++)
+         {
+            const int nj = bynodes ? J[k] % nnodes : J[k] / vdim;
+            S_own->Add(ni, nj, V[k]*V[k]);
+         }
+      }
+      S_own->Finalize();
+      double *SV = S_own->GetData();
+      for (int k = 0; k < S_own->NumNonZeroElems(); k++)
+      {
+         SV[k] = std::sqrt(SV[k]);
+      }
+      S = S_own;
+   }
+   const int *SI = S->GetI(), *SJ = S->GetJ();
+   const double *SV = S->GetData();
+
+   Vector diag;
+   S->GetDiag(diag);
+
+   // Strong connections of each node; -2 marks isolated nodes, e.g. rows with
+   // essential boundary conditions, which are not aggregated.
+   Array<bool> strong(SI[nnodes]);
+   aggregate.SetSize(nnodes);
+   for (int i = 0; i < nnodes; i++)
+   {
+      int num_strong = 0;
+      for (int k = SI[i]; k < SI[i+1]; k++)
+      {
+         const int j = SJ[k];
+         strong[k] = (j != i) && (std::abs(SV[k]) >=
+                                  theta*std::sqrt(std::abs(diag(i)*diag(j))));
+         num_strong += strong[k];
+      }
+      aggregate[i] = (num_strong > 0) ? -1 : -2;
+   }
+
+   // Phase 1: nodes whose strong neighborhood is free form a new aggregate.
+   int num_agg = 0;
+   for (int i = 0; i < nnodes; i++)
+   {
+      if (aggregate[i] != -1) { continue; }
+      bool free = true;
+      for (int k = SI[i]; k < SI[i+1] && free; k++)
+      {
+         if (strong[k] && aggregate[SJ[k]] >= 0) { free = false; }
+      }
+      if (!free) { continue; }
+      aggregate[i] = num_agg;
+      for (int k = SI[i]; k < SI[i+1]; k++)
+      {
+         if (strong[k]) { aggregate[SJ[k]] = num_agg; }
+      }
+      num_agg++;
+   }
+
+   // Phase 2: attach the remaining nodes to the aggregate of their strongest
+   // aggregated neighbor (from phase 1).
+   Array<int> phase1(aggregate);
+   for (int i = 0; i < nnodes; i++)
+   {
+      if (aggregate[i] != -1) { continue; }
+      double max_s = 0.0;
+      for (int k = SI[i]; k < SI[i+1]; k++)
+      {
+         if (strong[k] && phase1[SJ[k]] >= 0 && std::abs(SV[k]) > max_s)
+         {
+            max_s = std::abs(SV[k]);
+            aggregate[i] = phase1[SJ[k]];
+         }
+      }
+   }
+
+   // Phase 3: the leftover nodes form aggregates with their free neighbors.
+   for (int i = 0; i < nnodes; i++)
+   {
+      if (aggregate[i] != -1) { continue; }
+      aggregate[i] = num_agg;
+      for (int k = SI[i]; k < SI[i+1]; k++)
+      {
+         if (strong[k] && aggregate[SJ[k]] == -1)
+         {
+            aggregate[SJ[k]] = num_agg;
+         }
+      }
+      num_agg++;
+   }
+
+   for (int i = 0; i < nnodes; i++)
+   {
+      if (aggregate[i] == -2) { aggregate[i] = -1; }
+   }
+   delete S_own;
+   return num_agg;
+}
+
+SparseMatrix *SmoothedAggregationAMG::BuildProlongation(int l,
+                                                        bool bynodes) const
+{
+   const SparseMatrix &Al = *A[l];
+   const int n = Al.Height();
+   const int nnodes = n / vdim;
+
+   Array<int> aggregate;
+   const int num_agg = Aggregate(Al, nnodes, bynodes, aggregate);
+
+   Array<int> agg_size(num_agg);
+   agg_size = 0;
+   for (int i = 0; i < nnodes; i++)
+   {
+      if (aggregate[i] >= 0) { agg_size[aggregate[i]]++; }
+   }
+
+   // Tentative prolongator: one normalized constant vector per aggregate and
+   // component. The coarse unknowns are ordered by vdim.
+   int *Pt_I = new int[n+1];
+   int *Pt_J = new int[n];
+   double *Pt_V = new double[n];
+   int nnz = 0;
+   for (int i = 0; i < n; i++)
+   {
+      Pt_I[i] = nnz;
+      const int node = bynodes ? i % nnodes : i / vdim;
+      const int comp = bynodes ? i / nnodes : i % vdim;
+      const int a = aggregate[node];
+      if (a >= 0)
+      {
+         Pt_J[nnz] = a*vdim + comp;
+         Pt_V[nnz] = 1.0/std::sqrt(double(agg_size[a]));
+         nnz++;
+      }
+   }
+   Pt_I[n] = nnz;
+   SparseMatrix Pt(Pt_I, Pt_J, Pt_V, n, num_agg*vdim);
+
+   // Smoothed prolongator: P = Pt - omega/lambda D^{-1} A Pt
+   SparseMatrix *AP = mfem::Mult(Al, Pt);
+   Vector scale(*dinv[l]);
+   scale *= -p_omega/lambda_max[l];
+   AP->ScaleRows(scale);
+   SparseMatrix *Pl = Add(Pt, *AP);
+   delete AP;
+   return Pl;
+}
+
+double SmoothedAggregationAMG::EstimateLargestEigenvalue(int l) const
+{
+   // Power iteration for D^{-1} A with the Rayleigh quotient in the D inner
+   // product, i.e. (v, A v)/(v, D v).
+   const SparseMatrix &Al = *A[l];
+   const Vector &di = *dinv[l];
+   const int n = Al.Height();
+   Vector v(n), Av(n);
+   v.Randomize(1);
+   double lambda = 1.0;
+   for (int it = 0; it < 10; it++)
+   {
+      Al.Mult(v, Av);
+      double vAv = 0.0, vDv = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         vAv += v(i)*Av(i);
+         vDv += v(i)*v(i)/di(i);
+      }
+      if (vDv == 0.0) { break; }
+      lambda = vAv/vDv;
+      for (int i = 0; i < n; i++) { v(i) = di(i)*Av(i); }
+      const double norm = v.Norml2();
+      if (norm == 0.0) { break; }
+      v /= norm;
+   }
+   return lambda;
+}
+
+void SmoothedAggregationAMG::Smooth(int l, const Vector &b, Vector &x) const
+{
+   const SparseMatrix &Al = *A[l];
+   const Vector &di = *dinv[l];
+   Vector &r = *r_l[l];
+   const int n = Al.Height();
+
+   if (smoother_type == SmootherType::JACOBI)
+   {
+      const double omega = 4.0/(3.0*lambda_max[l]);
+      for (int it = 0; it < smoother_sweeps; it++)
+      {
+         Al.Mult(x, r);
+         for (int i = 0; i < n; i++)
+         {
+            x(i) += omega*di(i)*(b(i) - r(i));
+         }
+      }
+      return;
+   }
+
+   // Chebyshev smoother targeting the interval [lmax/30, 1.1 lmax] of the
+   // spectrum of D^{-1} A.
+   Vector &d = *d_l[l], &Ad = *z_l[l];
+   const double upper = 1.1*lambda_max[l], lower = upper/30.0;
+   const double theta_c = 0.5*(upper + lower), delta = 0.5*(upper - lower);
+   const double sigma = theta_c/delta;
+   for (int it = 0; it < smoother_sweeps; it++)
+   {
+      Al.Mult(x, r);
+      for (int i = 0; i < n; i++)
+      {
+         r(i) = di(i)*(b(i) - r(i));
+         d(i) = r(i)/theta_c;
+      }
+      double rho = 1.0/sigma;
+      for (int k = 0; k < cheby_order; k++)
+      {
+         x += d;
+         if (k == cheby_order-1) { break; }
+         Al.Mult(d, Ad);
+         const double rho_new = 1.0/(2.0*sigma - rho);
+         for (int i = 0; i < n; i++)
+         {
+            r(i) -= di(i)*Ad(i);
+            d(i) = rho_new*rho*d(i) + 2.0*rho_new/delta*r(i);
+         }
+         rho = rho_new;
+      }
+   }
+}
+
+void SmoothedAggregationAMG::Cycle(int l, const Vector &b, Vector &x) const
+{
+   if (l == A.Size()-1)
+   {
+      coarse_solver.Mult(b, x);
+      return;
+   }
+
+   Smooth(l, b, x);
+
+   Vector &r = *r_l[l];
+   A[l]->Mult(x, r);
+   subtract(b, r, r);
+   P[l]->MultTranspose(r, *b_l[l+1]);
+   Vector &xc = *x_l[l+1];
+   xc = 0.0;
+   Cycle(l+1, *b_l[l+1], xc);
+   P[l]->AddMult(xc, x);
+
+   Smooth(l, b, x);
+}
+
+void SmoothedAggregationAMG::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_ASSERT(A.Size() > 0, "SmoothedAggregationAMG is not constructed");
+   if (!iterative_mode)
+   {
+      x = 0.0;
+   }
+   Cycle(0, b, x);
+}
+
+double SmoothedAggregationAMG::GetOperatorComplexity() const
+{
+   double nnz = 0.0;
+   for (int l = 0; l < A.Size(); l++) { nnz += A[l]->NumNonZeroElems(); }
+   return nnz/A[0]->NumNonZeroElems();
+}
+
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_AMG
+#define MFEM_AMG
+
+#include "../config/config.hpp"
+#include "operator.hpp"
+#include "sparsemat.hpp"
+#include "sparseldl.hpp"
+
+namespace mfem
+{
+
+/** @brief Serial smoothed aggregation algebraic multigrid preconditioner for
+    SparseMatrix operators.
+
+    The hierarchy is built in SetOperator():
+
+    - the nodes of the matrix graph (blocks of vdim unknowns for systems, see
+      SetSystemsOptions()) are grouped in aggregates of strongly connected
+      nodes,
+
+    - the tentative prolongator is piecewise constant on the aggregates (for
+      each of the vdim components) and is smoothed with one damped Jacobi
+      step: P = (I - omega/lambda D^{-1} A) P_tent, where lambda is an
+      estimate of the largest eigenvalue of D^{-1} A,
+
+    - the coarse operators are the Galerkin products P^T A P, see RAP().
+
+    The coarsest level is solved with SparseLDLSolver. Mult() applies one
+    symmetric V-cycle with Jacobi or Chebyshev smoothing, so the preconditioner
+    can be used with CG for symmetric positive definite matrices. */
+class SmoothedAggregationAMG : public Solver
+{
+public:
+   /// Type of the smoother used on each level (except the coarsest).
+   enum class SmootherType
+   {
+      JACOBI,
+      CHEBYSHEV
+   };
+
+   /** Create an "empty" preconditioner. SetOperator must be called later to
+       actually build the hierarchy. */
+   SmoothedAggregationAMG();
+
+   /// Create the multigrid hierarchy for the matrix @a A.
+   SmoothedAggregationAMG(const SparseMatrix &A);
+
+   /** @brief Options for systems, e.g. elasticity: the matrix has @a dim
+       unknowns per node, ordered by nodes (Ordering::byNODES, the default in
+       FiniteElementSpace) when @a order_bynodes is true and by vector
+       dimension (Ordering::byVDIM) otherwise. Aggregation is performed on the
+       nodes. Call before SetOperator(). */
+   void SetSystemsOptions(int dim, bool order_bynodes = false);
+
+   /** @brief Set the strength of connection threshold: node j is strongly
+       connected to node i if |a_ij| >= theta sqrt(|a_ii a_jj|). */
+   void SetStrengthThreshold(double theta_) { theta = theta_; }
+
+   /// Set the smoother type, the number of sweeps and the Chebyshev order.
+   void SetSmoother(SmootherType type, int sweeps = 1, int cheby_order = 2);
+
+   /// Set the damping factor omega of the prolongation smoothing.
+   void SetProlongationDamping(double omega) { p_omega = omega; }
+
+   /// Set the maximum number of levels in the hierarchy.
+   void SetMaxLevels(int max_levels_) { max_levels = max_levels_; }
+
+   /// Stop coarsening when the number of unknowns is less or equal to this.
+   void SetMaxCoarseSize(int size) { max_coarse_size = size; }
+
+   virtual void SetOperator(const Operator &op);
+
+   /// Apply one V-cycle.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Return the number of levels in the hierarchy.
+   int GetNumLevels() const { return A.Size(); }
+
+   /// Return the matrix on level @a l, where level 0 is the finest level.
+   const SparseMatrix &GetLevelMatrix(int l) const { return *A[l]; }
+
+   /// Return the prolongation from level @a l+1 to level @a l.
+   const SparseMatrix &GetProlongation(int l) const { return *P[l]; }
+
+   /** @brief Return the operator complexity: the total number of nonzeros in
+       all levels, divided by the number of nonzeros in the finest level. */
+   double GetOperatorComplexity() const;
+
+   virtual ~SmoothedAggregationAMG();
+
+protected:
+   int vdim;
+   bool order_bynodes;
+   double theta;
+   SmootherType smoother_type;
+   int smoother_sweeps, cheby_order;
+   double p_omega;
+   int max_levels, max_coarse_size;
+
+   /// Level matrices; A[0] is the given matrix and is not owned.
+   Array<SparseMatrix *> A;
+   /// Prolongations, P[l] maps level l+1 to level l.
+   Array<SparseMatrix *> P;
+   /// Inverse diagonals of the level matrices.
+   Array<Vector *> dinv;
+   /// Estimates of the largest eigenvalues of D^{-1} A on each level.
+   Array<double> lambda_max;
+   /// Direct solver on the coarsest level.
+   SparseLDLSolver coarse_solver;
+
+   /// Level vectors used in Mult().
+   mutable Array<Vector *> b_l, x_l, r_l, d_l, z_l;
+
+   void Clear();
+
+   /** Compute the aggregates of the nodes of @a Al; returns the number of
+       aggregates. Nodes that are not aggregated get aggregate -1. */
+   int Aggregate(const SparseMatrix &Al, int nnodes, bool bynodes,
+                 Array<int> &aggregate) const;
+
+   /// Build the smoothed prolongator of level @a l.
+   SparseMatrix *BuildProlongation(int l, bool bynodes) const;
+
+   /// Estimate the largest eigenvalue of D^{-1} A on level @a l.
+   double EstimateLargestEigenvalue(int l) const;
+
+   /// Apply the smoother of level @a l to the system A_l x = b.
+   void Smooth(int l, const Vector &b, Vector &x) const;
+
+   /// Apply a V-cycle starting at level @a l.
+   void Cycle(int l, const Vector &b, Vector &x) const;
+};
+
+}
+
+#endif
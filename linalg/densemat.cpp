@@ -1035,6 +1035,143 @@ void dsyevr_Eigensystem(DenseMatrix &a, Vector &ev, DenseMatrix *evect)
 #endif
 }
 
+#ifndef MFEM_USE_LAPACK
+// Compute the eigenvalues (in increasing order) and, optionally, the
+// eigenvectors of the symmetric matrix a using the cyclic Jacobi method.
+static void Jacobi_Eigensystem(const DenseMatrix &a, Vector &ev,
+                               DenseMatrix *evect)
+{
+   const int n = a.Width();
+   DenseMatrix A(a), V(n);
+
+   V = 0.0;
+   for (int i = 0; i < n; i++) { V(i,i) = 1.0; }
+
+   for (int sweep = 0; sweep < 100; sweep++)
+   {
+      double off = 0.0, nrm = 0.0;
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = 0; i < n; i++)
+         {
+            nrm += A(i,j)*A(i,j);
+            if (i != j) { off += A(i,j)*A(i,j); }
+         }
+      }
+      if (off <= 1e-30*nrm) { break; }
+
+      for (int p = 0; p < n-1; p++)
+      {
+         for (int q = p+1; q < n; q++)
+         {
+            const double apq = A(p,q);
+            if (apq == 0.0) { continue; }
+            const double theta = (A(q,q) - A(p,p))/(2.0*apq);
+            const double t = (theta >= 0.0 ? 1.0 : -1.0)/
+                             (fabs(theta) + sqrt(theta*theta + 1.0));
+            const double c = 1.0/sqrt(t*t + 1.0), s = t*c;
+            for (int k = 0; k < n; k++)
+            {
+               const double akp = A(k,p), akq = A(k,q);
+               A(k,p) = c*akp - s*akq;
+               A(k,q) = s*akp + c*akq;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const double apk = A(p,k), aqk = A(q,k);
+               A(p,k) = c*apk - s*aqk;
+               A(q,k) = s*apk + c*aqk;
+            }
+            for (int k = 0; k < n; k++)
+            {
+               const double vkp = V(k,p), vkq = V(k,q);
+               V(k,p) = c*vkp - s*vkq;
+               V(k,q) = s*vkp + c*vkq;
+            }
+         }
+      }
+   }
+
+   // sort the eigenpairs
+   Array<int> perm(n);
+   for (int i = 0; i < n; i++) { perm[i] = i; }
+   std::sort(perm.GetData(), perm.GetData() + n,
+             [&A](int i, int j) { return A(i,i) < A(j,j); });
+   ev.SetSize(n);
+   for (int i = 0; i < n; i++) { ev(i) = A(perm[i],perm[i]); }
+   if (evect)
+   {
+      evect->SetSize(n);
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = 0; i < n; i++) { (*evect)(i,j) = V(i,perm[j]); }
+      }
+   }
+}
+
+// Compute the generalized eigenvalues (in increasing order) and, optionally,
+// the eigenvectors of a x = ev b x, for symmetric a and symmetric positive
+// definite b, by reduction to a standard problem with the Cholesky factor of b.
+static void Jacobi_Eigensystem(const DenseMatrix &a, const DenseMatrix &b,
+                               Vector &ev, DenseMatrix *evect)
+{
+   const int n = a.Width();
+   DenseMatrix L(n), C(a);
+
+   // b = L L^t
+   L = 0.0;
+   for (int j = 0; j < n; j++)
+   {
+      double d = b(j,j);
+      for (int k = 0; k < j; k++) { d -= L(j,k)*L(j,k); }
+      MFEM_VERIFY(d > 0.0, "the matrix b is not positive definite");
+      L(j,j) = sqrt(d);
+      for (int i = j+1; i < n; i++)
+      {
+         double s = b(i,j);
+         for (int k = 0; k < j; k++) { s -= L(i,k)*L(j,k); }
+         L(i,j) = s/L(j,j);
+      }
+   }
+
+   // C = L^{-1} a L^{-t}
+   for (int j = 0; j < n; j++)
+   {
+      for (int i = 0; i < n; i++)
+      {
+         double s = C(i,j);
+         for (int k = 0; k < i; k++) { s -= L(i,k)*C(k,j); }
+         C(i,j) = s/L(i,i);
+      }
+   }
+   for (int i = 0; i < n; i++)
+   {
+      for (int j = 0; j < n; j++)
+      {
+         double s = C(i,j);
+         for (int k = 0; k < j; k++) { s -= C(i,k)*L(j,k); }
+         C(i,j) = s/L(j,j);
+      }
+   }
+
+   Jacobi_Eigensystem(C, ev, evect);
+
+   if (evect)
+   {
+      // evect = L^{-t} evect
+      for (int j = 0; j < n; j++)
+      {
+         for (int i = n-1; i >= 0; i--)
+         {
+            double s = (*evect)(i,j);
+            for (int k = i+1; k < n; k++) { s -= L(k,i)*(*evect)(k,j); }
+            (*evect)(i,j) = s/L(i,i);
+         }
+      }
+   }
+}
+#endif
+
 void dsyev_Eigensystem(DenseMatrix &a, Vector &ev, DenseMatrix *evect)
 {
 #ifdef MFEM_USE_LAPACK
@@ -1098,7 +1235,7 @@ void DenseMatrix::Eigensystem(Vector &ev, DenseMatrix *evect)
 
 #else
 
-   mfem_error("DenseMatrix::Eigensystem");
+   Jacobi_Eigensystem(*this, ev, evect);
 
 #endif
 }
@@ -1172,7 +1309,8 @@ void DenseMatrix::Eigensystem(DenseMatrix &b, Vector &ev,
 
 #else
 
-   mfem_error("DenseMatrix::Eigensystem for generalized eigenvalues");
+   Jacobi_Eigensystem(*this, b, ev, evect);
+
 #endif
 }
 
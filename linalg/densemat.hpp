@@ -784,6 +784,12 @@ public:
       return tdata+k*Mk.Height()*Mk.Width();
    }
 
+   const double *GetData(int k) const
+   {
+      MFEM_ASSERT_INDEX_IN_RANGE(k, 0, SizeK());
+      return tdata+k*Mk.Height()*Mk.Width();
+   }
+
    double *Data() { return tdata; }
 
    const double *Data() const { return tdata; }
@@ -11,6 +11,8 @@
 
 #include "operator.hpp"
 #include "ode.hpp"
+#include <algorithm>
+#include <cmath>
 
 namespace mfem
 {
@@ -343,6 +345,295 @@ const double RK8Solver::c[] =
    1.,
 };
 
+void LowStorageRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   dq.SetSize(n, mem_type);
+   k.SetSize(n, mem_type);
+}
+
+void LowStorageRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   for (int i = 0; i < s; i++)
+   {
+      f->SetTime(t + c[i]*dt);
+      f->Mult(x, k);
+      if (i == 0) { dq = k; dq *= dt; }
+      else { add(A[i], dq, dt, k, dq); }
+      x.Add(B[i], dq);
+   }
+   t += dt;
+}
+
+const double LSRK33Solver::A[] = { 0., -5./9., -153./128. };
+const double LSRK33Solver::B[] = { 1./3., 15./16., 8./15. };
+const double LSRK33Solver::c[] = { 0., 1./3., 3./4. };
+
+const double LSRK54Solver::A[] =
+{
+   0.,
+   -567301805773./1357537059087.,
+   -2404267990393./2016746695238.,
+   -3550918686646./2091501179385.,
+   -1275806237668./842570457699.
+};
+const double LSRK54Solver::B[] =
+{
+   1432997174477./9575080441755.,
+   5161836677717./13612068292357.,
+   1720146321549./2090206949498.,
+   3134564353537./4481467310338.,
+   2277821191437./14882151754819.
+};
+const double LSRK54Solver::c[] =
+{
+   0.,
+   1432997174477./9575080441755.,
+   2526269341429./6820363962896.,
+   2006345519317./3224310063776.,
+   2802321613138./2924317926251.
+};
+
+
+void SSPRK104Solver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   k.SetSize(n, mem_type);
+}
+
+void SSPRK104Solver::Step(Vector &x, double &t, double &dt)
+{
+   // y = x, x = x + dt/6 f(x), 5 times
+   y = x;
+   for (int i = 0; i < 5; i++)
+   {
+      f->SetTime(t + i*dt/6);
+      f->Mult(x, k);
+      x.Add(dt/6, k);
+   }
+
+   // y = 1/25 y + 9/25 x, x = 15 y - 5 x
+   add(1./25, y, 9./25, x, y);
+   add(15., y, -5., x, x);
+
+   // x = x + dt/6 f(x), 4 times
+   for (int i = 0; i < 4; i++)
+   {
+      f->SetTime(t + (i + 2)*dt/6);
+      f->Mult(x, k);
+      x.Add(dt/6, k);
+   }
+
+   // x = y + 3/5 x + dt/10 f(x)
+   f->SetTime(t + dt);
+   f->Mult(x, k);
+   add(y, 3./5, x, x);
+   x.Add(dt/10, k);
+   t += dt;
+}
+
+
+ODEWRMSNorm::ODEWRMSNorm(double rtol_, double atol_)
+   : rtol(rtol_), atol(atol_)
+{
+#ifdef MFEM_USE_MPI
+   comm = MPI_COMM_NULL;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+ODEWRMSNorm::ODEWRMSNorm(MPI_Comm comm_, double rtol_, double atol_)
+   : rtol(rtol_), atol(atol_), comm(comm_) { }
+#endif
+
+double ODEWRMSNorm::Eval(const Vector &err, const Vector &x0,
+                         const Vector &x1) const
+{
+   const int n = err.Size();
+   const double *e = err.HostRead(), *y0 = x0.HostRead(), *y1 = x1.HostRead();
+   double loc[2] = { 0.0, (double) n };
+   for (int i = 0; i < n; i++)
+   {
+      const double w = atol + rtol*std::max(std::abs(y0[i]), std::abs(y1[i]));
+      loc[0] += (e[i]/w)*(e[i]/w);
+   }
+#ifdef MFEM_USE_MPI
+   if (comm != MPI_COMM_NULL)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, loc, 2, MPI_DOUBLE, MPI_SUM, comm);
+   }
+#endif
+   return (loc[1] > 0.0) ? std::sqrt(loc[0]/loc[1]) : 0.0;
+}
+
+
+EmbeddedRKSolver::EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                                   const double *_c, const double *_e, int _q,
+                                   bool _fsal)
+{
+   s = _s;
+   q = _q;
+   fsal = _fsal;
+   a = _a;
+   b = _b;
+   c = _c;
+   e = _e;
+   k = new Vector[s + fsal];
+   norm = &def_norm;
+   SetStepControl();
+   max_step = 0.0;
+   h = 0.0;
+   err_prev = 1.0;
+   num_steps = num_rejected = 0;
+}
+
+void EmbeddedRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   xn.SetSize(n, mem_type);
+   err.SetSize(n, mem_type);
+   for (int i = 0; i < s + fsal; i++)
+   {
+      k[i].SetSize(n, mem_type);
+   }
+   h = 0.0;
+   err_prev = 1.0;
+   num_steps = num_rejected = 0;
+}
+
+void EmbeddedRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   const double tf = t + dt;
+   const double alpha = 0.7/(q + 1), beta = 0.4/(q + 1);
+   if (h <= 0.0) { h = dt; }
+
+   // k[0] = f(x, t) is available after a rejected step or, for FSAL methods,
+   // after an accepted step
+   bool have_k0 = false, last = false, rejected = false;
+   while (!last)
+   {
+      if (max_step > 0.0) { h = std::min(h, max_step); }
+      double hs = h;
+      if (t + 1.01*h >= tf)
+      {
+         hs = tf - t;
+         last = true;
+      }
+
+      if (!have_k0)
+      {
+         f->SetTime(t);
+         f->Mult(x, k[0]);
+      }
+      for (int l = 0, i = 1; i < s; i++)
+      {
+         add(x, a[l++]*hs, k[0], y);
+         for (int j = 1; j < i; j++)
+         {
+            y.Add(a[l++]*hs, k[j]);
+         }
+
+         f->SetTime(t + c[i-1]*hs);
+         f->Mult(y, k[i]);
+      }
+      add(x, b[0]*hs, k[0], xn);
+      for (int i = 1; i < s; i++)
+      {
+         xn.Add(b[i]*hs, k[i]);
+      }
+      if (fsal)
+      {
+         f->SetTime(t + hs);
+         f->Mult(xn, k[s]);
+      }
+      err = 0.0;
+      for (int i = 0; i < s + fsal; i++)
+      {
+         if (e[i] != 0.0) { err.Add(e[i]*hs, k[i]); }
+      }
+
+      const double en = std::max(norm->Eval(err, x, xn), 1e-10);
+      if (en <= 1.0)
+      {
+         x.Swap(xn);
+         t = last ? tf : t + hs;
+         dt = hs;
+         num_steps++;
+
+         double factor = safety*std::pow(en, -alpha)*std::pow(err_prev, beta);
+         factor = std::min(max_factor, std::max(min_factor, factor));
+         if (rejected) { factor = std::min(factor, 1.0); }
+         // a step shortened to reach tf does not limit the next step size
+         h = (hs < h) ? std::max(h, hs*factor) : hs*factor;
+         err_prev = std::max(en, 1e-4);
+         rejected = false;
+
+         if (fsal) { k[0].Swap(k[s]); }
+         have_k0 = fsal;
+      }
+      else
+      {
+         const double factor = safety*std::pow(en, -alpha);
+         h = hs*std::max(min_factor, factor);
+         MFEM_VERIFY(t + h > t, "the step size is too small, h = " << h);
+         num_rejected++;
+         rejected = true;
+         have_k0 = true;
+         last = false;
+      }
+   }
+}
+
+EmbeddedRKSolver::~EmbeddedRKSolver()
+{
+   delete [] k;
+}
+
+const double DormandPrince54Solver::a[] =
+{
+   1./5.,
+   3./40., 9./40.,
+   44./45., -56./15., 32./9.,
+   19372./6561., -25360./2187., 64448./6561., -212./729.,
+   9017./3168., -355./33., 46732./5247., 49./176., -5103./18656.
+};
+const double DormandPrince54Solver::b[] =
+{
+   35./384., 0., 500./1113., 125./192., -2187./6784., 11./84.
+};
+const double DormandPrince54Solver::c[] =
+{
+   1./5., 3./10., 4./5., 8./9., 1.
+};
+const double DormandPrince54Solver::e[] =
+{
+   71./57600., 0., -71./16695., 71./1920., -17253./339200., 22./525.,
+   -1./40.
+};
+
+// The weights bhat of the embedded 5th order method satisfy the order
+// conditions with the additional FSAL stage. They form a one-parameter family,
+// bhat = b + gamma d, in which gamma is chosen such that the ratio of the
+// principal error norms of the 5th and 6th order methods is the same as for
+// the Dormand-Prince 5(4) pair.
+const double Verner65Solver::e[] =
+{
+   -.2801091360183573296048549185238136234024e-4,
+   0.,
+   0.,
+   .6312645402429355082217952685082789019497e-4,
+   -.9241275245257319680661468526695144144179e-4,
+   .6852854432246905337342476089529418982719e-2,
+   -.3360584998344866532812305825258620128041,
+   .3293712173848251983711281597814634892222,
+   -.1082747705553350482951326948623421892873e-3
+};
+
 
 AdamsBashforthSolver::AdamsBashforthSolver(int _s, const double *_a)
 {
@@ -634,6 +925,151 @@ void SDIRK33Solver::Step(Vector &x, double &t, double &dt)
 }
 
 
+IMEXRKSolver::IMEXRKSolver(int _s, const double *_ae, const double *_ai,
+                           double _gamma, const double *_b, const double *_c)
+{
+   s = _s;
+   gamma = _gamma;
+   ae = _ae;
+   ai = _ai;
+   b = _b;
+   c = _c;
+   ke = new Vector[s];
+   ki = new Vector[s];
+}
+
+void IMEXRKSolver::Init(TimeDependentOperator &_f)
+{
+   ODESolver::Init(_f);
+   int n = f->Width();
+   y.SetSize(n, mem_type);
+   for (int i = 0; i < s; i++)
+   {
+      ke[i].SetSize(n, mem_type);
+      ki[i].SetSize(n, mem_type);
+   }
+}
+
+void IMEXRKSolver::Step(Vector &x, double &t, double &dt)
+{
+   // The first stage is explicit in both tableaus
+   f->SetTime(t);
+   f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+   f->Mult(x, ke[0]);
+   f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+   f->Mult(x, ki[0]);
+   for (int l = 0, i = 1; i < s; i++)
+   {
+      y = x;
+      for (int j = 0; j < i; j++, l++)
+      {
+         y.Add(ae[l]*dt, ke[j]);
+         y.Add(ai[l]*dt, ki[j]);
+      }
+
+      // y = y + gamma dt ki[i], ki[i] = f2(y + gamma dt ki[i], t_i)
+      f->SetTime(t + c[i-1]*dt);
+      f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_2);
+      f->ImplicitSolve(gamma*dt, y, ki[i]);
+      y.Add(gamma*dt, ki[i]);
+
+      f->SetEvalMode(TimeDependentOperator::ADDITIVE_TERM_1);
+      f->Mult(y, ke[i]);
+   }
+   for (int i = 0; i < s; i++)
+   {
+      x.Add(b[i]*dt, ke[i]);
+      x.Add(b[i]*dt, ki[i]);
+   }
+   f->SetEvalMode(TimeDependentOperator::NORMAL);
+   t += dt;
+}
+
+IMEXRKSolver::~IMEXRKSolver()
+{
+   delete [] ke;
+   delete [] ki;
+}
+
+const double ARK2Solver::ae[] =
+{
+   .5857864376269049511983112757903019214303,
+   .2859547920896831706610375859676730714344e-1,
+   .9714045207910316829338962414032326928566
+};
+const double ARK2Solver::ai[] =
+{
+   .2928932188134524755991556378951509607152,
+   .3535533905932737622004221810524245196424,
+   .3535533905932737622004221810524245196424
+};
+const double ARK2Solver::b[] =
+{
+   .3535533905932737622004221810524245196424,
+   .3535533905932737622004221810524245196424,
+   .2928932188134524755991556378951509607152
+};
+const double ARK2Solver::c[] =
+{
+   .5857864376269049511983112757903019214303,
+   1.
+};
+
+const double ARK3Solver::ae[] =
+{
+   1767732205903./2027836641118.,
+   5535828885825./10492691773637., 788022342437./10882634858940.,
+   6485989280629./16251701735622., -4246266847089./9704473918619.,
+   10755448449292./10357097424841.
+};
+const double ARK3Solver::ai[] =
+{
+   1767732205903./4055673282236.,
+   2746238789719./10658868560708., -640167445237./6845629431997.,
+   1471266399579./7840856788654., -4482444167858./7529755066697.,
+   11266239266428./11593286722821.
+};
+const double ARK3Solver::b[] =
+{
+   1471266399579./7840856788654., -4482444167858./7529755066697.,
+   11266239266428./11593286722821., 1767732205903./4055673282236.
+};
+const double ARK3Solver::c[] =
+{
+   1767732205903./2027836641118., 3./5., 1.
+};
+
+const double ARK4Solver::ae[] =
+{
+   1./2.,
+   13861./62500., 6889./62500.,
+   -116923316275./2393684061468., -2731218467317./15368042101831.,
+   9408046702089./11113171139209.,
+   -451086348788./2902428689909., -2682348792572./7519795681897.,
+   12662868775082./11960479115383., 3355817975965./11060851509271.,
+   647845179188./3216320057751., 73281519250./8382639484533.,
+   552539513391./3454668386233., 3354512671639./8306763924573.,
+   4040./17871.
+};
+const double ARK4Solver::ai[] =
+{
+   1./4.,
+   8611./62500., -1743./31250.,
+   5012029./34652500., -654441./2922500., 174375./388108.,
+   15267082809./155376265600., -71443401./120774400.,
+   730878875./902184768., 2285395./8070912.,
+   82889./524892., 0., 15625./83664., 69875./102672., -2260./8211.
+};
+const double ARK4Solver::b[] =
+{
+   82889./524892., 0., 15625./83664., 69875./102672., -2260./8211., 1./4.
+};
+const double ARK4Solver::c[] =
+{
+   1./2., 83./250., 31./50., 17./20., 1.
+};
+
+
 void GeneralizedAlphaSolver::Init(TimeDependentOperator &_f)
 {
    ODESolver::Init(_f);
@@ -15,6 +15,10 @@
 #include "../config/config.hpp"
 #include "operator.hpp"
 
+#ifdef MFEM_USE_MPI
+#include <mpi.h>
+#endif
+
 namespace mfem
 {
 
@@ -188,6 +192,7 @@ class RK6Solver : public ExplicitRKSolver
 {
 private:
    static const double a[28], b[8], c[7];
+   friend class Verner65Solver;
 
 public:
    RK6Solver() : ExplicitRKSolver(8, a, b, c) { }
@@ -206,6 +211,204 @@ public:
 };
 
 
+/** An explicit low-storage Runge-Kutta method in the 2N form of Williamson:
+       dq = A[i] dq + dt f(x, t + c[i] dt),  x = x + B[i] dq,
+    for i = 0, ..., s-1, with A[0] = 0. Besides the solution, only the
+    register dq and the output of the operator are stored, independently of
+    the number of stages. */
+class LowStorageRKSolver : public ODESolver
+{
+private:
+   int s;
+   const double *A, *B, *c;
+   Vector dq, k;
+
+public:
+   LowStorageRKSolver(int _s, const double *_A, const double *_B,
+                      const double *_c)
+      : s(_s), A(_A), B(_B), c(_c) { }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/** A 3-stage, 3rd order low-storage RK method. From Williamson's "Low-storage
+    Runge-Kutta schemes", 1980. */
+class LSRK33Solver : public LowStorageRKSolver
+{
+private:
+   static const double A[3], B[3], c[3];
+
+public:
+   LSRK33Solver() : LowStorageRKSolver(3, A, B, c) { }
+};
+
+
+/** A 5-stage, 4th order low-storage RK method, LSRK4(5). From Carpenter and
+    Kennedy's "Fourth-order 2N-storage Runge-Kutta schemes", 1994. */
+class LSRK54Solver : public LowStorageRKSolver
+{
+private:
+   static const double A[5], B[5], c[5];
+
+public:
+   LSRK54Solver() : LowStorageRKSolver(5, A, B, c) { }
+};
+
+
+/** A 10-stage, 4th order strong stability preserving (SSP) RK method with SSP
+    coefficient 6, implemented with two registers. From Ketcheson's "Highly
+    efficient strong stability preserving Runge-Kutta methods with low-storage
+    implementations", 2008. */
+class SSPRK104Solver : public ODESolver
+{
+private:
+   Vector y, k;
+
+public:
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+};
+
+
+/// Abstract class for the norm of the local error estimate of an ODE solver.
+class ODEErrorNorm
+{
+public:
+   /** @brief Return the norm of the local error estimate @a err of a step from
+       @a x0 to @a x1. The step is accepted if the norm is at most 1. */
+   virtual double Eval(const Vector &err, const Vector &x0,
+                       const Vector &x1) const = 0;
+
+   virtual ~ODEErrorNorm() { }
+};
+
+
+/** The weighted root-mean-square norm of the local error
+       sqrt( 1/N sum_i ( err_i / (atol + rtol max(|x0_i|, |x1_i|)) )^2 ),
+    where N is the global size of the vectors. When constructed with an MPI
+    communicator, the sums are reduced over all ranks, so the norm can be used
+    with parallel (true dof) vectors. */
+class ODEWRMSNorm : public ODEErrorNorm
+{
+private:
+   double rtol, atol;
+#ifdef MFEM_USE_MPI
+   MPI_Comm comm;
+#endif
+
+public:
+   ODEWRMSNorm(double rtol_ = 1e-6, double atol_ = 1e-8);
+
+#ifdef MFEM_USE_MPI
+   ODEWRMSNorm(MPI_Comm comm_, double rtol_ = 1e-6, double atol_ = 1e-8);
+#endif
+
+   void SetTolerances(double rtol_, double atol_)
+   { rtol = rtol_; atol = atol_; }
+
+   virtual double Eval(const Vector &err, const Vector &x0,
+                       const Vector &x1) const;
+};
+
+
+/** An explicit Runge-Kutta method with an embedded error estimate and
+    adaptive step size control. The method is given by its Butcher tableau,
+    in the format of ExplicitRKSolver, and the weights e = b - bhat of the
+    error estimate err = dt sum_i e[i] k[i], where bhat are the weights of the
+    embedded method of order q. If @a fsal is true, the method has an
+    additional stage k[s] = f(x + dt sum_i b[i] k[i], t + dt), which is used in
+    the error estimate and reused as the first stage of the next internal step.
+
+    Step() advances the solution to t + dt with as many internal steps as
+    needed to keep the norm of the error estimates, see SetErrorNorm(), at
+    most 1. The internal step size h is kept between the calls and is updated
+    after each step by the PI controller
+       h_new = h safety err^(-alpha) err_prev^beta,
+    with alpha = 0.7/(q+1) and beta = 0.4/(q+1), limited to [min_factor,
+    max_factor] h. A rejected step is repeated with h safety err^(-alpha). The
+    first internal step size is the @a dt of the first call to Step(). */
+class EmbeddedRKSolver : public ODESolver
+{
+private:
+   int s, q;
+   bool fsal;
+   const double *a, *b, *c, *e;
+   Vector y, xn, err, *k;
+
+   ODEWRMSNorm def_norm;
+   const ODEErrorNorm *norm;
+   double safety, min_factor, max_factor, max_step;
+   double h, err_prev;
+   int num_steps, num_rejected;
+
+public:
+   EmbeddedRKSolver(int _s, const double *_a, const double *_b,
+                    const double *_c, const double *_e, int _q, bool _fsal);
+
+   /** @brief Set the tolerances of the default error norm, ODEWRMSNorm,
+       which uses local reductions only. */
+   void SetTolerances(double rtol, double atol)
+   { def_norm.SetTolerances(rtol, atol); }
+
+   /** @brief Set the norm of the error estimate, e.g. an ODEWRMSNorm with an
+       MPI communicator for parallel vectors. The norm is not owned. */
+   void SetErrorNorm(const ODEErrorNorm &n) { norm = &n; }
+
+   /// Set the parameters of the step size controller.
+   void SetStepControl(double safety_ = 0.9, double min_factor_ = 0.2,
+                       double max_factor_ = 5.0)
+   { safety = safety_; min_factor = min_factor_; max_factor = max_factor_; }
+
+   /// Set the maximal internal step size, default is no limit.
+   void SetMaxStep(double hmax) { max_step = hmax; }
+
+   /// Return the number of accepted internal steps since Init().
+   int GetNumSteps() const { return num_steps; }
+
+   /// Return the number of rejected internal steps since Init().
+   int GetNumRejectedSteps() const { return num_rejected; }
+
+   /// Return the current internal step size.
+   double GetStepSize() const { return h; }
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   virtual ~EmbeddedRKSolver();
+};
+
+
+/** The 7-stage Dormand-Prince 5(4) pair: a 5th order method with an embedded
+    4th order error estimate and the first same as last (FSAL) property. */
+class DormandPrince54Solver : public EmbeddedRKSolver
+{
+private:
+   static const double a[15], b[6], c[5], e[7];
+
+public:
+   DormandPrince54Solver() : EmbeddedRKSolver(6, a, b, c, e, 4, true) { }
+};
+
+
+/** The 8-stage, 6th order method of RK6Solver with an embedded 5th order error
+    estimate that uses one additional, FSAL, stage. */
+class Verner65Solver : public EmbeddedRKSolver
+{
+private:
+   static const double e[9];
+
+public:
+   Verner65Solver()
+      : EmbeddedRKSolver(8, RK6Solver::a, RK6Solver::b, RK6Solver::c, e, 5,
+                         true) { }
+};
+
+
 /** An explicit Adams-Bashforth method. */
 class AdamsBashforthSolver : public ODESolver
 {
@@ -431,6 +634,80 @@ public:
 };
 
 
+/** An implicit-explicit (IMEX) additive Runge-Kutta method for
+       dx/dt = f1(x,t) + f2(x,t),
+    where the non-stiff term f1 is integrated explicitly and the stiff term f2
+    with a singly diagonally implicit method with an explicit first stage. As
+    in ARKStepSolver, the terms are selected with
+    TimeDependentOperator::SetEvalMode(): f1 is evaluated by Mult() in mode
+    ADDITIVE_TERM_1, while f2 is evaluated by Mult() and the implicit stages
+    are computed by ImplicitSolve() in mode ADDITIVE_TERM_2, i.e.
+    ImplicitSolve(dt, x, k) solves k = f2(x + dt k, t). The evaluation mode is
+    reset to NORMAL at the end of each step.
+
+    The two s-stage tableaus share the weights b and the abscissae c. The
+    strictly lower triangular parts ae (explicit) and ai (implicit) are given
+    row-wise as in ExplicitRKSolver; the diagonal of the implicit tableau is
+    gamma, except for its first row which is zero. */
+class IMEXRKSolver : public ODESolver
+{
+private:
+   int s;
+   double gamma;
+   const double *ae, *ai, *b, *c;
+   Vector y, *ke, *ki;
+
+public:
+   IMEXRKSolver(int _s, const double *_ae, const double *_ai, double _gamma,
+                const double *_b, const double *_c);
+
+   virtual void Init(TimeDependentOperator &_f);
+
+   virtual void Step(Vector &x, double &t, double &dt);
+
+   virtual ~IMEXRKSolver();
+};
+
+
+/** The 3-stage, 2nd order IMEX method ARK2 of Giraldo, Kelly and
+    Constantinescu (2013). The implicit part is L-stable. */
+class ARK2Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[3], ai[3], b[3], c[2];
+
+public:
+   ARK2Solver()
+      : IMEXRKSolver(3, ae, ai, .2928932188134524755991556378951509607152,
+                     b, c) { }
+};
+
+
+/** The 4-stage, 3rd order IMEX method ARK3(2)4L[2]SA of Kennedy and Carpenter
+    (2003). The implicit part is L-stable and stiffly accurate. */
+class ARK3Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[6], ai[6], b[4], c[3];
+
+public:
+   ARK3Solver()
+      : IMEXRKSolver(4, ae, ai, 1767732205903./4055673282236., b, c) { }
+};
+
+
+/** The 6-stage, 4th order IMEX method ARK4(3)6L[2]SA of Kennedy and Carpenter
+    (2003). The implicit part is L-stable and stiffly accurate. */
+class ARK4Solver : public IMEXRKSolver
+{
+private:
+   static const double ae[15], ai[15], b[6], c[5];
+
+public:
+   ARK4Solver() : IMEXRKSolver(6, ae, ai, 1./4., b, c) { }
+};
+
+
 /// Generalized-alpha ODE solver from "A generalized-α method for integrating
 /// the filtered Navier–Stokes equations with a stabilized finite element
 /// method" by K.E. Jansen, C.H. Whiting and G.M. Hulbert.
@@ -20,6 +20,26 @@
 namespace mfem
 {
 
+void Operator::ArrayMult(const Array<const Vector *> &X,
+                         Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "incompatible sizes");
+   for (int i = 0; i < X.Size(); i++)
+   {
+      Mult(*X[i], *Y[i]);
+   }
+}
+
+void Operator::ArrayMultTranspose(const Array<const Vector *> &X,
+                                  Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "incompatible sizes");
+   for (int i = 0; i < X.Size(); i++)
+   {
+      MultTranspose(*X[i], *Y[i]);
+   }
+}
+
 void Operator::InitTVectors(const Operator *Po, const Operator *Ri,
                             const Operator *Pi,
                             Vector &x, Vector &b,
@@ -444,6 +464,57 @@ void ConstrainedOperator::EliminateRHS(const Vector &x, Vector &b) const
    });
 }
 
+void ConstrainedOperator::ArrayMult(const Array<const Vector *> &X,
+                                    Array<Vector *> &Y) const
+{
+   const int csz = constraint_list.Size();
+   if (csz == 0)
+   {
+      A->ArrayMult(X, Y);
+      return;
+   }
+
+   // the auxiliary vectors are kept for the next calls
+   const int k = X.Size();
+   const MemoryType mem_type = GetMemoryType(mem_class);
+   for (int j = z_array.Size(); j < k; j++)
+   {
+      z_array.Append(new Vector(height, mem_type));
+      z_array[j]->UseDevice(true);
+   }
+   Array<const Vector *> cZ(k);
+   auto idx = constraint_list.Read();
+   for (int j = 0; j < k; j++)
+   {
+      *z_array[j] = *X[j];
+      cZ[j] = z_array[j];
+      auto d_z = z_array[j]->ReadWrite();
+      MFEM_FORALL(i, csz, d_z[idx[i]] = 0.0;);
+   }
+
+   A->ArrayMult(cZ, Y);
+
+   for (int j = 0; j < k; j++)
+   {
+      auto d_x = X[j]->Read();
+      auto d_y = Y[j]->ReadWrite();
+      MFEM_FORALL(i, csz,
+      {
+         const int id = idx[i];
+         d_y[id] = d_x[id];
+      });
+   }
+}
+
+ConstrainedOperator::~ConstrainedOperator()
+{
+   for (int j = 0; j < z_array.Size(); j++)
+   {
+      delete z_array[j];
+   }
+   if (own_A) { delete A; }
+}
+
 void ConstrainedOperator::Mult(const Vector &x, Vector &y) const
 {
    const int csz = constraint_list.Size();
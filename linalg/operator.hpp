@@ -84,6 +84,20 @@ public:
    virtual void MultTranspose(const Vector &x, Vector &y) const
    { mfem_error("Operator::MultTranspose() is not overloaded!"); }
 
+   /** @brief Operator application to a set of vectors: `Y[i]=A(X[i])`.
+
+       Derived classes can override this method to read the operator data
+       once for all vectors, see e.g. SparseMatrix::ArrayMult(). The default
+       implementation calls Mult() for each vector. */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
+   /** @brief Transpose operator application to a set of vectors:
+       `Y[i]=A^t(X[i])`. The default implementation calls MultTranspose() for
+       each vector. */
+   virtual void ArrayMultTranspose(const Array<const Vector *> &X,
+                                   Array<Vector *> &Y) const;
+
    /** @brief Evaluate the gradient operator at the point @a x. The default
        behavior in class Operator is to generate an error. */
    virtual Operator &GetGradient(const Vector &x) const
@@ -670,6 +684,7 @@ protected:
    Operator *A;                 ///< The unconstrained Operator.
    bool own_A;                  ///< Ownership flag for A.
    mutable Vector z, w;         ///< Auxiliary vectors.
+   mutable Array<Vector *> z_array; ///< Auxiliary vectors for ArrayMult().
    MemoryClass mem_class;
 
 public:
@@ -706,8 +721,14 @@ public:
        the vectors, and "_i" -- the rest of the entries. */
    virtual void Mult(const Vector &x, Vector &y) const;
 
-   /// Destructor: destroys the unconstrained Operator, if owned.
-   virtual ~ConstrainedOperator() { if (own_A) { delete A; } }
+   /** @brief Constrained operator action on a set of vectors, using
+       ArrayMult() of the unconstrained Operator. */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
+   /** @brief Destructor: destroys the unconstrained Operator, if owned, and
+       the auxiliary vectors. */
+   virtual ~ConstrainedOperator();
 };
 
 /** @brief Rectangular Operator for imposing essential boundary conditions on
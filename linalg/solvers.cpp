@@ -18,6 +18,7 @@
 #include <algorithm>
 #include <cmath>
 #include <set>
+#include <vector>
 
 namespace mfem
 {
@@ -32,6 +33,8 @@ IterativeSolver::IterativeSolver()
    max_iter = 10;
    print_level = -1;
    rel_tol = abs_tol = 0.0;
+   profiling = false;
+   monitor = NULL;
 #ifdef MFEM_USE_MPI
    dot_prod_type = 0;
 #endif
@@ -46,25 +49,182 @@ IterativeSolver::IterativeSolver(MPI_Comm _comm)
    max_iter = 10;
    print_level = -1;
    rel_tol = abs_tol = 0.0;
+   profiling = false;
+   monitor = NULL;
    dot_prod_type = 1;
    comm = _comm;
 }
 #endif
 
+void IterativeSolver::OperMult(const Vector &x, Vector &y) const
+{
+   if (!profiling) { oper->Mult(x, y); return; }
+   oper_sw.Start();
+   oper->Mult(x, y);
+   oper_sw.Stop();
+   cur_stats.oper_calls++;
+}
+
+void IterativeSolver::PrecMult(const Vector &x, Vector &y) const
+{
+   if (!profiling) { prec->Mult(x, y); return; }
+   prec_sw.Start();
+   prec->Mult(x, y);
+   prec_sw.Stop();
+   cur_stats.prec_calls++;
+}
+
+void IterativeSolver::ResetProfile() const
+{
+   if (!profiling) { return; }
+   iter_stats.SetSize(0);
+   cur_stats.oper_calls = cur_stats.prec_calls = cur_stats.dot_calls = 0;
+   oper_sw.Clear();
+   prec_sw.Clear();
+   dot_sw.Clear();
+   iter_sw.Clear();
+   iter_sw.Start();
+}
+
+void IterativeSolver::RecordIteration(int it, double norm) const
+{
+   iter_sw.Stop();
+   cur_stats.iteration = it;
+   cur_stats.norm = norm;
+   cur_stats.oper_time = oper_sw.RealTime();
+   cur_stats.prec_time = prec_sw.RealTime();
+   cur_stats.dot_time = dot_sw.RealTime();
+   cur_stats.update_time = std::max(iter_sw.RealTime() - cur_stats.oper_time -
+                                    cur_stats.prec_time - cur_stats.dot_time,
+                                    0.0);
+   iter_stats.Append(cur_stats);
+   if (monitor) { monitor->MonitorIteration(cur_stats); }
+
+   cur_stats.oper_calls = cur_stats.prec_calls = cur_stats.dot_calls = 0;
+   oper_sw.Clear();
+   prec_sw.Clear();
+   dot_sw.Clear();
+   iter_sw.Clear();
+   iter_sw.Start();
+}
+
 double IterativeSolver::Dot(const Vector &x, const Vector &y) const
 {
+   if (profiling) { dot_sw.Start(); cur_stats.dot_calls++; }
 #ifndef MFEM_USE_MPI
-   return (x * y);
+   const double d = x * y;
 #else
-   if (dot_prod_type == 0)
+   const double d = (dot_prod_type == 0) ? x * y : InnerProduct(comm, x, y);
+#endif
+   if (profiling) { dot_sw.Stop(); }
+   return d;
+}
+
+void IterativeSolver::BlockDot(const DenseMatrix &V, const DenseMatrix &W,
+                               DenseMatrix &G) const
+{
+   if (profiling) { dot_sw.Start(); cur_stats.dot_calls++; }
+   G.SetSize(V.Width(), W.Width());
+   MultAtB(V, W, G);
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type == 1)
    {
-      return (x * y);
+      MPI_Allreduce(MPI_IN_PLACE, G.Data(), G.Height()*G.Width(), MPI_DOUBLE,
+                    MPI_SUM, comm);
    }
-   else
+#endif
+   if (profiling) { dot_sw.Stop(); }
+}
+
+void IterativeSolver::BlockDot(const DenseMatrix &V, const Vector &w,
+                               Vector &c) const
+{
+   if (profiling) { dot_sw.Start(); cur_stats.dot_calls++; }
+   const Vector Vdata(V.Data(), V.Height()*V.Width());
+   c.SetSize(V.Width());
+#ifndef MFEM_USE_MPI
+   MultiDot(w, Vdata, c);
+#else
+   if (dot_prod_type == 0) { MultiDot(w, Vdata, c); }
+   else { MultiDot(comm, w, Vdata, c); }
+#endif
+   if (profiling) { dot_sw.Stop(); }
+}
+
+void IterativeSolver::ColumnDot(const DenseMatrix &V, const DenseMatrix &W,
+                                Vector &d) const
+{
+   MFEM_ASSERT(V.Height() == W.Height() && V.Width() == W.Width(),
+               "incompatible dimensions");
+   if (profiling) { dot_sw.Start(); cur_stats.dot_calls++; }
+   const int n = V.Height();
+   d.SetSize(V.Width());
+   for (int j = 0; j < V.Width(); j++)
+   {
+      const double *v = V.GetColumn(j), *w = W.GetColumn(j);
+      double s = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         s += v[i]*w[i];
+      }
+      d(j) = s;
+   }
+#ifdef MFEM_USE_MPI
+   if (dot_prod_type == 1)
    {
-      return InnerProduct(comm, x, y);
+      MPI_Allreduce(MPI_IN_PLACE, d.GetData(), d.Size(), MPI_DOUBLE, MPI_SUM,
+                    comm);
    }
 #endif
+   if (profiling) { dot_sw.Stop(); }
+}
+
+double IterativeSolver::GramSchmidt(int type, DenseMatrix &V, double *h) const
+{
+   const int n = V.Height(), k = V.Width()-1;
+   Vector w(V.GetColumn(k), n);
+
+   if (type == GMRESSolver::MGS)
+   {
+      for (int l = 0; l < k; l++)
+      {
+         Vector vl(V.GetColumn(l), n);
+         h[l] = Dot(w, vl);   // h[l] = w * v[l]
+         w.Add(-h[l], vl);    // w -= h[l] * v[l]
+      }
+      return Norm(w);
+   }
+
+   MFEM_VERIFY(type == GMRESSolver::CGS || type == GMRESSolver::CGS2,
+               "invalid orthogonalization type: " << type);
+   DenseMatrix Vk(V.Data(), n, k);
+   const Vector Vkdata(V.Data(), n*k);
+   Vector c, hk(h, k);
+   hk = 0.0;
+   if (type == GMRESSolver::CGS2)
+   {
+      BlockDot(Vk, w, c);                // c = Vk^t w
+      MultiAXPY(-1.0, c, Vkdata, w);     // w -= Vk c
+      hk = c;
+   }
+   // The projection coefficients and w^t w in one reduction; the norm of the
+   // projected vector then follows from the Pythagorean theorem.
+   BlockDot(V, w, c);
+   const double ww = c(k);
+   double nrm2 = ww;
+   for (int l = 0; l < k; l++)
+   {
+      hk(l) += c(l);
+      nrm2 -= c(l)*c(l);
+   }
+   c.SetSize(k);
+   MultiAXPY(-1.0, c, Vkdata, w);     // w -= Vk c
+   if (nrm2 <= 1e-6*ww)
+   {
+      // severe cancellation: compute the norm explicitly
+      return Norm(w);
+   }
+   return sqrt(nrm2);
 }
 
 void IterativeSolver::SetPrintLevel(int print_lvl)
@@ -181,16 +341,19 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
 {
    int i;
 
+   ResetProfile();
+
    // Optimized preconditioned SLI with fixed number of iterations and given
    // initial guess
    if (!rel_tol && iterative_mode && prec)
    {
       for (i = 0; i < max_iter; i++)
       {
-         oper->Mult(x, r);  // r = A x
+         OperMult(x, r);  // r = A x
          subtract(b, r, r); // r = b - A x
-         prec->Mult(r, z);  // z = B r
+         PrecMult(r, z);  // z = B r
          add(x, 1.0, z, x); // x = x + B (b - A x)
+         ProfileIteration(i+1, -1.0);
       }
       converged = 1;
       final_iter = i;
@@ -201,13 +364,14 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
    // initial guess
    if (!rel_tol && !iterative_mode && prec)
    {
-      prec->Mult(b, x);     // x = B b (initial guess 0)
+      PrecMult(b, x);     // x = B b (initial guess 0)
       for (i = 1; i < max_iter; i++)
       {
-         oper->Mult(x, r);  // r = A x
+         OperMult(x, r);  // r = A x
          subtract(b, r, r); // r = b - A x
-         prec->Mult(r, z);  // z = B r
+         PrecMult(r, z);  // z = B r
          add(x, 1.0, z, x); // x = x + B (b - A x)
+         ProfileIteration(i+1, -1.0);
       }
       converged = 1;
       final_iter = i;
@@ -220,7 +384,7 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
 
    if (iterative_mode)
    {
-      oper->Mult(x, r);
+      OperMult(x, r);
       subtract(b, r, r); // r = b - A x
    }
    else
@@ -231,7 +395,7 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
 
    if (prec)
    {
-      prec->Mult(r, z); // z = B r
+      PrecMult(r, z); // z = B r
       nom0 = nom = Dot(z, r);
    }
    else
@@ -242,6 +406,7 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
    if (print_level == 1)
       mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
                 << nom << '\n';
+   ProfileIteration(0, sqrt(nom));
 
    r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
    if (nom <= r0)
@@ -266,12 +431,12 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
          add(x, 1.0, r, x);
       }
 
-      oper->Mult(x, r);
+      OperMult(x, r);
       subtract(b, r, r); // r = b - A x
 
       if (prec)
       {
-         prec->Mult(r, z); //  z = B r
+         PrecMult(r, z); //  z = B r
          nom = Dot(z, r);
       }
       else
@@ -280,6 +445,7 @@ void SLISolver::Mult(const Vector &b, Vector &x) const
       }
 
       cf = sqrt(nom/nomold);
+      ProfileIteration(i, sqrt(nom));
       if (print_level == 1)
          mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
                    << nom << "\tConv. rate: " << cf << '\n';
@@ -360,9 +526,11 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    int i;
    double r0, den, nom, nom0, betanom, alpha, beta;
 
+   ResetProfile();
+
    if (iterative_mode)
    {
-      oper->Mult(x, r);
+      OperMult(x, r);
       subtract(b, r, r); // r = b - A x
    }
    else
@@ -373,7 +541,7 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
 
    if (prec)
    {
-      prec->Mult(r, z); // z = B r
+      PrecMult(r, z); // z = B r
       d = z;
    }
    else
@@ -382,6 +550,7 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
    }
    nom0 = nom = Dot(d, r);
    MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+   ProfileIteration(0, sqrt(nom));
 
    if (print_level == 1 || print_level == 3)
    {
@@ -398,7 +567,7 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
       return;
    }
 
-   oper->Mult(d, z);  // z = A d
+   OperMult(d, z);  // z = A d
    den = Dot(z, d);
    MFEM_ASSERT(IsFinite(den), "den = " << den);
    if (den <= 0.0)
@@ -428,7 +597,7 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
 
       if (prec)
       {
-         prec->Mult(r, z);      //  z = B r
+         PrecMult(r, z);      //  z = B r
          betanom = Dot(r, z);
       }
       else
@@ -436,6 +605,7 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
          betanom = Dot(r, r);
       }
       MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+      ProfileIteration(i, sqrt(betanom));
 
       if (print_level == 1)
       {
@@ -473,7 +643,7 @@ void CGSolver::Mult(const Vector &b, Vector &x) const
       {
          add(r, beta, d, d);
       }
-      oper->Mult(d, z);       //  z = A d
+      OperMult(d, z);       //  z = A d
       den = Dot(d, z);
       MFEM_ASSERT(IsFinite(den), "den = " << den);
       if (den <= 0.0)
@@ -591,6 +761,141 @@ inline void Update(Vector &x, int k, DenseMatrix &h, Vector &s,
    }
 }
 
+// Given the s x s symmetric positive definite matrix G, compute the upper
+// triangular R such that G = R^t R. The factorization is computed for the
+// matrix scaled to unit diagonal; returns false if it is numerically
+// singular.
+static bool CholeskyFactorR(const DenseMatrix &G, DenseMatrix &R)
+{
+   const int s = G.Height();
+   Vector d(s);
+   for (int j = 0; j < s; j++)
+   {
+      if (!(G(j,j) > 0.0)) { return false; }
+      d(j) = sqrt(G(j,j));
+   }
+   R.SetSize(s);
+   R = 0.0;
+   for (int j = 0; j < s; j++)
+   {
+      for (int i = 0; i <= j; i++)
+      {
+         double g = G(i,j)/(d(i)*d(j));
+         for (int k = 0; k < i; k++) { g -= R(k,i)*R(k,j); }
+         if (i < j) { R(i,j) = g/R(i,i); continue; }
+         if (g <= 1e-14) { return false; }
+         R(j,j) = sqrt(g);
+      }
+   }
+   for (int j = 0; j < s; j++)
+   {
+      for (int i = 0; i <= j; i++) { R(i,j) *= d(j); }
+   }
+   return true;
+}
+
+// Compute Z = Z R^{-1} where R is upper triangular.
+static void RightSolveUpper(DenseMatrix &Z, const DenseMatrix &R)
+{
+   const int n = Z.Height();
+   for (int c = 0; c < Z.Width(); c++)
+   {
+      double *zc = Z.GetColumn(c);
+      for (int l = 0; l < c; l++)
+      {
+         const double *zl = Z.GetColumn(l), a = R(l,c);
+         for (int i = 0; i < n; i++) { zc[i] -= a*zl[i]; }
+      }
+      const double a = 1.0/R(c,c);
+      for (int i = 0; i < n; i++) { zc[i] *= a; }
+   }
+}
+
+bool GMRESSolver::SStepArnoldi(double *basis, int n, DenseMatrix &H, int i,
+                               int sb, Vector &r) const
+{
+   const int K = i+1+sb;
+
+   // monomial basis: column i+k = (M A)^k v[i], k = 1,...,sb
+   for (int k = i; k < i+sb; k++)
+   {
+      Vector zk(basis + k*n, n), zn(basis + (k+1)*n, n);
+      if (prec)
+      {
+         OperMult(zk, r);
+         PrecMult(r, zn);
+      }
+      else
+      {
+         OperMult(zk, zn);
+      }
+   }
+
+   DenseMatrix V(basis, n, i+1), Z(basis + (i+1)*n, n, sb), W(basis, n, K);
+   DenseMatrix C, C2, F, G, R, R2, T;
+
+   // Block classical Gram-Schmidt applied twice, with the second projection
+   // fused with the Gram matrix of the block: Z = V C + Z, V^t Z = 0
+   BlockDot(V, Z, C);                  // C = V^t Z
+   AddMult_a(-1.0, V, C, Z);           // Z -= V C
+   BlockDot(W, Z, F);                  // F = [V Z]^t Z
+   C2.CopyMN(F, i+1, sb, 0, 0);
+   G.CopyMN(F, sb, sb, i+1, 0);
+   AddMult_a(-1.0, V, C2, Z);          // Z -= V C2
+   C += C2;
+   T.SetSize(sb);
+   MultAtB(C2, C2, T);
+   G -= T;                             // G = Z^t Z
+
+   // Cholesky QR applied twice: Z = Q R, Q^t Q = I
+   if (!CholeskyFactorR(G, R)) { return false; }
+   RightSolveUpper(Z, R);
+   BlockDot(Z, Z, G);
+   if (!CholeskyFactorR(G, R2)) { return false; }
+   RightSolveUpper(Z, R2);
+   mfem::Mult(R2, R, T);
+   R = T;
+
+   // The generated vectors in the orthonormal basis: [v[i] Z_0] = W T
+   T.SetSize(K, sb+1);
+   T = 0.0;
+   T(i,0) = 1.0;
+   for (int c = 0; c < sb; c++)
+   {
+      for (int l = 0; l <= i; l++) { T(l,c+1) = C(l,c); }
+      for (int l = 0; l <= c; l++) { T(i+1+l,c+1) = R(l,c); }
+   }
+
+   // From M A W T(:,0:sb-1) = W T(:,1:sb) and the Arnoldi relation for the
+   // previous columns, the new columns Hn of the Hessenberg matrix satisfy
+   // Hn T(i:i+sb-1,0:sb-1) = T(:,1:sb) - H(:,0:i-1) T(0:i-1,0:sb-1).
+   DenseMatrix Hn(K, sb);
+   for (int c = 0; c < sb; c++)
+   {
+      for (int l = 0; l < K; l++)
+      {
+         double h = T(l,c+1);
+         for (int p = std::max(l-1, 0); p < i; p++) { h -= H(l,p)*T(p,c); }
+         Hn(l,c) = h;
+      }
+   }
+   for (int c = 0; c < sb; c++)
+   {
+      for (int q = 0; q < c; q++)
+      {
+         const double a = T(i+q,c);
+         for (int l = 0; l < K; l++) { Hn(l,c) -= a*Hn(l,q); }
+      }
+      const double a = 1.0/T(i+c,c);
+      for (int l = 0; l < K; l++)
+      {
+         Hn(l,c) *= a;
+         H(l,i+c) = (l <= i+c+1) ? Hn(l,c) : 0.0;
+      }
+   }
+   return true;
+}
+
 void GMRESSolver::Mult(const Vector &b, Vector &x) const
 {
    // Generalized Minimum Residual method following the algorithm
@@ -598,17 +903,19 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
 
    int n = width;
 
-   DenseMatrix H(m+1, m);
+   DenseMatrix H(m+1, m), Hs;
    Vector s(m+1), cs(m+1), sn(m+1);
-   Vector r(n), w(n);
+   Vector r(n), w(n), basis;
    Array<Vector *> v;
 
    double resid;
    int i, j, k;
 
+   ResetProfile();
+
    if (iterative_mode)
    {
-      oper->Mult(x, r);
+      OperMult(x, r);
    }
    else
    {
@@ -620,11 +927,11 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
       if (iterative_mode)
       {
          subtract(b, r, w);
-         prec->Mult(w, r);    // r = M (b - A x)
+         PrecMult(w, r);    // r = M (b - A x)
       }
       else
       {
-         prec->Mult(b, r);
+         PrecMult(b, r);
       }
    }
    else
@@ -640,6 +947,7 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
    }
    double beta = Norm(r);  // beta = ||r||
    MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+   ProfileIteration(0, beta);
 
    final_norm = std::max(rel_tol*beta, abs_tol);
 
@@ -658,63 +966,90 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
                 << "  ||B r|| = " << beta << (print_level == 3 ? " ...\n" : "\n");
    }
 
-   v.SetSize(m+1, NULL);
+   // The Krylov basis is stored contiguously, as the columns of an n x (m+1)
+   // matrix, so that it can be orthogonalized with block operations.
+   basis.SetSize(n*(m+1));
+   v.SetSize(m+1);
+   for (k = 0; k <= m; k++)
+   {
+      v[k] = new Vector;
+      v[k]->MakeRef(basis, k*n, n);
+   }
+   if (s_step > 1) { Hs.SetSize(m+1, m); Hs = 0.0; }
 
    for (j = 1; j <= max_iter; )
    {
-      if (v[0] == NULL) { v[0] = new Vector(n); }
       v[0]->Set(1.0/beta, r);
       s = 0.0; s(0) = beta;
 
-      for (i = 0; i < m && j <= max_iter; i++, j++)
+      for (i = 0; i < m && j <= max_iter; )
       {
-         if (prec)
-         {
-            oper->Mult(*v[i], r);
-            prec->Mult(r, w);        // w = M A v[i]
-         }
-         else
+         int nb = std::min(std::min(s_step, m-i), max_iter-j+1);
+         if (nb > 1 && !SStepArnoldi(basis.GetData(), n, Hs, i, nb, r))
          {
-            oper->Mult(*v[i], w);
+            nb = 1;
          }
 
-         for (k = 0; k <= i; k++)
+         if (nb == 1)
          {
-            H(k,i) = Dot(w, *v[k]);  // H(k,i) = w * v[k]
-            w.Add(-H(k,i), *v[k]);   // w -= H(k,i) * v[k]
-         }
+            if (prec)
+            {
+               OperMult(*v[i], r);
+               PrecMult(r, *v[i+1]);  // v[i+1] = M A v[i]
+            }
+            else
+            {
+               OperMult(*v[i], *v[i+1]);
+            }
 
-         H(i+1,i) = Norm(w);           // H(i+1,i) = ||w||
-         MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
-         if (v[i+1] == NULL) { v[i+1] = new Vector(n); }
-         v[i+1]->Set(1.0/H(i+1,i), w); // v[i+1] = w / H(i+1,i)
+            DenseMatrix V(basis.GetData(), n, i+2);
+            H(i+1,i) = GramSchmidt(ortho, V, H.GetColumn(i));
+            MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
+            (*v[i+1]) *= 1.0/H(i+1,i); // v[i+1] = w / H(i+1,i)
 
-         for (k = 0; k < i; k++)
+            if (s_step > 1)
+            {
+               for (k = 0; k <= i+1; k++) { Hs(k,i) = H(k,i); }
+            }
+         }
+         else
          {
-            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
+            for (int c = i; c < i+nb; c++)
+            {
+               for (k = 0; k <= c+1; k++) { H(k,c) = Hs(k,c); }
+            }
          }
 
-         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+         for (int c = 0; c < nb; c++, i++, j++)
+         {
+            for (k = 0; k < i; k++)
+            {
+               ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
+            }
 
-         resid = fabs(s(i+1));
-         MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+            GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+            ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+            ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
 
-         if (resid <= final_norm)
-         {
-            Update(x, i, H, s, v);
-            final_norm = resid;
-            final_iter = j;
-            converged = 1;
-            goto finish;
-         }
+            resid = fabs(s(i+1));
+            MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+            ProfileIteration(j, resid);
 
-         if (print_level == 1)
-         {
-            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
-                      << "   Iteration : " << setw(3) << j
-                      << "  ||B r|| = " << resid << '\n';
+            if (resid <= final_norm)
+            {
+               Update(x, i, H, s, v);
+               final_norm = resid;
+               final_iter = j;
+               converged = 1;
+               goto finish;
+            }
+
+            if (print_level == 1)
+            {
+               mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                         << "   Iteration : " << setw(3) << j
+                         << "  ||B r|| = " << resid << '\n';
+            }
          }
       }
 
@@ -725,11 +1060,11 @@ void GMRESSolver::Mult(const Vector &b, Vector &x) const
 
       Update(x, i-1, H, s, v);
 
-      oper->Mult(x, r);
+      OperMult(x, r);
       if (prec)
       {
          subtract(b, r, w);
-         prec->Mult(w, r);    // r = M (b - A x)
+         PrecMult(w, r);    // r = M (b - A x)
       }
       else
       {
@@ -771,195 +1106,1556 @@ finish:
    }
 }
 
-void FGMRESSolver::Mult(const Vector &b, Vector &x) const
+void FGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   DenseMatrix H(m+1,m);
+   Vector s(m+1), cs(m+1), sn(m+1);
+   Vector r(b.Size());
+
+   int i, j, k;
+
+   ResetProfile();
+
+   if (iterative_mode)
+   {
+      OperMult(x, r);
+      subtract(b,r,r);
+   }
+   else
+   {
+      x = 0.;
+      r = b;
+   }
+   double beta = Norm(r);  // beta = ||r||
+   MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+   ProfileIteration(0, beta);
+
+   final_norm = std::max(rel_tol*beta, abs_tol);
+
+   if (beta <= final_norm)
+   {
+      final_norm = beta;
+      final_iter = 0;
+      converged = 1;
+      return;
+   }
+
+   if (print_level == 1)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  || r || = " << beta << endl;
+   }
+
+   // the basis v is stored contiguously, see GMRESSolver::Mult()
+   const int n = b.Size();
+   Vector basis(n*(m+1));
+   Array<Vector*> v(m+1);
+   Array<Vector*> z(m+1);
+   for (i= 0; i<=m; i++)
+   {
+      v[i] = new Vector;
+      v[i]->MakeRef(basis, i*n, n);
+      z[i] = NULL;
+   }
+
+   j = 1;
+   while (j <= max_iter)
+   {
+      (*v[0]) = 0.0;
+      v[0] -> Add (1.0/beta, r);   // v[0] = r / ||r||
+      s = 0.0; s(0) = beta;
+
+      for (i = 0; i < m && j <= max_iter; i++, j++)
+      {
+
+         if (z[i] == NULL) { z[i] = new Vector(b.Size()); }
+         (*z[i]) = 0.0;
+
+         if (prec)
+         {
+            PrecMult(*v[i], *z[i]);
+         }
+         else
+         {
+            (*z[i]) = (*v[i]);
+         }
+         OperMult(*z[i], *v[i+1]);
+
+         DenseMatrix V(basis.GetData(), n, i+2);
+         H(i+1,i) = GramSchmidt(ortho, V, H.GetColumn(i));
+         (*v[i+1]) *= 1.0/H(i+1,i); // v[i+1] = r / H(i+1,i)
+
+         for (k = 0; k < i; k++)
+         {
+            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
+         }
+
+         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+
+         double resid = fabs(s(i+1));
+         MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+         ProfileIteration(j, resid);
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  || r || = " << resid << endl;
+         }
+
+         if (resid <= final_norm)
+         {
+            Update(x, i, H, s, z);
+            final_norm = resid;
+            final_iter = j;
+            converged = 1;
+
+            if (print_level == 2)
+            {
+               mfem::out << "Number of FGMRES iterations: " << final_iter << endl;
+            }
+
+            for (i= 0; i<=m; i++)
+            {
+               if (v[i]) { delete v[i]; }
+               if (z[i]) { delete z[i]; }
+            }
+            return;
+         }
+      }
+
+      if (print_level == 1)
+      {
+         mfem::out << "Restarting..." << endl;
+      }
+
+      Update(x, i-1, H, s, z);
+
+      OperMult(x, r);
+      subtract(b,r,r);
+      beta = Norm(r);
+      MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+      if (beta <= final_norm)
+      {
+         final_norm = beta;
+         final_iter = j;
+         converged = 1;
+
+         if (print_level == 2)
+         {
+            mfem::out << "Number of FGMRES iterations: " << final_iter << endl;
+         }
+
+         for (i= 0; i<=m; i++)
+         {
+            if (v[i]) { delete v[i]; }
+            if (z[i]) { delete z[i]; }
+         }
+         return;
+      }
+   }
+
+   for (i = 0; i <= m; i++)
+   {
+      if (v[i]) { delete v[i]; }
+      if (z[i]) { delete z[i]; }
+   }
+   converged = 0;
+
+   if (print_level >= 0)
+   {
+      mfem::out << "FGMRES: No convergence!" << endl;
+   }
+
+   return;
+}
+
+
+int GMRES(const Operator &A, Vector &x, const Vector &b, Solver &M,
+          int &max_iter, int m, double &tol, double atol, int printit)
+{
+   GMRESSolver gmres;
+   gmres.SetPrintLevel(printit);
+   gmres.SetMaxIter(max_iter);
+   gmres.SetKDim(m);
+   gmres.SetRelTol(sqrt(tol));
+   gmres.SetAbsTol(sqrt(atol));
+   gmres.SetOperator(A);
+   gmres.SetPreconditioner(M);
+   gmres.Mult(b, x);
+   max_iter = gmres.GetNumIterations();
+   tol = gmres.GetFinalNorm()*gmres.GetFinalNorm();
+   return gmres.GetConverged();
+}
+
+void GMRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
+           int print_iter, int max_num_iter, int m, double rtol, double atol)
+{
+   GMRES(A, x, b, B, max_num_iter, m, rtol, atol, print_iter);
+}
+
+// Apply the operator to the columns of X, Y(:,j) = op(X(:,j)), with a single
+// call to Operator::ArrayMult().
+static void ColumnsMult(const Operator &op, const DenseMatrix &X,
+                        DenseMatrix &Y)
+{
+   const int k = X.Width();
+   std::vector<Vector> xv(k), yv(k);
+   Array<const Vector *> xp(k);
+   Array<Vector *> yp(k);
+   for (int j = 0; j < k; j++)
+   {
+      xv[j].SetDataAndSize(const_cast<double*>(X.GetColumn(j)), X.Height());
+      yv[j].SetDataAndSize(Y.GetColumn(j), Y.Height());
+      xp[j] = &xv[j];
+      yp[j] = &yv[j];
+   }
+   op.ArrayMult(xp, yp);
+}
+
+void IterativeSolver::OperMult(const DenseMatrix &X, DenseMatrix &Y) const
+{
+   if (!profiling) { ColumnsMult(*oper, X, Y); return; }
+   oper_sw.Start();
+   ColumnsMult(*oper, X, Y);
+   oper_sw.Stop();
+   cur_stats.oper_calls += X.Width();
+}
+
+void IterativeSolver::PrecMult(const DenseMatrix &X, DenseMatrix &Y) const
+{
+   if (!profiling) { ColumnsMult(*prec, X, Y); return; }
+   prec_sw.Start();
+   ColumnsMult(*prec, X, Y);
+   prec_sw.Stop();
+   cur_stats.prec_calls += X.Width();
+}
+
+// Given the s x s symmetric positive semidefinite Gram matrix G of a set of
+// vectors P, compute T (s x r) such that T^t G T = I, i.e. the columns of P T
+// are orthonormal. Linearly dependent (to working precision) vectors are
+// dropped, so r <= s.
+static void GramOrthonormalize(const DenseMatrix &G, DenseMatrix &T)
+{
+   const int s = G.Height();
+   DenseMatrix Tf(s);
+   Vector t(s), Gt(s);
+   int r = 0;
+   for (int j = 0; j < s; j++)
+   {
+      if (!(G(j,j) > 0.0)) { continue; }
+      t = 0.0;
+      t(j) = 1.0;
+      // classical Gram-Schmidt in the G inner product, applied twice
+      for (int pass = 0; pass < 2; pass++)
+      {
+         G.Mult(t, Gt);
+         for (int c = 0; c < r; c++)
+         {
+            const double *tc = Tf.GetColumn(c);
+            double h = 0.0;
+            for (int i = 0; i < s; i++) { h += tc[i]*Gt(i); }
+            for (int i = 0; i < s; i++) { t(i) -= h*tc[i]; }
+         }
+      }
+      G.Mult(t, Gt);
+      const double nrm2 = t*Gt;
+      if (nrm2 <= 1e-12*G(j,j)) { continue; }
+      t /= sqrt(nrm2);
+      Tf.SetCol(r++, t);
+   }
+   T.CopyMN(Tf, s, r, 0, 0);
+}
+
+void BlockCGSolver::Mult(const DenseMatrix &B, DenseMatrix &X) const
+{
+   const int n = width, k = B.Width();
+   MFEM_VERIFY(B.Height() == height, "invalid size of the right-hand sides");
+
+   DenseMatrix R(n, k), Z(n, k), P, Q, G, T, C, Pn;
+   Vector nom, r0(k);
+   int i;
+
+   ResetProfile();
+
+   if (iterative_mode)
+   {
+      MFEM_VERIFY(X.Height() == n && X.Width() == k,
+                  "invalid size of the initial guess");
+      OperMult(X, R);
+      R.Neg();
+      R += B;                          // R = B - A X
+   }
+   else
+   {
+      X.SetSize(n, k);
+      X = 0.0;
+      R = B;
+   }
+
+   if (prec) { PrecMult(R, Z); }   // Z = M R
+   else { Z = R; }
+   ColumnDot(Z, R, nom);
+   MFEM_ASSERT(IsFinite(nom.Normlinf()), "nom = " << nom.Normlinf());
+   ProfileIteration(0, sqrt(nom.Max()));
+
+   bool done = true;
+   for (int j = 0; j < k; j++)
+   {
+      r0(j) = std::max(nom(j)*rel_tol*rel_tol, abs_tol*abs_tol);
+      done = done && (nom(j) <= r0(j));
+   }
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  max (B r, r) = "
+                << nom.Max() << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   if (done)
+   {
+      converged = 1;
+      final_iter = 0;
+      final_norm = sqrt(nom.Max());
+      return;
+   }
+
+   // A-orthonormalize the initial search directions P = Z
+   P = Z;
+   Q.SetSize(n, k);
+   OperMult(P, Q);
+   BlockDot(P, Q, G);
+   GramOrthonormalize(G, T);
+   Pn.SetSize(n, T.Width());
+   mfem::Mult(P, T, Pn);
+   P = Pn;
+   mfem::Mult(Q, T, Pn);
+   Q = Pn;
+
+   converged = 0;
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      if (P.Width() == 0)
+      {
+         if (print_level >= 0)
+         {
+            mfem::out << "Block PCG: No linearly independent search directions"
+                      " left.\n";
+         }
+         final_iter = i-1;
+         break;
+      }
+
+      BlockDot(P, R, C);               // C = P^t R
+      AddMult(P, C, X);                // X = X + P C
+      AddMult_a(-1.0, Q, C, R);        // R = R - A P C
+
+      if (prec) { PrecMult(R, Z); }
+      else { Z = R; }
+      ColumnDot(Z, R, nom);
+      MFEM_ASSERT(IsFinite(nom.Normlinf()), "nom = " << nom.Normlinf());
+      ProfileIteration(i, sqrt(nom.Max()));
+
+      done = true;
+      for (int j = 0; j < k; j++)
+      {
+         done = done && (nom(j) < r0(j));
+      }
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  max (B r, r) = "
+                   << nom.Max() << '\n';
+      }
+
+      if (done)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of Block PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i
+                      << "  max (B r, r) = " << nom.Max() << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      // P = Z - P (Q^t Z): new directions, A-orthogonal to the previous ones
+      BlockDot(Q, Z, C);
+      Pn = Z;
+      AddMult_a(-1.0, P, C, Pn);
+      Q.SetSize(n, Pn.Width());
+      OperMult(Pn, Q);
+      BlockDot(Pn, Q, G);
+      GramOrthonormalize(G, T);
+      P.SetSize(n, T.Width());
+      mfem::Mult(Pn, T, P);
+      Pn = Q;
+      Q.SetSize(n, T.Width());
+      mfem::Mult(Pn, T, Q);
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "Block PCG: No convergence!" << '\n';
+   }
+   final_norm = sqrt(nom.Max());
+}
+
+void BlockCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   DenseMatrix B(const_cast<double*>(b.HostRead()), b.Size(), 1);
+   DenseMatrix X(x.HostReadWrite(), x.Size(), 1);
+   Mult(B, X);
+}
+
+
+void BlockGMRESSolver::Orthonormalize(DenseMatrix &W, DenseMatrix &R,
+                                      Array<DenseMatrix *> &v, int nv) const
+{
+   const int k = W.Width();
+   Vector wj, wq;
+
+   R.SetSize(k);
+   R = 0.0;
+   for (int j = 0; j < k; j++)
+   {
+      W.GetColumnReference(j, wj);
+      const double nrm0 = Norm(wj);
+      for (int q = 0; q < j; q++)
+      {
+         W.GetColumnReference(q, wq);
+         R(q,j) = Dot(wq, wj);
+         wj.Add(-R(q,j), wq);
+      }
+      double nrm = Norm(wj);
+      MFEM_ASSERT(IsFinite(nrm), "Norm(w) = " << nrm);
+      if (nrm <= 1e-12*nrm0 || nrm == 0.0)
+      {
+         // The column is (nearly) linearly dependent on the previous ones:
+         // continue with a random vector orthogonal to the current basis.
+         wj.Randomize(j+1);
+         for (int pass = 0; pass < 2; pass++)
+         {
+            for (int l = 0; l <= nv; l++)
+            {
+               DenseMatrix &V = (l < nv) ? *v[l] : W;
+               for (int q = 0; q < ((l < nv) ? k : j); q++)
+               {
+                  V.GetColumnReference(q, wq);
+                  wj.Add(-Dot(wq, wj), wq);
+               }
+            }
+         }
+         nrm = Norm(wj);
+         R(j,j) = 0.0;
+      }
+      else
+      {
+         R(j,j) = nrm;
+      }
+      wj /= nrm;
+   }
+}
+
+// Solve the (rotated) upper triangular least squares problem H Y = S for the
+// first (i+1) blocks and update X += [v_0 ... v_i] Y.
+static void BlockUpdate(DenseMatrix &X, int i, const DenseMatrix &H,
+                        const DenseMatrix &S, Array<DenseMatrix *> &v)
+{
+   const int k = X.Width(), nc = (i+1)*k;
+   DenseMatrix Y, Yl;
+
+   Y.CopyMN(S, nc, k, 0, 0);
+   for (int p = 0; p < k; p++)
+   {
+      for (int r = nc-1; r >= 0; r--)
+      {
+         Y(r,p) = (H(r,r) != 0.0) ? Y(r,p)/H(r,r) : 0.0;
+         for (int q = r-1; q >= 0; q--)
+         {
+            Y(q,p) -= H(q,r)*Y(r,p);
+         }
+      }
+   }
+   for (int l = 0; l <= i; l++)
+   {
+      Yl.CopyMN(Y, k, k, l*k, 0);
+      AddMult(*v[l], Yl, X);
+   }
+}
+
+void BlockGMRESSolver::Mult(const DenseMatrix &B, DenseMatrix &X) const
+{
+   // Block GMRES with block modified Gram-Schmidt Arnoldi; the banded
+   // Hessenberg matrix is reduced to triangular form with k Givens rotations
+   // per column.
+
+   const int n = width, k = B.Width(), mk = m*k;
+   MFEM_VERIFY(B.Height() == height, "invalid size of the right-hand sides");
+
+   DenseMatrix H((m+1)*k, mk), S((m+1)*k, k), Rb, C;
+   DenseMatrix cs(mk, k), sn(mk, k);
+   DenseMatrix R(n, k), W(n, k);
+   Array<DenseMatrix *> v;
+   Vector tol(k), resid;
+   double max_resid;
+   bool done;
+   int i, j;
+
+   ResetProfile();
+
+   if (iterative_mode)
+   {
+      MFEM_VERIFY(X.Height() == n && X.Width() == k,
+                  "invalid size of the initial guess");
+      OperMult(X, W);
+      W.Neg();
+      W += B;                          // W = B - A X
+      if (prec) { PrecMult(W, R); }   // R = M (B - A X)
+      else { R = W; }
+   }
+   else
+   {
+      X.SetSize(n, k);
+      X = 0.0;
+      if (prec) { PrecMult(B, R); }
+      else { R = B; }
+   }
+
+   ColumnDot(R, R, resid);
+   done = true;
+   max_resid = 0.0;
+   for (int p = 0; p < k; p++)
+   {
+      resid(p) = sqrt(resid(p));
+      MFEM_ASSERT(IsFinite(resid(p)), "beta = " << resid(p));
+      tol(p) = std::max(rel_tol*resid(p), abs_tol);
+      done = done && (resid(p) <= tol(p));
+      max_resid = std::max(max_resid, resid(p));
+   }
+
+   ProfileIteration(0, max_resid);
+
+   if (done)
+   {
+      final_norm = max_resid;
+      final_iter = 0;
+      converged = 1;
+      goto finish;
+   }
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  max ||B r|| = " << max_resid
+                << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   v.SetSize(m+1, NULL);
+
+   for (j = 1; j <= max_iter; )
+   {
+      if (v[0] == NULL) { v[0] = new DenseMatrix(n, k); }
+      *v[0] = R;
+      Orthonormalize(*v[0], Rb, v, 0);  // R = v[0] Rb
+      H = 0.0;
+      S = 0.0;
+      S.CopyMN(Rb, 0, 0);
+
+      for (i = 0; i < m && j <= max_iter; i++, j++)
+      {
+         if (prec)
+         {
+            OperMult(*v[i], R);
+            PrecMult(R, W);   // W = M A v[i]
+         }
+         else
+         {
+            OperMult(*v[i], W);
+         }
+
+         for (int l = 0; l <= i; l++)
+         {
+            BlockDot(*v[l], W, C);      // C = v[l]^t W
+            AddMult_a(-1.0, *v[l], C, W);
+            H.CopyMN(C, l*k, i*k);
+         }
+
+         if (v[i+1] == NULL) { v[i+1] = new DenseMatrix(n, k); }
+         *v[i+1] = W;
+         Orthonormalize(*v[i+1], Rb, v, i+1);
+         H.CopyMN(Rb, (i+1)*k, i*k);
+
+         for (int q = 0; q < k; q++)
+         {
+            const int c = i*k + q;
+            for (int cp = 0; cp < c; cp++)
+            {
+               for (int t = 0; t < k; t++)
+               {
+                  const int r = cp + k - t;
+                  ApplyPlaneRotation(H(r-1,c), H(r,c), cs(cp,t), sn(cp,t));
+               }
+            }
+            // eliminate the k subdiagonal entries of column c, bottom-up
+            for (int t = 0; t < k; t++)
+            {
+               const int r = c + k - t;
+               GeneratePlaneRotation(H(r-1,c), H(r,c), cs(c,t), sn(c,t));
+               ApplyPlaneRotation(H(r-1,c), H(r,c), cs(c,t), sn(c,t));
+               for (int p = 0; p < k; p++)
+               {
+                  ApplyPlaneRotation(S(r-1,p), S(r,p), cs(c,t), sn(c,t));
+               }
+            }
+         }
+
+         done = true;
+         max_resid = 0.0;
+         for (int p = 0; p < k; p++)
+         {
+            double r2 = 0.0;
+            for (int q = 0; q < k; q++)
+            {
+               r2 += S((i+1)*k+q,p)*S((i+1)*k+q,p);
+            }
+            resid(p) = sqrt(r2);
+            MFEM_ASSERT(IsFinite(resid(p)), "resid = " << resid(p));
+            done = done && (resid(p) <= tol(p));
+            max_resid = std::max(max_resid, resid(p));
+         }
+
+         ProfileIteration(j, max_resid);
+
+         if (done)
+         {
+            BlockUpdate(X, i, H, S, v);
+            final_norm = max_resid;
+            final_iter = j;
+            converged = 1;
+            goto finish;
+         }
+
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
+                      << "   Iteration : " << setw(3) << j
+                      << "  max ||B r|| = " << max_resid << '\n';
+         }
+      }
+
+      if (print_level == 1 && j <= max_iter)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+
+      BlockUpdate(X, i-1, H, S, v);
+
+      OperMult(X, W);
+      W.Neg();
+      W += B;                          // W = B - A X
+      if (prec) { PrecMult(W, R); }   // R = M (B - A X)
+      else { R = W; }
+      ColumnDot(R, R, resid);
+      done = true;
+      max_resid = 0.0;
+      for (int p = 0; p < k; p++)
+      {
+         resid(p) = sqrt(resid(p));
+         done = done && (resid(p) <= tol(p));
+         max_resid = std::max(max_resid, resid(p));
+      }
+      if (done)
+      {
+         final_norm = max_resid;
+         final_iter = j;
+         converged = 1;
+         goto finish;
+      }
+   }
+
+   final_norm = max_resid;
+   final_iter = max_iter;
+   converged = 0;
+
+finish:
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << (final_iter-1)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  max ||B r|| = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      mfem::out << "Block GMRES: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "Block GMRES: No convergence!\n";
+   }
+   for (i = 0; i < v.Size(); i++)
+   {
+      delete v[i];
+   }
+}
+
+void BlockGMRESSolver::Mult(const Vector &b, Vector &x) const
+{
+   DenseMatrix B(const_cast<double*>(b.HostRead()), b.Size(), 1);
+   DenseMatrix X(x.HostReadWrite(), x.Size(), 1);
+   Mult(B, X);
+}
+
+// Return the matrix [A B(:,0:nb-1)].
+static void ConcatColumns(const DenseMatrix &A, const DenseMatrix &B, int nb,
+                          DenseMatrix &AB)
+{
+   const int n = std::max(A.Height(), B.Height()), na = A.Width();
+   AB.SetSize(n, na + nb);
+   for (int j = 0; j < na; j++)
+   {
+      AB.SetCol(j, A.GetColumn(j));
+   }
+   for (int j = 0; j < nb; j++)
+   {
+      AB.SetCol(na + j, B.GetColumn(j));
+   }
+}
+
+// For symmetric F and symmetric positive semidefinite G, compute the (up to)
+// k eigenvectors Y of F y = theta G y for the smallest eigenvalues theta,
+// normalized such that Y^t G Y = I. The null space of G is discarded. If
+// theta is not NULL, it is set to the corresponding eigenvalues.
+static void SmallestEigenvectors(const DenseMatrix &F, const DenseMatrix &G,
+                                 int k, DenseMatrix &Y, Vector *theta = NULL)
+{
+   DenseMatrix T, FT, Fr, Q, Qk;
+   Vector ev;
+
+   GramOrthonormalize(G, T);
+   const int r = T.Width(), kr = std::min(k, r);
+   if (kr == 0)
+   {
+      Y.SetSize(G.Height(), 0);
+      return;
+   }
+   FT.SetSize(F.Height(), r);
+   mfem::Mult(F, T, FT);
+   Fr.SetSize(r);
+   MultAtB(T, FT, Fr);
+   Fr.Symmetrize();
+   Fr.Eigensystem(ev, Q);
+   Qk.CopyMN(Q, r, kr, 0, 0);
+   Y.SetSize(G.Height(), kr);
+   mfem::Mult(T, Qk, Y);
+   if (theta)
+   {
+      theta->SetSize(kr);
+      for (int j = 0; j < kr; j++) { (*theta)(j) = ev(j); }
+   }
+}
+
+void DeflatedCGSolver::UpdateVectors()
+{
+   r.SetSize(width);
+   d.SetSize(width);
+   z.SetSize(width);
+   q.SetSize(width);
+   P.SetSize(width, max_store);
+   AP.SetSize(height, max_store);
+   BAP.SetSize(prec ? width : 0, prec ? max_store : 0);
+}
+
+void DeflatedCGSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+   UpdateVectors();
+
+   if (W.Width() == 0) { return; }
+   if (W.Height() != width)
+   {
+      ClearRecycledSpace();
+      return;
+   }
+   // A-orthonormalize W for the new operator
+   DenseMatrix G, T, Tmp;
+   AW.SetSize(height, W.Width());
+   OperMult(W, AW);
+   BlockDot(W, AW, G);
+   G.Symmetrize();
+   GramOrthonormalize(G, T);
+   Tmp = W;
+   W.SetSize(width, T.Width());
+   mfem::Mult(Tmp, T, W);
+   Tmp = AW;
+   AW.SetSize(height, T.Width());
+   mfem::Mult(Tmp, T, AW);
+   if (prec)
+   {
+      BAW.SetSize(width, AW.Width());
+      PrecMult(AW, BAW);
+   }
+}
+
+void DeflatedCGSolver::UpdateDeflationSpace(const DenseMatrix &P,
+                                            const DenseMatrix &AP,
+                                            const DenseMatrix &BAP,
+                                            int np) const
+{
+   if (k <= 0) { return; }
+
+   // harmonic Ritz pairs of B A in span{Z}: (AZ)^t BAZ y = theta Z^t A Z y
+   DenseMatrix Z, AZ, BAZ, F, G, Y;
+   ConcatColumns(W, P, np, Z);
+   ConcatColumns(AW, AP, np, AZ);
+   if (prec) { ConcatColumns(BAW, BAP, np, BAZ); }
+   BlockDot(Z, AZ, G);
+   G.Symmetrize();
+   BlockDot(AZ, prec ? BAZ : AZ, F);
+   F.Symmetrize();
+   SmallestEigenvectors(F, G, k, Y);
+
+   W.SetSize(width, Y.Width());
+   mfem::Mult(Z, Y, W);
+   AW.SetSize(height, Y.Width());
+   mfem::Mult(AZ, Y, AW);
+   if (prec)
+   {
+      BAW.SetSize(width, Y.Width());
+      mfem::Mult(BAZ, Y, BAW);
+   }
+}
+
+void DeflatedCGSolver::Mult(const Vector &b, Vector &x) const
+{
+   int i, np = 0;
+   double r0, den, nom, nom0, betanom, alpha, beta;
+   Vector c, bap;
+
+   MFEM_ASSERT(P.Width() == max_store && (!prec || BAP.Width() == max_store),
+               "the operator must be set before Mult()");
+   ResetProfile();
+
+   if (iterative_mode)
+   {
+      OperMult(x, r);
+      subtract(b, r, r); // r = b - A x
+   }
+   else
+   {
+      r = b;
+      x = 0.0;
+   }
+
+   if (prec) { PrecMult(r, z); } // z = B r
+   else { z = r; }
+   nom0 = nom = Dot(z, r);
+   MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+   r0 = std::max(nom*rel_tol*rel_tol, abs_tol*abs_tol);
+
+   if (W.Width() > 0 && nom > r0)
+   {
+      // x = x + W W^t r, r = r - A W W^t r, so that W^t r = 0
+      BlockDot(W, r, c);
+      W.AddMult(c, x);
+      AW.AddMult_a(-1.0, c, r);
+      if (prec) { PrecMult(r, z); }
+      else { z = r; }
+      nom = Dot(z, r);
+      MFEM_ASSERT(IsFinite(nom), "nom = " << nom);
+   }
+   ProfileIteration(0, sqrt(nom));
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Iteration : " << setw(3) << 0 << "  (B r, r) = "
+                << nom << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   if (nom <= r0)
+   {
+      converged = 1;
+      final_iter = 0;
+      final_norm = sqrt(nom);
+      return;
+   }
+
+   // d = z - W (A W)^t z
+   d = z;
+   if (W.Width() > 0)
+   {
+      BlockDot(AW, z, c);
+      W.AddMult_a(-1.0, c, d);
+   }
+   OperMult(d, q);  // q = A d
+   den = Dot(q, d);
+   MFEM_ASSERT(IsFinite(den), "den = " << den);
+   if (den <= 0.0)
+   {
+      if (Dot(d, d) > 0.0 && print_level >= 0)
+      {
+         mfem::out << "Deflated PCG: The operator is not positive definite. "
+                   "(Ad, d) = " << den << '\n';
+      }
+      if (den == 0.0)
+      {
+         converged = 0;
+         final_iter = 0;
+         final_norm = sqrt(nom);
+         return;
+      }
+   }
+
+   // start iteration
+   converged = 0;
+   final_iter = max_iter;
+   for (i = 1; true; )
+   {
+      const bool store = (np < max_store);
+      if (store)
+      {
+         P.SetCol(np, d);
+         AP.SetCol(np, q);
+      }
+
+      alpha = nom/den;
+      add(x,  alpha, d, x);     //  x = x + alpha d
+      add(r, -alpha, q, r);     //  r = r - alpha A d
+
+      if (prec)
+      {
+         if (store) { BAP.SetCol(np, z); }
+         PrecMult(r, z);      //  z = B r
+         if (store)
+         {
+            // B A d = (z_old - z_new)/alpha
+            BAP.GetColumnReference(np, bap);
+            bap -= z;
+            bap /= alpha;
+         }
+      }
+      else
+      {
+         z = r;
+      }
+      if (store) { np++; }
+      betanom = Dot(r, z);
+      MFEM_ASSERT(IsFinite(betanom), "betanom = " << betanom);
+      ProfileIteration(i, sqrt(betanom));
+
+      if (print_level == 1)
+      {
+         mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                   << betanom << '\n';
+      }
+
+      if (betanom < r0)
+      {
+         if (print_level == 2)
+         {
+            mfem::out << "Number of deflated PCG iterations: " << i << '\n';
+         }
+         else if (print_level == 3)
+         {
+            mfem::out << "   Iteration : " << setw(3) << i << "  (B r, r) = "
+                      << betanom << '\n';
+         }
+         converged = 1;
+         final_iter = i;
+         break;
+      }
+
+      if (++i > max_iter)
+      {
+         break;
+      }
+
+      beta = betanom/nom;
+      add(z, beta, d, d);       //  d = z + beta d
+      if (W.Width() > 0)
+      {
+         BlockDot(AW, z, c);
+         W.AddMult_a(-1.0, c, d); //  d = d - W (A W)^t z
+      }
+      OperMult(d, q);         //  q = A d
+      den = Dot(d, q);
+      MFEM_ASSERT(IsFinite(den), "den = " << den);
+      if (den <= 0.0)
+      {
+         if (Dot(d, d) > 0.0 && print_level >= 0)
+         {
+            mfem::out << "Deflated PCG: The operator is not positive "
+                      "definite. (Ad, d) = " << den << '\n';
+         }
+         if (den == 0.0)
+         {
+            final_iter = i;
+            break;
+         }
+      }
+      nom = betanom;
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "Deflated PCG: No convergence!" << '\n';
+   }
+   if (print_level >= 1 || (print_level >= 0 && !converged))
+   {
+      mfem::out << "Average reduction factor = "
+                << pow (betanom/nom0, 0.5/final_iter) << '\n';
+   }
+   final_norm = sqrt(betanom);
+
+   UpdateDeflationSpace(P, AP, BAP, np);
+}
+
+
+void GCRODRSolver::SetOperator(const Operator &op)
+{
+   IterativeSolver::SetOperator(op);
+
+   if (U.Width() == 0) { return; }
+   if (U.Height() != width)
+   {
+      ClearRecycledSpace();
+      return;
+   }
+   // C = M A U with orthonormal columns for the new operator
+   DenseMatrix AU(height, U.Width()), G, T, Tmp;
+   OperMult(U, AU);
+   C.SetSize(width, U.Width());
+   if (prec) { PrecMult(AU, C); }
+   else { C = AU; }
+   BlockDot(C, C, G);
+   G.Symmetrize();
+   GramOrthonormalize(G, T);
+   Tmp = U;
+   U.SetSize(width, T.Width());
+   mfem::Mult(Tmp, T, U);
+   Tmp = C;
+   C.SetSize(width, T.Width());
+   mfem::Mult(Tmp, T, C);
+}
+
+void GCRODRSolver::UpdateRecycleSpace(const DenseMatrix &V,
+                                      const DenseMatrix &Hc,
+                                      const DenseMatrix &Bc, int nc) const
+{
+   if (k <= 0) { return; }
+
+   const int s = U.Width(), na = s + nc;
+   DenseMatrix What, CV, Gh(na+1, na), F, Gm(na), UtW, Y, GY, T, Tmp;
+
+   // M A [U V_nc] = [C V_{nc+1}] Gh, Gh = [I Bc; 0 Hc]
+   Gh = 0.0;
+   for (int i = 0; i < s; i++)
+   {
+      Gh(i,i) = 1.0;
+      for (int j = 0; j < nc; j++) { Gh(i,s+j) = Bc(i,j); }
+   }
+   for (int j = 0; j < nc; j++)
+   {
+      for (int i = 0; i <= j+1; i++) { Gh(s+i,s+j) = Hc(i,j); }
+   }
+   F.SetSize(na);
+   MultAtB(Gh, Gh, F);
+
+   // Gram matrix of [U V_nc]; the columns of V are orthonormal
+   ConcatColumns(U, V, nc, What);
+   Gm = 0.0;
+   if (s > 0)
+   {
+      BlockDot(U, What, UtW);
+      for (int i = 0; i < s; i++)
+      {
+         for (int j = 0; j < na; j++)
+         {
+            Gm(i,j) = Gm(j,i) = UtW(i,j);
+         }
+      }
+   }
+   for (int i = s; i < na; i++) { Gm(i,i) = 1.0; }
+
+   SmallestEigenvectors(F, Gm, k, Y);
+
+   // orthonormalize M A [U V] Y = [C V] Gh Y; the columns of [C V] are
+   // orthonormal, so its Gram matrix is (Gh Y)^t (Gh Y)
+   GY.SetSize(na+1, Y.Width());
+   mfem::Mult(Gh, Y, GY);
+   Tmp.SetSize(Y.Width());
+   MultAtB(GY, GY, Tmp);
+   GramOrthonormalize(Tmp, T);
+   Tmp = Y;
+   Y.SetSize(na, T.Width());
+   mfem::Mult(Tmp, T, Y);
+   Tmp = GY;
+   GY.SetSize(na+1, T.Width());
+   mfem::Mult(Tmp, T, GY);
+
+   ConcatColumns(C, V, nc+1, CV);
+   U.SetSize(width, Y.Width());
+   mfem::Mult(What, Y, U);
+   C.SetSize(width, GY.Width());
+   mfem::Mult(CV, GY, C);
+}
+
+void GCRODRSolver::Mult(const Vector &b, Vector &x) const
+{
+   const int n = width;
+
+   DenseMatrix V, H, Hc, Bc;
+   Vector r(n), w(n), vi, vl, s, cs, sn, c, y;
+   double beta, tol;
+   int i, its = 0;
+
+   ResetProfile();
+
+   if (iterative_mode)
+   {
+      OperMult(x, r);
+      subtract(b, r, w);
+   }
+   else
+   {
+      x = 0.0;
+      w = b;
+   }
+   if (prec) { PrecMult(w, r); } // r = M (b - A x)
+   else { r = w; }
+   beta = Norm(r);
+   MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+   tol = std::max(rel_tol*beta, abs_tol);
+   ProfileIteration(0, beta);
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << 1
+                << "   Iteration : " << setw(3) << 0
+                << "  ||B r|| = " << beta << (print_level == 3 ? " ...\n" : "\n");
+   }
+
+   if (U.Width() > 0 && beta > tol)
+   {
+      // x = x + U C^t r, r = r - C C^t r
+      BlockDot(C, r, c);
+      U.AddMult(c, x);
+      C.AddMult_a(-1.0, c, r);
+      beta = Norm(r);
+   }
+
+   converged = 0;
+   for (int pass = 1; true; pass++)
+   {
+      if (beta <= tol) { converged = 1; break; }
+      if (its >= max_iter) { break; }
+
+      const int ns = U.Width(), ma = std::max(m - ns, 1);
+      V.SetSize(n, ma+1);
+      H.SetSize(ma+1, ma);
+      Hc.SetSize(ma+1, ma);
+      Bc.SetSize(ns, ma);
+      s.SetSize(ma+1);
+      cs.SetSize(ma+1);
+      sn.SetSize(ma+1);
+      H = 0.0;
+      Hc = 0.0;
+      s = 0.0;
+      s(0) = beta;
+      V.GetColumnReference(0, vi);
+      vi.Set(1.0/beta, r);
+
+      bool done = false;
+      for (i = 0; i < ma && its < max_iter; )
+      {
+         its++;
+         V.GetColumnReference(i, vi);
+         OperMult(vi, r);
+         if (prec) { PrecMult(r, w); } // w = M A v_i
+         else { w = r; }
+
+         if (ns > 0)
+         {
+            BlockDot(C, w, c);           // w = (I - C C^t) w
+            Bc.SetCol(i, c);
+            C.AddMult_a(-1.0, c, w);
+         }
+         for (int l = 0; l <= i; l++)
+         {
+            V.GetColumnReference(l, vl);
+            H(l,i) = Dot(w, vl);
+            w.Add(-H(l,i), vl);
+         }
+         H(i+1,i) = Norm(w);
+         MFEM_ASSERT(IsFinite(H(i+1,i)), "Norm(w) = " << H(i+1,i));
+         V.GetColumnReference(i+1, vi);
+         if (H(i+1,i) > 0.0) { vi.Set(1.0/H(i+1,i), w); }
+         else { vi = 0.0; }
+         for (int l = 0; l <= i+1; l++) { Hc(l,i) = H(l,i); }
+
+         for (int l = 0; l < i; l++)
+         {
+            ApplyPlaneRotation(H(l,i), H(l+1,i), cs(l), sn(l));
+         }
+         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
+         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
+         i++;
+
+         const double resid = fabs(s(i));
+         MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+         ProfileIteration(its, resid);
+         if (resid <= tol) { done = true; break; }
+
+         if (print_level == 1)
+         {
+            mfem::out << "   Pass : " << setw(2) << pass
+                      << "   Iteration : " << setw(3) << its
+                      << "  ||B r|| = " << resid << '\n';
+         }
+      }
+
+      // x = x + V y - U Bc y, where H y = s
+      y.SetSize(i);
+      for (int l = i-1; l >= 0; l--)
+      {
+         y(l) = s(l);
+         for (int q = l+1; q < i; q++) { y(l) -= H(l,q)*y(q); }
+         y(l) /= H(l,l);
+      }
+      for (int l = 0; l < i; l++)
+      {
+         V.GetColumnReference(l, vl);
+         x.Add(y(l), vl);
+      }
+      if (ns > 0)
+      {
+         c.SetSize(ns);
+         c = 0.0;
+         for (int l = 0; l < i; l++)
+         {
+            for (int p = 0; p < ns; p++) { c(p) += Bc(p,l)*y(l); }
+         }
+         U.AddMult_a(-1.0, c, x);
+      }
+
+      UpdateRecycleSpace(V, Hc, Bc, i);
+
+      OperMult(x, r);
+      subtract(b, r, w);
+      if (prec) { PrecMult(w, r); } // r = M (b - A x)
+      else { r = w; }
+      if (U.Width() > 0)
+      {
+         BlockDot(C, r, c);
+         U.AddMult(c, x);
+         C.AddMult_a(-1.0, c, r);
+      }
+      beta = Norm(r);
+      MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+
+      if (done)
+      {
+         converged = 1;
+         break;
+      }
+      if (print_level == 1 && its < max_iter && beta > tol)
+      {
+         mfem::out << "Restarting..." << '\n';
+      }
+   }
+
+   final_iter = its;
+   final_norm = beta;
+
+   if (print_level == 1 || print_level == 3)
+   {
+      mfem::out << "   Pass : " << setw(2) << (final_iter-1)/m+1
+                << "   Iteration : " << setw(3) << final_iter
+                << "  ||B r|| = " << final_norm << '\n';
+   }
+   else if (print_level == 2)
+   {
+      mfem::out << "GCRO-DR: Number of iterations: " << final_iter << '\n';
+   }
+   if (print_level >= 0 && !converged)
+   {
+      mfem::out << "GCRO-DR: No convergence!\n";
+   }
+}
+
+LOBPCGSolver::LOBPCGSolver()
+{
+   Init();
+#ifdef MFEM_USE_MPI
+   parallel = false;
+#endif
+}
+
+#ifdef MFEM_USE_MPI
+LOBPCGSolver::LOBPCGSolver(MPI_Comm comm_)
+{
+   Init();
+   parallel = true;
+   comm = comm_;
+}
+#endif
+
+void LOBPCGSolver::Init()
+{
+   oper = mass = NULL;
+   prec = NULL;
+   nev = 1;
+   block_size = 0;
+   seed = 75;
+   max_iter = 10;
+   print_level = -1;
+   rel_tol = abs_tol = 0.0;
+   final_iter = converged = 0;
+   final_norm = 0.0;
+}
+
+void LOBPCGSolver::SetPrintLevel(int print_lvl)
+{
+#ifdef MFEM_USE_MPI
+   if (parallel)
+   {
+      int rank;
+      MPI_Comm_rank(comm, &rank);
+      if (rank != 0) { return; }
+   }
+#endif
+   print_level = print_lvl;
+}
+
+void LOBPCGSolver::BlockDot(const DenseMatrix &V, const DenseMatrix &W,
+                            DenseMatrix &G) const
+{
+   G.SetSize(V.Width(), W.Width());
+   MultAtB(V, W, G);
+#ifdef MFEM_USE_MPI
+   if (parallel)
+   {
+      MPI_Allreduce(MPI_IN_PLACE, G.Data(), G.Height()*G.Width(), MPI_DOUBLE,
+                    MPI_SUM, comm);
+   }
+#endif
+}
+
+void LOBPCGSolver::ColumnDot(const DenseMatrix &V, const DenseMatrix &W,
+                             Vector &d) const
 {
-   DenseMatrix H(m+1,m);
-   Vector s(m+1), cs(m+1), sn(m+1);
-   Vector r(b.Size());
-
-   int i, j, k;
-
-
-   if (iterative_mode)
+   MFEM_ASSERT(V.Height() == W.Height() && V.Width() == W.Width(),
+               "incompatible dimensions");
+   const int n = V.Height();
+   d.SetSize(V.Width());
+   for (int j = 0; j < V.Width(); j++)
    {
-      oper->Mult(x, r);
-      subtract(b,r,r);
+      const double *v = V.GetColumn(j), *w = W.GetColumn(j);
+      double s = 0.0;
+      for (int i = 0; i < n; i++)
+      {
+         s += v[i]*w[i];
+      }
+      d(j) = s;
    }
-   else
+#ifdef MFEM_USE_MPI
+   if (parallel)
    {
-      x = 0.;
-      r = b;
+      MPI_Allreduce(MPI_IN_PLACE, d.GetData(), d.Size(), MPI_DOUBLE, MPI_SUM,
+                    comm);
    }
-   double beta = Norm(r);  // beta = ||r||
-   MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
+#endif
+}
 
-   final_norm = std::max(rel_tol*beta, abs_tol);
+void LOBPCGSolver::MassMult(const DenseMatrix &X, DenseMatrix &Y) const
+{
+   if (mass) { ColumnsMult(*mass, X, Y); }
+   else { Y = X; }
+}
 
-   if (beta <= final_norm)
+// Copy the columns @a cols of A to B.
+static void SelectColumns(const DenseMatrix &A, const Array<int> &cols,
+                          DenseMatrix &B)
+{
+   B.SetSize(A.Height(), cols.Size());
+   for (int j = 0; j < cols.Size(); j++)
    {
-      final_norm = beta;
-      final_iter = 0;
-      converged = 1;
-      return;
+      B.SetCol(j, A.GetColumn(cols[j]));
    }
+}
 
-   if (print_level == 1)
-   {
-      mfem::out << "   Pass : " << setw(2) << 1
-                << "   Iteration : " << setw(3) << 0
-                << "  || r || = " << beta << endl;
-   }
+// Replace X with X Y.
+static void RightMult(DenseMatrix &X, const DenseMatrix &Y)
+{
+   DenseMatrix Xc(X);
+   X.SetSize(Xc.Height(), Y.Width());
+   mfem::Mult(Xc, Y, X);
+}
 
-   Array<Vector*> v(m+1);
-   Array<Vector*> z(m+1);
-   for (i= 0; i<=m; i++)
+void LOBPCGSolver::Solve()
+{
+   MFEM_VERIFY(oper != NULL, "the operator is not set");
+   const int n = oper->Width(), bs = std::max(nev, block_size);
+   MFEM_VERIFY(0 < nev && bs <= n, "invalid number of modes or block size");
+
+   DenseMatrix AX(n, bs), BX(n, bs), R(n, bs), W, AW, BW, P, AP, BP;
+   DenseMatrix Pa, APa, BPa, S, AS, BS, GA, GB, Y, Yx, Ywp, Tmp;
+   Vector lambda, rnorm, x;
+   Array<int> active;
+   double max_norm = 0.0;
+   int it;
+
+   // initial vectors: the given ones, completed with random vectors
+   const int ni = (X.Height() == n) ? std::min(X.Width(), bs) : 0;
+   Tmp = X;
+   X.SetSize(n, bs);
+   for (int j = 0; j < bs; j++)
    {
-      v[i] = NULL;
-      z[i] = NULL;
+      X.GetColumnReference(j, x);
+      if (j < ni) { x = Tmp.GetColumn(j); }
+      else { x.Randomize(seed + j); x -= 0.5; }
    }
 
-   j = 1;
-   while (j <= max_iter)
-   {
-      if (v[0] == NULL) { v[0] = new Vector(b.Size()); }
-      (*v[0]) = 0.0;
-      v[0] -> Add (1.0/beta, r);   // v[0] = r / ||r||
-      s = 0.0; s(0) = beta;
+   // Rayleigh-Ritz on the span of X
+   ColumnsMult(*oper, X, AX);
+   MassMult(X, BX);
+   BlockDot(X, AX, GA);
+   BlockDot(X, BX, GB);
+   GA.Symmetrize();
+   GB.Symmetrize();
+   SmallestEigenvectors(GA, GB, bs, Y, &lambda);
+   MFEM_VERIFY(Y.Width() == bs, "the initial vectors are linearly dependent");
+   RightMult(X, Y);
+   RightMult(AX, Y);
+   RightMult(BX, Y);
 
-      for (i = 0; i < m && j <= max_iter; i++, j++)
+   converged = 0;
+   for (it = 0; true; it++)
+   {
+      // residuals R = A X - M X diag(lambda)
+      R = AX;
+      for (int j = 0; j < bs; j++)
       {
+         double *r = R.GetColumn(j);
+         const double *bx = BX.GetColumn(j);
+         for (int i = 0; i < n; i++) { r[i] -= lambda(j)*bx[i]; }
+      }
+      ColumnDot(R, R, rnorm);
 
-         if (z[i] == NULL) { z[i] = new Vector(b.Size()); }
-         (*z[i]) = 0.0;
-
-         if (prec)
-         {
-            prec->Mult(*v[i], *z[i]);
-         }
-         else
-         {
-            (*z[i]) = (*v[i]);
-         }
-         oper->Mult(*z[i], r);
-
-         for (k = 0; k <= i; k++)
-         {
-            H(k,i) = Dot( r, *v[k]); // H(k,i) = r * v[k]
-            r.Add(-H(k,i), (*v[k])); // r -= H(k,i) * v[k]
-         }
-
-         H(i+1,i)  = Norm(r);       // H(i+1,i) = ||r||
-         if (v[i+1] == NULL) { v[i+1] = new Vector(b.Size()); }
-         (*v[i+1]) = 0.0;
-         v[i+1] -> Add (1.0/H(i+1,i), r); // v[i+1] = r / H(i+1,i)
-
-         for (k = 0; k < i; k++)
-         {
-            ApplyPlaneRotation(H(k,i), H(k+1,i), cs(k), sn(k));
-         }
-
-         GeneratePlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(H(i,i), H(i+1,i), cs(i), sn(i));
-         ApplyPlaneRotation(s(i), s(i+1), cs(i), sn(i));
-
-         double resid = fabs(s(i+1));
-         MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
-         if (print_level == 1)
-         {
-            mfem::out << "   Pass : " << setw(2) << (j-1)/m+1
-                      << "   Iteration : " << setw(3) << j
-                      << "  || r || = " << resid << endl;
-         }
-
-         if (resid <= final_norm)
+      // soft locking: only the unconverged pairs get new search directions
+      active.SetSize(0);
+      max_norm = 0.0;
+      for (int j = 0; j < bs; j++)
+      {
+         rnorm(j) = sqrt(std::max(rnorm(j), 0.0));
+         if (j < nev) { max_norm = std::max(max_norm, rnorm(j)); }
+         if (rnorm(j) > std::max(rel_tol*std::abs(lambda(j)), abs_tol))
          {
-            Update(x, i, H, s, z);
-            final_norm = resid;
-            final_iter = j;
-            converged = 1;
-
-            if (print_level == 2)
-            {
-               mfem::out << "Number of FGMRES iterations: " << final_iter << endl;
-            }
-
-            for (i= 0; i<=m; i++)
-            {
-               if (v[i]) { delete v[i]; }
-               if (z[i]) { delete z[i]; }
-            }
-            return;
+            active.Append(j);
          }
       }
-
       if (print_level == 1)
       {
-         mfem::out << "Restarting..." << endl;
+         mfem::out << "   Iteration : " << setw(3) << it
+                   << "  active = " << setw(3) << active.Size()
+                   << "  max ||r|| = " << max_norm << '\n';
       }
 
-      Update(x, i-1, H, s, z);
-
-      oper->Mult(x, r);
-      subtract(b,r,r);
-      beta = Norm(r);
-      MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
-      if (beta <= final_norm)
+      if (active.Size() == 0 || active[0] >= nev)
       {
-         final_norm = beta;
-         final_iter = j;
          converged = 1;
-
-         if (print_level == 2)
-         {
-            mfem::out << "Number of FGMRES iterations: " << final_iter << endl;
-         }
-
-         for (i= 0; i<=m; i++)
+         break;
+      }
+      if (it >= max_iter) { break; }
+
+      // W = T R(:,active)
+      SelectColumns(R, active, Tmp);
+      W.SetSize(n, active.Size());
+      if (prec) { ColumnsMult(*prec, Tmp, W); }
+      else { W = Tmp; }
+      AW.SetSize(n, W.Width());
+      BW.SetSize(n, W.Width());
+      ColumnsMult(*oper, W, AW);
+      MassMult(W, BW);
+
+      // the basis S = [X W P(:,active)]
+      if (it > 0)
+      {
+         SelectColumns(P, active, Pa);
+         SelectColumns(AP, active, APa);
+         SelectColumns(BP, active, BPa);
+      }
+      ConcatColumns(X, W, W.Width(), Tmp);
+      ConcatColumns(Tmp, Pa, Pa.Width(), S);
+      ConcatColumns(AX, AW, AW.Width(), Tmp);
+      ConcatColumns(Tmp, APa, APa.Width(), AS);
+      ConcatColumns(BX, BW, BW.Width(), Tmp);
+      ConcatColumns(Tmp, BPa, BPa.Width(), BS);
+
+      // Rayleigh-Ritz on the span of S; the X blocks of the projected
+      // matrices are known
+      BlockDot(S, AS, GA);
+      BlockDot(S, BS, GB);
+      GA.Symmetrize();
+      GB.Symmetrize();
+      for (int j = 0; j < bs; j++)
+      {
+         for (int i = 0; i < bs; i++)
          {
-            if (v[i]) { delete v[i]; }
-            if (z[i]) { delete z[i]; }
+            GA(i,j) = (i == j) ? lambda(j) : 0.0;
+            GB(i,j) = (i == j) ? 1.0 : 0.0;
          }
-         return;
       }
+      SmallestEigenvectors(GA, GB, bs, Y, &lambda);
+      MFEM_VERIFY(Y.Width() == bs, "breakdown in the Rayleigh-Ritz procedure");
+
+      // P = [W P(:,active)] Y(bs:,:), X = X Y(0:bs,:) + P
+      const int s = S.Width();
+      Yx.CopyMN(Y, bs, bs, 0, 0);
+      Ywp.CopyMN(Y, s - bs, bs, bs, 0);
+      DenseMatrix Swp(S.GetColumn(bs), n, s - bs);
+      DenseMatrix ASwp(AS.GetColumn(bs), n, s - bs);
+      DenseMatrix BSwp(BS.GetColumn(bs), n, s - bs);
+      P.SetSize(n, bs);
+      AP.SetSize(n, bs);
+      BP.SetSize(n, bs);
+      mfem::Mult(Swp, Ywp, P);
+      mfem::Mult(ASwp, Ywp, AP);
+      mfem::Mult(BSwp, Ywp, BP);
+      RightMult(X, Yx);
+      RightMult(AX, Yx);
+      RightMult(BX, Yx);
+      X += P;
+      AX += AP;
+      BX += BP;
    }
 
-   for (i = 0; i <= m; i++)
+   final_iter = it;
+   final_norm = max_norm;
+   eigenvalues.SetSize(nev);
+   for (int j = 0; j < nev; j++) { eigenvalues[j] = lambda(j); }
+
+   if (print_level == 1 || print_level == 2)
    {
-      if (v[i]) { delete v[i]; }
-      if (z[i]) { delete z[i]; }
+      mfem::out << "LOBPCG: Number of iterations: " << final_iter << '\n';
    }
-   converged = 0;
-
-   if (print_level >= 0)
+   if (print_level >= 0 && !converged)
    {
-      mfem::out << "FGMRES: No convergence!" << endl;
+      mfem::out << "LOBPCG: No convergence!\n";
    }
-
-   return;
-}
-
-
-int GMRES(const Operator &A, Vector &x, const Vector &b, Solver &M,
-          int &max_iter, int m, double &tol, double atol, int printit)
-{
-   GMRESSolver gmres;
-   gmres.SetPrintLevel(printit);
-   gmres.SetMaxIter(max_iter);
-   gmres.SetKDim(m);
-   gmres.SetRelTol(sqrt(tol));
-   gmres.SetAbsTol(sqrt(atol));
-   gmres.SetOperator(A);
-   gmres.SetPreconditioner(M);
-   gmres.Mult(b, x);
-   max_iter = gmres.GetNumIterations();
-   tol = gmres.GetFinalNorm()*gmres.GetFinalNorm();
-   return gmres.GetConverged();
-}
-
-void GMRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
-           int print_iter, int max_num_iter, int m, double rtol, double atol)
-{
-   GMRES(A, x, b, B, max_num_iter, m, rtol, atol, print_iter);
 }
 
 
@@ -984,9 +2680,11 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
    double resid, tol_goal;
    double rho_1, rho_2=1.0, alpha=1.0, beta, omega=1.0;
 
+   ResetProfile();
+
    if (iterative_mode)
    {
-      oper->Mult(x, r);
+      OperMult(x, r);
       subtract(b, r, r); // r = b - A x
    }
    else
@@ -1003,6 +2701,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
                 << "   ||r|| = " << resid << '\n';
 
    tol_goal = std::max(resid*rel_tol, abs_tol);
+   ProfileIteration(0, resid);
 
    if (resid <= tol_goal)
    {
@@ -1037,13 +2736,13 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       }
       if (prec)
       {
-         prec->Mult(p, phat);   //  phat = M^{-1} * p
+         PrecMult(p, phat);   //  phat = M^{-1} * p
       }
       else
       {
          phat = p;
       }
-      oper->Mult(phat, v);     //  v = A * phat
+      OperMult(phat, v);     //  v = A * phat
       alpha = rho_1 / Dot(rtilde, v);
       add(r, -alpha, v, s); //  s = r - alpha * v
       resid = Norm(s);
@@ -1051,6 +2750,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       if (resid < tol_goal)
       {
          x.Add(alpha, phat);  //  x = x + alpha * phat
+         ProfileIteration(i, resid);
          if (print_level >= 0)
             mfem::out << "   Iteration : " << setw(3) << i
                       << "   ||s|| = " << resid << '\n';
@@ -1064,13 +2764,13 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
                    << "   ||s|| = " << resid;
       if (prec)
       {
-         prec->Mult(s, shat);  //  shat = M^{-1} * s
+         PrecMult(s, shat);  //  shat = M^{-1} * s
       }
       else
       {
          shat = s;
       }
-      oper->Mult(shat, t);     //  t = A * shat
+      OperMult(shat, t);     //  t = A * shat
       omega = Dot(t, s) / Dot(t, t);
       x.Add(alpha, phat);   //  x += alpha * phat
       x.Add(omega, shat);   //  x += omega * shat
@@ -1079,6 +2779,7 @@ void BiCGSTABSolver::Mult(const Vector &b, Vector &x) const
       rho_2 = rho_1;
       resid = Norm(r);
       MFEM_ASSERT(IsFinite(resid), "resid = " << resid);
+      ProfileIteration(i, resid);
       if (print_level >= 0)
       {
          mfem::out << "   ||r|| = " << resid << '\n';
@@ -1153,6 +2854,7 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
    double alpha, delta, rho1, rho2, rho3, norm_goal;
    Vector *z = (prec) ? &u1 : &v1;
 
+   ResetProfile();
    converged = 1;
 
    if (!iterative_mode)
@@ -1162,13 +2864,13 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
    }
    else
    {
-      oper->Mult(x, v1);
+      OperMult(x, v1);
       subtract(b, v1, v1);
    }
 
    if (prec)
    {
-      prec->Mult(v1, u1);
+      PrecMult(v1, u1);
    }
    eta = beta = sqrt(Dot(*z, v1));
    MFEM_ASSERT(IsFinite(eta), "eta = " << eta);
@@ -1176,6 +2878,7 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
    sigma0 = sigma1 = 0.;
 
    norm_goal = std::max(rel_tol*eta, abs_tol);
+   ProfileIteration(0, eta);
 
    if (eta <= norm_goal)
    {
@@ -1196,7 +2899,7 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
       {
          u1 /= beta;
       }
-      oper->Mult(*z, q);
+      OperMult(*z, q);
       alpha = Dot(*z, q);
       MFEM_ASSERT(IsFinite(alpha), "alpha = " << alpha);
       if (it > 1) // (v0 == 0) for (it == 1)
@@ -1214,7 +2917,7 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
       }
       else
       {
-         prec->Mult(v0, q);
+         PrecMult(v0, q);
          beta = sqrt(Dot(v0, q));
       }
       MFEM_ASSERT(IsFinite(beta), "beta = " << beta);
@@ -1244,6 +2947,7 @@ void MINRESSolver::Mult(const Vector &b, Vector &x) const
 
       eta = -sigma1*eta;
       MFEM_ASSERT(IsFinite(eta), "eta = " << eta);
+      ProfileIteration(it, fabs(eta));
 
       if (fabs(eta) <= norm_goal)
       {
@@ -1282,11 +2986,11 @@ loop_end:
 #if 0
    if (print_level >= 1)
    {
-      oper->Mult(x, v1);
+      OperMult(x, v1);
       subtract(b, v1, v1);
       if (prec)
       {
-         prec->Mult(v1, u1);
+         PrecMult(v1, u1);
       }
       eta = sqrt(Dot(*z, v1));
       mfem::out << "MINRES: iteration " << setw(3) << it << ": ||r||_B = "
@@ -1325,6 +3029,46 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 }
 
 
+void NewtonSolver::InitNewton()
+{
+   jacobian_free = false;
+   fd_eps = 1.4901161193847656e-8;
+   jacobian_lag = 1;
+   lin_rtol_type = 0;
+   lin_rtol0 = 0.5;
+   lin_rtol_max = 0.9;
+   ew_alpha = 0.5*(1.0 + sqrt(5.0));
+   ew_gamma = 1.0;
+   fnorm_last = lnorm_last = rtol_last = 0.0;
+}
+
+void NewtonSolver::FDJacobian::Update(const Vector &x_, const Vector &fx_,
+                                      const Vector *b_)
+{
+   height = width = x_.Size();
+   x = &x_;
+   fx = &fx_;
+   b = b_;
+   h0 = newton.fd_eps*(1.0 + newton.Norm(x_));
+   xh.SetSize(width);
+   fh.SetSize(height);
+}
+
+void NewtonSolver::FDJacobian::Mult(const Vector &v, Vector &y) const
+{
+   const double vnorm = newton.Norm(v);
+   if (vnorm == 0.0)
+   {
+      y = 0.0;
+      return;
+   }
+   const double h = h0/vnorm;
+   add(*x, h, v, xh);
+   newton.OperMult(xh, fh);
+   if (b) { fh -= *b; }
+   subtract(1.0/h, fh, *fx, y);   // y = (F(x + h v) - F(x))/h
+}
+
 void NewtonSolver::SetOperator(const Operator &op)
 {
    oper = &op;
@@ -1336,6 +3080,58 @@ void NewtonSolver::SetOperator(const Operator &op)
    c.SetSize(width);
 }
 
+void NewtonSolver::SetAdaptiveLinRtol(int type, double rtol0, double rtol_max,
+                                      double alpha, double gamma)
+{
+   lin_rtol_type = type;
+   lin_rtol0 = rtol0;
+   lin_rtol_max = rtol_max;
+   ew_alpha = alpha;
+   ew_gamma = gamma;
+}
+
+void NewtonSolver::AdaptiveLinRtolPreSolve(int it, double fnorm) const
+{
+   IterativeSolver *iter = dynamic_cast<IterativeSolver *>(prec);
+   MFEM_VERIFY(iter, "the linear solver must be an IterativeSolver");
+
+   double eta = lin_rtol0;
+   if (it > 0)
+   {
+      double safeguard;
+      if (lin_rtol_type == 1)
+      {
+         eta = std::abs(fnorm - lnorm_last)/fnorm_last;
+         safeguard = pow(rtol_last, ew_alpha);
+      }
+      else
+      {
+         eta = ew_gamma*pow(fnorm/fnorm_last, ew_alpha);
+         safeguard = ew_gamma*pow(rtol_last, ew_alpha);
+      }
+      if (safeguard > 0.1) { eta = std::max(eta, safeguard); }
+      eta = std::min(eta, lin_rtol_max);
+   }
+   iter->SetRelTol(eta);
+   rtol_last = eta;
+   fnorm_last = fnorm;
+   if (print_level >= 0)
+   {
+      mfem::out << "Newton iteration " << setw(2) << it
+                << " : linear solver relative tolerance = " << eta << '\n';
+   }
+}
+
+void NewtonSolver::AdaptiveLinRtolPostSolve(const Operator &J) const
+{
+   if (lin_rtol_type != 1) { return; }
+   // ||F(x) + J s|| with s = -c
+   Vector Jc(height);
+   J.Mult(c, Jc);
+   Jc -= r;
+   lnorm_last = Norm(Jc);
+}
+
 void NewtonSolver::Mult(const Vector &b, Vector &x) const
 {
    MFEM_ASSERT(oper != NULL, "the Operator is not set (use SetOperator).");
@@ -1344,13 +3140,16 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
    int it;
    double norm0, norm, norm_goal;
    const bool have_b = (b.Size() == Height());
+   const Operator *grad = NULL;
+
+   ResetProfile();
 
    if (!iterative_mode)
    {
       x = 0.0;
    }
 
-   oper->Mult(x, r);
+   OperMult(x, r);
    if (have_b)
    {
       r -= b;
@@ -1361,10 +3160,20 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
 
    prec->iterative_mode = false;
 
+   if (jacobian_free)
+   {
+      IterativeSolver *iter = dynamic_cast<IterativeSolver *>(prec);
+      MFEM_VERIFY(iter, "the JFNK mode requires an IterativeSolver");
+      if (jf_prec.pc) { iter->SetPreconditioner(jf_prec); }
+      fd_jac.Update(x, r, have_b ? &b : NULL);
+      iter->SetOperator(fd_jac);
+   }
+
    // x_{i+1} = x_i - [DF(x_i)]^{-1} [F(x_i)-b]
    for (it = 0; true; it++)
    {
       MFEM_ASSERT(IsFinite(norm), "norm = " << norm);
+      ProfileIteration(it, norm);
       if (print_level >= 0)
       {
          mfem::out << "Newton iteration " << setw(2) << it
@@ -1388,9 +3197,29 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
          break;
       }
 
-      prec->SetOperator(oper->GetGradient(x));
+      if (it % jacobian_lag == 0)
+      {
+         if (!jacobian_free)
+         {
+            grad = &oper->GetGradient(x);
+            prec->SetOperator(*grad);
+         }
+         else if (jf_prec.pc)
+         {
+            jf_prec.pc->SetOperator(oper->GetGradient(x));
+         }
+      }
+      if (jacobian_free)
+      {
+         fd_jac.Update(x, r, have_b ? &b : NULL);
+         grad = &fd_jac;
+      }
+
+      if (lin_rtol_type) { AdaptiveLinRtolPreSolve(it, norm); }
 
-      prec->Mult(r, c);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
+      PrecMult(r, c);  // c = [DF(x_i)]^{-1} [F(x_i)-b]
+
+      if (lin_rtol_type) { AdaptiveLinRtolPostSolve(*grad); }
 
       const double c_scale = ComputeScalingFactor(x, b);
       if (c_scale == 0.0)
@@ -1402,7 +3231,7 @@ void NewtonSolver::Mult(const Vector &b, Vector &x) const
 
       ProcessNewState(x);
 
-      oper->Mult(x, r);
+      OperMult(x, r);
       if (have_b)
       {
          r -= b;
@@ -2009,6 +3838,7 @@ void BlockILU::SetOperator(const Operator &op)
    MFEM_ASSERT(A->Finalized(), "Matrix must be finalized.");
    CreateBlockPattern(*A);
    Factorize();
+   ComputeLevels();
 }
 
 void BlockILU::CreateBlockPattern(const SparseMatrix &A)
@@ -2215,53 +4045,108 @@ void BlockILU::Factorize()
    }
 }
 
-void BlockILU::Mult(const Vector &b, Vector &x) const
+void BlockILU::ComputeLevels()
 {
-   MFEM_ASSERT(height > 0, "BlockILU(0) preconditioner is not constructed");
    int nblockrows = Height()/block_size;
-   y.SetSize(Height());
+   Array<int> level(nblockrows);
+   int num_levels;
 
-   DenseMatrix B;
-   Vector yi, yj, xi, xj;
-   Vector tmp(block_size);
-   // Forward substitute to solve Ly = b
-   // Implicitly, L has identity on the diagonal
-   y = 0.0;
+   // Forward substitution: block row i depends on the block rows j < i in the
+   // strictly lower triangular part of row i.
+   num_levels = 0;
    for (int i=0; i<nblockrows; ++i)
    {
-      yi.SetDataAndSize(&y[i*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
-      {
-         yi[ib] = b[ib + P[i]*block_size];
-      }
+      int lev = 0;
       for (int k=IB[i]; k<ID[i]; ++k)
       {
-         int j = JB[k];
-         const DenseMatrix &L_ij = AB(k);
-         yj.SetDataAndSize(&y[j*block_size], block_size);
-         // y_i = y_i - L_ij*y_j
-         L_ij.AddMult_a(-1.0, yj, yi);
+         lev = std::max(lev, level[JB[k]] + 1);
       }
+      level[i] = lev;
+      num_levels = std::max(num_levels, lev + 1);
    }
-   // Backward substitution to solve Ux = y
+   Transpose(level, L_levels, num_levels);
+
+   // Backward substitution: block row i depends on the block rows j > i in the
+   // strictly upper triangular part of row i.
+   num_levels = 0;
    for (int i=nblockrows-1; i >= 0; --i)
    {
-      xi.SetDataAndSize(&x[P[i]*block_size], block_size);
-      for (int ib=0; ib<block_size; ++ib)
+      int lev = 0;
+      for (int k=ID[i]+1; k<IB[i+1]; ++k)
       {
-         xi[ib] = y[ib + i*block_size];
+         lev = std::max(lev, level[JB[k]] + 1);
       }
-      for (int k=ID[i]+1; k<IB[i+1]; ++k)
+      level[i] = lev;
+      num_levels = std::max(num_levels, lev + 1);
+   }
+   Transpose(level, U_levels, num_levels);
+}
+
+void BlockILU::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_ASSERT(height > 0, "BlockILU(0) preconditioner is not constructed");
+   y.SetSize(Height());
+
+   // Forward substitute to solve Ly = b
+   // Implicitly, L has identity on the diagonal
+   // The block rows within one level are independent.
+   for (int l=0; l<L_levels.Size(); ++l)
+   {
+      const int *rows = L_levels.GetRow(l);
+      const int nrows = L_levels.RowSize(l);
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int r=0; r<nrows; ++r)
+      {
+         const int i = rows[r];
+         DenseMatrix L_ij;
+         Vector yi(&y[i*block_size], block_size), yj;
+         for (int ib=0; ib<block_size; ++ib)
+         {
+            yi[ib] = b[ib + P[i]*block_size];
+         }
+         for (int k=IB[i]; k<ID[i]; ++k)
+         {
+            int j = JB[k];
+            L_ij.UseExternalData(const_cast<double*>(AB.GetData(k)),
+                                 block_size, block_size);
+            yj.SetDataAndSize(&y[j*block_size], block_size);
+            // y_i = y_i - L_ij*y_j
+            L_ij.AddMult_a(-1.0, yj, yi);
+         }
+      }
+   }
+   // Backward substitution to solve Ux = y
+   for (int l=0; l<U_levels.Size(); ++l)
+   {
+      const int *rows = U_levels.GetRow(l);
+      const int nrows = U_levels.RowSize(l);
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int r=0; r<nrows; ++r)
       {
-         int j = JB[k];
-         const DenseMatrix &U_ij = AB(k);
-         xj.SetDataAndSize(&x[P[j]*block_size], block_size);
-         // x_i = x_i - U_ij*x_j
-         U_ij.AddMult_a(-1.0, xj, xi);
+         const int i = rows[r];
+         DenseMatrix U_ij;
+         Vector xi(&x[P[i]*block_size], block_size), xj;
+         for (int ib=0; ib<block_size; ++ib)
+         {
+            xi[ib] = y[ib + i*block_size];
+         }
+         for (int k=ID[i]+1; k<IB[i+1]; ++k)
+         {
+            int j = JB[k];
+            U_ij.UseExternalData(const_cast<double*>(AB.GetData(k)),
+                                 block_size, block_size);
+            xj.SetDataAndSize(&x[P[j]*block_size], block_size);
+            // x_i = x_i - U_ij*x_j
+            U_ij.AddMult_a(-1.0, xj, xi);
+         }
+         LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*block_size]);
+         // x_i = D_ii^{-1} x_i
+         A_ii_inv.Solve(block_size, 1, xi);
       }
-      LUFactors A_ii_inv(&DB(0,0,i), &ipiv[i*block_size]);
-      // x_i = D_ii^{-1} x_i
-      A_ii_inv.Solve(block_size, 1, xi);
    }
 }
 
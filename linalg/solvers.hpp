@@ -13,6 +13,7 @@
 #define MFEM_SOLVERS
 
 #include "../config/config.hpp"
+#include "../general/tic_toc.hpp"
 #include "densemat.hpp"
 
 #ifdef MFEM_USE_MPI
@@ -30,6 +31,37 @@ namespace mfem
 
 class BilinearForm;
 
+/// Timings and residual norm of one iteration of an IterativeSolver.
+struct IterationStats
+{
+   /// Iteration number; 0 corresponds to the initial residual.
+   int iteration;
+   /** Residual norm, in the same units as IterativeSolver::GetFinalNorm(), or
+       -1 if it is not computed in this iteration. */
+   double norm;
+   /// Time (in seconds) spent in the operator.
+   double oper_time;
+   /// Time spent in the preconditioner.
+   double prec_time;
+   /// Time spent in inner products, including global reductions.
+   double dot_time;
+   /// Remaining time of the iteration, mostly vector updates.
+   double update_time;
+   /// Number of operator and preconditioner applications and inner products.
+   int oper_calls, prec_calls, dot_calls;
+};
+
+/** @brief Abstract base class for objects receiving the per-iteration
+    statistics of an IterativeSolver, see IterativeSolver::SetMonitor(). */
+class IterativeSolverMonitor
+{
+public:
+   virtual ~IterativeSolverMonitor() { }
+
+   /// Called by the solver at the end of every iteration.
+   virtual void MonitorIteration(const IterationStats &stats) = 0;
+};
+
 /// Abstract base class for iterative solver
 class IterativeSolver : public Solver
 {
@@ -50,9 +82,56 @@ protected:
    mutable int final_iter, converged;
    mutable double final_norm;
 
+   // profiling, see SetProfiling()
+   bool profiling;
+   IterativeSolverMonitor *monitor;
+   mutable Array<IterationStats> iter_stats;
+   mutable IterationStats cur_stats;
+   mutable StopWatch iter_sw, oper_sw, prec_sw, dot_sw;
+
+   /// Apply the operator, y = A x, timing the call when profiling.
+   void OperMult(const Vector &x, Vector &y) const;
+   /// Apply the preconditioner, y = B x, timing the call when profiling.
+   void PrecMult(const Vector &x, Vector &y) const;
+   /** Apply the operator to the columns of @a X (see Operator::ArrayMult()),
+       timing the call when profiling. */
+   void OperMult(const DenseMatrix &X, DenseMatrix &Y) const;
+   /// Apply the preconditioner to the columns of @a X.
+   void PrecMult(const DenseMatrix &X, DenseMatrix &Y) const;
+
+   /** Start the profiling of a solve; called at the beginning of Mult() by
+       the derived classes. */
+   void ResetProfile() const;
+   /** Record the statistics of iteration @a it, which ended with residual
+       norm @a norm, and pass them to the monitor; called by the derived
+       classes at the end of each iteration. */
+   void ProfileIteration(int it, double norm) const
+   { if (profiling) { RecordIteration(it, norm); } }
+   void RecordIteration(int it, double norm) const;
+
    double Dot(const Vector &x, const Vector &y) const;
    double Norm(const Vector &x) const { return sqrt(Dot(x, x)); }
 
+   /** @brief Compute the matrix of inner products G = V^t W of the columns of
+       @a V and @a W, using a single (global) reduction. */
+   void BlockDot(const DenseMatrix &V, const DenseMatrix &W,
+                 DenseMatrix &G) const;
+
+   /** @brief Compute the inner products d(j) = (V(:,j), W(:,j)) of the columns
+       of @a V and @a W, using a single (global) reduction. */
+   void ColumnDot(const DenseMatrix &V, const DenseMatrix &W, Vector &d) const;
+
+   /** @brief Compute the inner products c = V^t w of the columns of @a V with
+       @a w, using a single (global) reduction. */
+   void BlockDot(const DenseMatrix &V, const Vector &w, Vector &c) const;
+
+   /** @brief Orthogonalize the last column of @a V against the other columns,
+       which must be orthonormal, with the Gram-Schmidt variant @a type, see
+       GMRESSolver::Orthogonalization. */
+   /** The projection coefficients are returned in @a h and the norm of the
+       orthogonalized column is returned; the column is not normalized. */
+   double GramSchmidt(int type, DenseMatrix &V, double *h) const;
+
 public:
    IterativeSolver();
 
@@ -69,6 +148,23 @@ public:
    int GetConverged() const { return converged; }
    double GetFinalNorm() const { return final_norm; }
 
+   /** @brief Enable (or disable) the recording of per-iteration statistics:
+       the time spent in the operator, the preconditioner, the inner products
+       (including global reductions) and the remaining work of each iteration,
+       together with the residual norm. The statistics of the last solve are
+       returned by GetIterationStats(). Disabled by default. */
+   void SetProfiling(bool profile = true) { profiling = profile; }
+
+   /** @brief Set a monitor that receives the statistics of every iteration as
+       they are recorded; this also enables profiling. The monitor is not
+       owned. */
+   void SetMonitor(IterativeSolverMonitor &m)
+   { monitor = &m; profiling = true; }
+
+   /// Return the per-iteration statistics of the last solve, if profiling.
+   const Array<IterationStats> &GetIterationStats() const
+   { return iter_stats; }
+
    /// This should be called before SetOperator
    virtual void SetPreconditioner(Solver &pr);
 
@@ -181,21 +277,64 @@ void PCG(const Operator &A, Solver &B, const Vector &b, Vector &x,
 
 
 /// GMRES method
+/** The Krylov basis is orthogonalized with modified Gram-Schmidt by default,
+    which needs one global reduction per basis vector in every iteration. The
+    classical Gram-Schmidt variants, see SetOrthogonalization(), and the s-step
+    method, see SetSStep(), need a fixed number of reductions instead, which
+    is preferable when the iterations are latency bound. */
 class GMRESSolver : public IterativeSolver
 {
+public:
+   /// Gram-Schmidt variants used to orthogonalize the Krylov basis.
+   enum Orthogonalization
+   {
+      /// Modified Gram-Schmidt: i+2 reductions in iteration i (default).
+      MGS,
+      /** Classical Gram-Schmidt, with the norm computed in the same
+          reduction as the projection: 1 reduction per iteration. Less stable
+          than MGS when the basis loses orthogonality. */
+      CGS,
+      /** Classical Gram-Schmidt with reorthogonalization; the norm is fused
+          with the second projection: 2 reductions per iteration. */
+      CGS2
+   };
+
 protected:
    int m; // see SetKDim()
+   int ortho; // see SetOrthogonalization()
+   int s_step; // see SetSStep()
+
+   /** Extend the Arnoldi basis, stored in the columns of @a basis (of height
+       @a n), from column @a i by @a sb vectors generated with the monomial
+       basis (M A)^k v_i, setting the columns i,...,i+sb-1 of @a H. Returns
+       false if the block is numerically rank deficient. */
+   bool SStepArnoldi(double *basis, int n, DenseMatrix &H, int i, int sb,
+                     Vector &r) const;
 
 public:
-   GMRESSolver() { m = 50; }
+   GMRESSolver() { m = 50; ortho = MGS; s_step = 1; }
 
 #ifdef MFEM_USE_MPI
-   GMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+   GMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm)
+   { m = 50; ortho = MGS; s_step = 1; }
 #endif
 
    /// Set the number of iteration to perform between restarts, default is 50.
    void SetKDim(int dim) { m = dim; }
 
+   /// Set the Gram-Schmidt variant, see Orthogonalization; default is MGS.
+   void SetOrthogonalization(int type) { ortho = type; }
+
+   /** @brief Generate @a s Krylov vectors at a time and orthogonalize them as
+       a block, using 3 reductions per block; default is 1 (no blocking). */
+   /** The block is orthogonalized with block classical Gram-Schmidt, applied
+       twice, followed by Cholesky QR, applied twice. The monomial basis
+       becomes ill-conditioned as @a s increases, so small values, up to about
+       5, should be used. If a block is rank deficient it is replaced by a
+       single iteration with the Orthogonalization set with
+       SetOrthogonalization(). */
+   void SetSStep(int s) { s_step = s; }
+
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
@@ -204,16 +343,22 @@ class FGMRESSolver : public IterativeSolver
 {
 protected:
    int m;
+   int ortho;
 
 public:
-   FGMRESSolver() { m = 50; }
+   FGMRESSolver() { m = 50; ortho = GMRESSolver::MGS; }
 
 #ifdef MFEM_USE_MPI
-   FGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+   FGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm)
+   { m = 50; ortho = GMRESSolver::MGS; }
 #endif
 
    void SetKDim(int dim) { m = dim; }
 
+   /** @brief Set the Gram-Schmidt variant, see GMRESSolver::Orthogonalization;
+       default is GMRESSolver::MGS. */
+   void SetOrthogonalization(int type) { ortho = type; }
+
    virtual void Mult(const Vector &b, Vector &x) const;
 };
 
@@ -227,6 +372,319 @@ void GMRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
            double rtol = 1e-12, double atol = 1e-24);
 
 
+/** @brief Block conjugate gradient method for several right-hand sides.
+
+    The right-hand sides and the solutions are stored as the columns of
+    n x k DenseMatrix objects. The operator and the preconditioner are applied
+    to all k vectors at once with Operator::ArrayMult(), e.g. as a sparse
+    matrix - multivector product for SparseMatrix. The search directions are
+    A-orthonormalized in every iteration and (nearly) linearly dependent
+    directions are dropped, so the method does not break down when some of
+    the right-hand sides converge before the others. The convergence test
+    (B r_j, r_j) <= max(rel_tol^2 (B r0_j, r0_j), abs_tol^2) is applied to each
+    column j. The operator and the preconditioner must be symmetric positive
+    definite. */
+class BlockCGSolver : public IterativeSolver
+{
+public:
+   BlockCGSolver() { }
+
+#ifdef MFEM_USE_MPI
+   BlockCGSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+#endif
+
+   /// Solve A X = B for all the columns of @a B.
+   void Mult(const DenseMatrix &B, DenseMatrix &X) const;
+
+   /// Solve A x = b, i.e. Mult() with a single right-hand side.
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/** @brief Block GMRES method for several right-hand sides.
+
+    The right-hand sides and the solutions are stored as the columns of
+    n x k DenseMatrix objects. Each iteration adds k vectors to the (block)
+    Krylov space and applies the operator and the preconditioner to them at
+    once with Operator::ArrayMult(). Like GMRESSolver, the preconditioner is
+    applied from the left and the reported residual norms are ||B r||. The
+    iteration stops when the residuals of all k right-hand sides satisfy the
+    tolerances. */
+class BlockGMRESSolver : public IterativeSolver
+{
+protected:
+   int m; // see SetKDim()
+
+   /** Orthonormalize the columns of @a W against the first @a nv blocks of
+       @a v and then against each other; the coefficients of W in the new
+       basis are returned in the upper triangular @a R. */
+   void Orthonormalize(DenseMatrix &W, DenseMatrix &R,
+                       Array<DenseMatrix *> &v, int nv) const;
+
+public:
+   BlockGMRESSolver() { m = 50; }
+
+#ifdef MFEM_USE_MPI
+   BlockGMRESSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; }
+#endif
+
+   /** @brief Set the number of (block) iterations to perform between
+       restarts, default is 50. */
+   void SetKDim(int dim) { m = dim; }
+
+   /// Solve A X = B for all the columns of @a B.
+   void Mult(const DenseMatrix &B, DenseMatrix &X) const;
+
+   /// Solve A x = b, i.e. Mult() with a single right-hand side.
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+
+/** @brief Deflated preconditioned conjugate gradient method that recycles a
+    subspace between solves of a sequence of symmetric positive definite
+    systems, e.g. in time stepping or Newton loops.
+
+    The solver keeps a deflation space W, of dimension at most SetRecycleDim(),
+    from one call of Mult() to the next. The initial guess is corrected so
+    that the residual is orthogonal to W, and the search directions are kept
+    A-orthogonal to W, which removes the corresponding (small) eigenvalues
+    from the iteration. After each solve, W is replaced by the harmonic Ritz
+    vectors of the preconditioned operator B A (with respect to the B^{-1}
+    inner product) for the smallest harmonic Ritz values in the space spanned
+    by W and the first SetNumStoredDirections() search directions of the
+    solve. The images B A p of the search directions are obtained from the
+    preconditioned residuals, so no additional operator or preconditioner
+    applications are needed.
+
+    SetOperator() keeps W and only recomputes its image A W, so the space is
+    reused when the operator changes slowly, e.g. with the time step. */
+class DeflatedCGSolver : public IterativeSolver
+{
+protected:
+   int k, max_store;
+   /** The deflation space (A-orthonormal columns), its image under A and,
+       with a preconditioner B, its image under B A. */
+   mutable DenseMatrix W, AW, BAW;
+   /** The search directions stored in Mult(), their images under A and, with
+       a preconditioner, under B A. Sized once, see UpdateVectors(). */
+   mutable DenseMatrix P, AP, BAP;
+   mutable Vector r, d, z, q;
+
+   void UpdateVectors();
+
+   /** Replace W by the harmonic Ritz vectors in the span of W and the first
+       @a np columns of @a P; @a AP and @a BAP are the images of @a P under A
+       and B A. */
+   void UpdateDeflationSpace(const DenseMatrix &P, const DenseMatrix &AP,
+                             const DenseMatrix &BAP, int np) const;
+
+public:
+   DeflatedCGSolver() { k = 10; max_store = 20; }
+
+#ifdef MFEM_USE_MPI
+   DeflatedCGSolver(MPI_Comm _comm) : IterativeSolver(_comm)
+   { k = 10; max_store = 20; }
+#endif
+
+   /// Set the maximum dimension of the deflation space, default is 10.
+   void SetRecycleDim(int dim) { k = dim; }
+
+   /** @brief Set the number of search directions stored in Mult() to update
+       the deflation space, default is 20. */
+   void SetNumStoredDirections(int num) { max_store = num; UpdateVectors(); }
+
+   virtual void SetPreconditioner(Solver &pr)
+   { IterativeSolver::SetPreconditioner(pr); UpdateVectors(); }
+
+   /// Discard the deflation space.
+   void ClearRecycledSpace()
+   { W.SetSize(0, 0); AW.SetSize(0, 0); BAW.SetSize(0, 0); }
+
+   /// Return the deflation space, one vector per column.
+   const DenseMatrix &GetRecycledSpace() const { return W; }
+
+   /** @brief Set the operator; the current deflation space is kept if its
+       size matches and its image under the new operator is recomputed. */
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/** @brief GCRO-DR: GMRES with deflated restarting and subspace recycling
+    between solves of a sequence of (nonsymmetric) systems.
+
+    The solver keeps a recycle space U, of dimension at most SetRecycleDim(),
+    and C = M A U with orthonormal columns, where M is the (left)
+    preconditioner. Each cycle minimizes the residual over the span of U and
+    a Krylov space of dimension m - dim(U) for the operator (I - C C^t) M A.
+    After each cycle, U is replaced by the vectors z of the augmented space
+    that minimize ||M A z|| / ||z||, i.e. the approximate right singular
+    vectors of M A for its smallest singular values. Like GMRESSolver, the
+    reported residual norms are ||M r||.
+
+    SetOperator() keeps U and recomputes C, so the space is reused when the
+    operator changes slowly. The preconditioner should be set before the
+    operator. */
+class GCRODRSolver : public IterativeSolver
+{
+protected:
+   int m, k;
+   /// The recycle space and its image C = M A U (orthonormal columns).
+   mutable DenseMatrix U, C;
+
+   /** Update U and C from the augmented space [U V(:,0:nc-1)], where @a Hc is
+       the (unrotated) Hessenberg matrix and @a Bc = C^t M A V. */
+   void UpdateRecycleSpace(const DenseMatrix &V, const DenseMatrix &Hc,
+                           const DenseMatrix &Bc, int nc) const;
+
+public:
+   GCRODRSolver() { m = 50; k = 10; }
+
+#ifdef MFEM_USE_MPI
+   GCRODRSolver(MPI_Comm _comm) : IterativeSolver(_comm) { m = 50; k = 10; }
+#endif
+
+   /** @brief Set the total dimension of the search space (recycled and
+       Krylov), default is 50. */
+   void SetKDim(int dim) { m = dim; }
+
+   /// Set the maximum dimension of the recycle space, default is 10.
+   void SetRecycleDim(int dim) { k = dim; }
+
+   /// Discard the recycle space.
+   void ClearRecycledSpace() { U.SetSize(0, 0); C.SetSize(0, 0); }
+
+   /// Return the recycle space, one vector per column.
+   const DenseMatrix &GetRecycledSpace() const { return U; }
+
+   /** @brief Set the operator; the current recycle space is kept if its size
+       matches and its image under the new operator is recomputed. */
+   virtual void SetOperator(const Operator &op);
+
+   virtual void Mult(const Vector &b, Vector &x) const;
+};
+
+/** @brief Locally optimal block preconditioned conjugate gradient (LOBPCG)
+    eigensolver for the generalized symmetric eigenvalue problem A x = lambda
+    M x.
+
+    Computes the SetNumModes() smallest eigenpairs of the symmetric operator A
+    (set with SetOperator()) and the symmetric positive definite mass operator
+    M (the identity if SetMassMatrix() is not called). The optional
+    preconditioner should be a symmetric positive definite approximation of
+    A^{-1}. Only the action of the operators on blocks of vectors is needed,
+    see Operator::ArrayMult(), so matrix-free operators, e.g. partially
+    assembled BilinearForm%s, can be used.
+
+    Each iteration performs a Rayleigh-Ritz procedure on the span of the block
+    of approximate eigenvectors X, the preconditioned residuals W and the
+    previous search directions P. The projected matrices [X W P]^t A [X W P]
+    and [X W P]^t M [X W P] are computed with a single (global) reduction each
+    and the projected problem is solved with DenseMatrix::Eigensystem(), after
+    dropping the linearly dependent directions.
+
+    The eigenpair (lambda_j, x_j), with x_j^t M x_j = 1, is converged when
+    ||A x_j - lambda_j M x_j|| <= max(rel_tol |lambda_j|, abs_tol). Converged
+    eigenpairs are softly locked: they remain in the Rayleigh-Ritz basis, but
+    no new search directions are computed for them. The block size may be
+    larger than the number of modes, see SetBlockSize(); the additional vectors
+    accelerate the convergence but are not required to converge.
+
+    GetFinalNorm() returns the largest residual norm of the wanted eigenpairs
+    in the last iteration. Like HypreLOBPCG, the class is not a Solver: the
+    eigenpairs are computed by Solve(). */
+class LOBPCGSolver
+{
+#ifdef MFEM_USE_MPI
+private:
+   bool parallel; // the inner products are global over 'comm'
+   MPI_Comm comm;
+#endif
+
+protected:
+   const Operator *oper, *mass;
+   Solver *prec;
+   int nev, block_size, seed;
+   int max_iter, print_level;
+   double rel_tol, abs_tol;
+
+   // stats
+   int final_iter, converged;
+   double final_norm;
+
+   /// The approximate eigenvectors, one per column.
+   DenseMatrix X;
+   Array<double> eigenvalues;
+
+   void Init();
+
+   /// Compute Y = M X, or copy X if there is no mass operator.
+   void MassMult(const DenseMatrix &X, DenseMatrix &Y) const;
+
+   /// Compute G = V^t W, with a single (global) reduction.
+   void BlockDot(const DenseMatrix &V, const DenseMatrix &W,
+                 DenseMatrix &G) const;
+
+   /** Compute d(j) = (V(:,j), W(:,j)), with a single (global) reduction. */
+   void ColumnDot(const DenseMatrix &V, const DenseMatrix &W, Vector &d) const;
+
+public:
+   LOBPCGSolver();
+
+#ifdef MFEM_USE_MPI
+   /// The inner products are computed globally over @a comm.
+   LOBPCGSolver(MPI_Comm comm);
+#endif
+
+   void SetRelTol(double rtol) { rel_tol = rtol; }
+   void SetAbsTol(double atol) { abs_tol = atol; }
+   void SetMaxIter(int max_it) { max_iter = max_it; }
+   /// In parallel, only the rank 0 prints.
+   void SetPrintLevel(int print_lvl);
+
+   int GetNumIterations() const { return final_iter; }
+   int GetConverged() const { return converged; }
+   double GetFinalNorm() const { return final_norm; }
+
+   /// Set the operator A; it is not owned.
+   void SetOperator(const Operator &A) { oper = &A; }
+
+   /// Set the preconditioner, an approximation of A^{-1}; it is not owned.
+   void SetPreconditioner(Solver &pr)
+   { prec = &pr; prec->iterative_mode = false; }
+
+   /// Set the number of wanted eigenpairs, default is 1.
+   void SetNumModes(int num_eigs) { nev = num_eigs; }
+
+   /** @brief Set the number of approximate eigenvectors iterated together; the
+       actual block size is the maximum of @a bs and the number of modes. */
+   void SetBlockSize(int bs) { block_size = bs; }
+
+   /// Set the seed of the random initial vectors.
+   void SetRandomSeed(int s) { seed = s; }
+
+   /** @brief Set the initial approximate eigenvectors, one per column. Missing
+       columns are initialized randomly. */
+   void SetInitialVectors(const DenseMatrix &X0) { X = X0; }
+
+   /// Set the mass operator M; it is not owned.
+   void SetMassMatrix(const Operator &M) { mass = &M; }
+
+   /** @brief Compute the eigenpairs. The eigenvectors of a previous call are
+       used as initial vectors, if their size matches. */
+   void Solve();
+
+   /// Return the computed eigenvalues, in increasing order.
+   void GetEigenvalues(Array<double> &eigs) const { eigs = eigenvalues; }
+
+   /// Return the eigenvector @a i, normalized such that x^t M x = 1.
+   void GetEigenvector(int i, Vector &x) const { X.GetColumn(i, x); }
+
+   /** @brief Return the approximate eigenvectors, one per column; the first
+       SetNumModes() columns are the computed eigenvectors. */
+   const DenseMatrix &GetEigenvectors() const { return X; }
+};
+
+
 /// BiCGSTAB method
 class BiCGSTABSolver : public IterativeSolver
 {
@@ -296,17 +754,84 @@ void MINRES(const Operator &A, Solver &B, const Vector &b, Vector &x,
 /// Newton's method for solving F(x)=b for a given operator F.
 /** The method GetGradient() must be implemented for the operator F.
     The preconditioner is used (in non-iterative mode) to evaluate
-    the action of the inverse gradient of the operator. */
+    the action of the inverse gradient of the operator.
+
+    In the Jacobian-free Newton-Krylov (JFNK) mode, see SetJacobianFree(), the
+    linear solver must be an IterativeSolver and it is applied to the finite
+    difference approximation of the Jacobian
+       J v = (F(x + h v) - F(x)) / h,  h = eps (1 + ||x||) / ||v||,
+    so GetGradient() is only needed to set up a preconditioner. */
 class NewtonSolver : public IterativeSolver
 {
 protected:
    mutable Vector r, c;
 
+   /// The finite difference approximation of the Jacobian of the operator.
+   class FDJacobian : public Operator
+   {
+   protected:
+      const NewtonSolver &newton;
+      const Vector *x, *fx, *b;
+      double h0;
+      mutable Vector xh, fh;
+
+   public:
+      FDJacobian(const NewtonSolver &n) : newton(n), x(NULL), fx(NULL), b(NULL)
+      { }
+
+      /** Set the point @a x_ of the linearization and the residual
+          @a fx_ = F(x_) - b_ at that point; @a b_ may be NULL. The vectors
+          must stay valid while the operator is used. */
+      void Update(const Vector &x_, const Vector &fx_, const Vector *b_);
+
+      virtual void Mult(const Vector &v, Vector &y) const;
+   };
+
+   /** A preconditioner for the linear solver in JFNK mode that forwards to
+       the user preconditioner; SetOperator() is ignored since the
+       preconditioner is set up with the gradient of the operator. */
+   class JacobianPreconditioner : public Solver
+   {
+   public:
+      Solver *pc;
+
+      JacobianPreconditioner() : pc(NULL) { }
+
+      virtual void SetOperator(const Operator &op) { }
+
+      virtual void Mult(const Vector &x, Vector &y) const
+      { pc->Mult(x, y); }
+   };
+
+   bool jacobian_free;
+   double fd_eps;
+   int jacobian_lag;
+   mutable FDJacobian fd_jac;
+   mutable JacobianPreconditioner jf_prec;
+
+   // Eisenstat-Walker parameters, see SetAdaptiveLinRtol()
+   int lin_rtol_type;
+   double lin_rtol0, lin_rtol_max, ew_alpha, ew_gamma;
+   mutable double fnorm_last, lnorm_last, rtol_last;
+
+   void InitNewton();
+
+   /** Set the relative tolerance of the linear solver for the Newton
+       iteration @a it, with residual norm @a fnorm, see
+       SetAdaptiveLinRtol(). */
+   void AdaptiveLinRtolPreSolve(int it, double fnorm) const;
+
+   /** Compute the norm of the linear residual ||F(x) + J c|| after the linear
+       solve with Jacobian @a J, needed by the type 1 Eisenstat-Walker
+       forcing terms. */
+   void AdaptiveLinRtolPostSolve(const Operator &J) const;
+
 public:
-   NewtonSolver() { }
+   NewtonSolver() : fd_jac(*this) { InitNewton(); }
 
 #ifdef MFEM_USE_MPI
-   NewtonSolver(MPI_Comm _comm) : IterativeSolver(_comm) { }
+   NewtonSolver(MPI_Comm _comm) : IterativeSolver(_comm), fd_jac(*this)
+   { InitNewton(); }
 #endif
    virtual void SetOperator(const Operator &op);
 
@@ -314,6 +839,42 @@ public:
    /** This method is equivalent to calling SetPreconditioner(). */
    virtual void SetSolver(Solver &solver) { prec = &solver; }
 
+   /** @brief Enable (or disable) the Jacobian-free Newton-Krylov mode: the
+       linear solver, which must be an IterativeSolver, is applied to the
+       finite difference approximation of the Jacobian with relative step
+       @a eps, see the class description.
+
+       If @a pc is not NULL, it is used as preconditioner of the linear solver
+       and it is set up with the gradient of the operator, see
+       SetJacobianLag(). The preconditioner must not be set directly on the
+       linear solver. */
+   void SetJacobianFree(bool jf = true, Solver *pc = NULL,
+                        double eps = 1.4901161193847656e-8)
+   { jacobian_free = jf; jf_prec.pc = pc; fd_eps = eps; }
+
+   /** @brief Compute the gradient of the operator only every @a lag Newton
+       iterations (default 1) and reuse it in between. In the JFNK mode, only
+       the preconditioner is lagged; otherwise the lagged gradient is the
+       Jacobian of the linear systems (chord/Shamanskii method). */
+   void SetJacobianLag(int lag) { jacobian_lag = lag; }
+
+   /** @brief Choose the relative tolerance of the linear solver, which must
+       be an IterativeSolver, adaptively with the Eisenstat-Walker forcing
+       terms.
+
+       For Newton iteration k > 0 with residual norm ||F_k||:
+       - type 1: eta_k = | ||F_k|| - ||F_{k-1} + J_{k-1} s_{k-1}|| | /
+                 ||F_{k-1}||, safeguarded by eta_{k-1}^alpha,
+       - type 2: eta_k = gamma (||F_k|| / ||F_{k-1}||)^alpha, safeguarded by
+                 gamma eta_{k-1}^alpha,
+       where the safeguard is applied if it is larger than 0.1. The first
+       tolerance is @a rtol0 and all tolerances are limited by @a rtol_max.
+       Use @a type = 0 to disable. */
+   void SetAdaptiveLinRtol(int type = 2, double rtol0 = 0.5,
+                           double rtol_max = 0.9,
+                           double alpha = 0.5*(1.0 + sqrt(5.0)),
+                           double gamma = 1.0);
+
    /// Solve the nonlinear system with right-hand side @a b.
    /** If `b.Size() != Height()`, then @a b is assumed to be zero. */
    virtual void Mult(const Vector &b, Vector &x) const;
@@ -547,6 +1108,10 @@ private:
    /// Perform the block ILU factorization
    void Factorize();
 
+   /** Compute the level sets of the block triangular solves, used to process
+       independent block rows concurrently in Mult(). */
+   void ComputeLevels();
+
    int block_size;
 
    /// Fill level for block ILU(k) factorizations. Only k=0 is supported.
@@ -572,6 +1137,10 @@ private:
    mutable DenseTensor DB;
    /// Pivot arrays for the LU factorizations given by #DB
    mutable Array<int> ipiv;
+
+   /** Level sets of the forward (L) and backward (U) substitutions: row l of
+       each Table lists the independent block rows of level l. */
+   Table L_levels, U_levels;
 };
 
 #ifdef MFEM_USE_SUITESPARSE
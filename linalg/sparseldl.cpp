@@ -0,0 +1,513 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+// Implementation of the native supernodal sparse LDL^T solver
+
+#include "sparseldl.hpp"
+#include "densemat.hpp"
+
+#include <algorithm>
+#include <climits>
+#include <iterator>
+#include <set>
+#include <vector>
+
+namespace mfem
+{
+
+typedef std::vector<std::vector<int> > AdjacencyList;
+
+// Build the (sorted) adjacency lists of the graph of A + A^T, without loops.
+static void SymmetricGraph(const SparseMatrix &A, AdjacencyList &adj)
+{
+   const int n = A.Height();
+   const int *I = A.GetI(), *J = A.GetJ();
+
+   adj.assign(n, std::vector<int>());
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         const int j = J[k];
+         if (j != i)
+         {
+            adj[i].push_back(j);
+            adj[j].push_back(i);
+         }
+      }
+   }
+   for (int i = 0; i < n; i++)
+   {
+      std::sort(adj[i].begin(), adj[i].end());
+      adj[i].erase(std::unique(adj[i].begin(), adj[i].end()), adj[i].end());
+   }
+}
+
+// Minimum degree ordering computed on the explicit elimination graph. When a
+// node is eliminated, its neighbors become a clique. Ties are broken by the
+// node index, so the ordering is deterministic.
+static void MinimumDegreeOrdering(AdjacencyList adj, Array<int> &perm)
+{
+   const int n = adj.size();
+   std::set<std::pair<int, int> > queue;
+   for (int i = 0; i < n; i++)
+   {
+      queue.insert(std::make_pair((int) adj[i].size(), i));
+   }
+
+   perm.SetSize(n);
+   std::vector<int> merged;
+   for (int k = 0; k < n; k++)
+   {
+      const int p = queue.begin()->second;
+      queue.erase(queue.begin());
+      perm[k] = p;
+
+      // The adjacency lists contain only non-eliminated nodes.
+      const std::vector<int> &nbr = adj[p];
+      for (std::size_t i = 0; i < nbr.size(); i++)
+      {
+         const int u = nbr[i];
+         std::vector<int> &adj_u = adj[u];
+         queue.erase(std::make_pair((int) adj_u.size(), u));
+
+         merged.clear();
+         std::set_union(adj_u.begin(), adj_u.end(), nbr.begin(), nbr.end(),
+                        std::back_inserter(merged));
+         adj_u.clear();
+         for (std::size_t j = 0; j < merged.size(); j++)
+         {
+            if (merged[j] != u && merged[j] != p) { adj_u.push_back(merged[j]); }
+         }
+         queue.insert(std::make_pair((int) adj_u.size(), u));
+      }
+      std::vector<int>().swap(adj[p]);
+   }
+}
+
+// Elimination tree of the permuted matrix (Liu's algorithm with path
+// compression). The root(s) have parent -1.
+static void EliminationTree(const AdjacencyList &adj, const Array<int> &perm,
+                            const Array<int> &iperm, Array<int> &parent)
+{
+   const int n = perm.Size();
+   Array<int> ancestor(n);
+   parent.SetSize(n);
+   for (int k = 0; k < n; k++)
+   {
+      parent[k] = -1;
+      ancestor[k] = -1;
+      const std::vector<int> &nbr = adj[perm[k]];
+      for (std::size_t m = 0; m < nbr.size(); m++)
+      {
+         int r = iperm[nbr[m]];
+         if (r >= k) { continue; }
+         while (ancestor[r] != -1 && ancestor[r] != k)
+         {
+            const int next = ancestor[r];
+            ancestor[r] = k;
+            r = next;
+         }
+         if (ancestor[r] == -1)
+         {
+            ancestor[r] = k;
+            parent[r] = k;
+         }
+      }
+   }
+}
+
+// Postorder of a forest given by its parent array: post[k] is the k-th node.
+static void Postorder(const Array<int> &parent, Array<int> &post)
+{
+   const int n = parent.Size();
+   Array<int> head(n), next(n), stack;
+   head = -1;
+   for (int j = n-1; j >= 0; j--)
+   {
+      if (parent[j] != -1)
+      {
+         next[j] = head[parent[j]];
+         head[parent[j]] = j;
+      }
+   }
+   post.SetSize(n);
+   int k = 0;
+   for (int j = 0; j < n; j++)
+   {
+      if (parent[j] != -1) { continue; }
+      stack.Append(j);
+      while (stack.Size() > 0)
+      {
+         const int p = stack.Last();
+         const int c = head[p];
+         if (c == -1)
+         {
+            stack.DeleteLast();
+            post[k++] = p;
+         }
+         else
+         {
+            head[p] = next[c];
+            stack.Append(c);
+         }
+      }
+   }
+}
+
+SparseLDLSolver::SparseLDLSolver(Ordering ordering_)
+   : ordering(ordering_) { }
+
+SparseLDLSolver::SparseLDLSolver(const SparseMatrix &A, Ordering ordering_)
+   : ordering(ordering_)
+{
+   SetOperator(A);
+}
+
+void SparseLDLSolver::SetOperator(const Operator &op)
+{
+   const SparseMatrix *A = dynamic_cast<const SparseMatrix *>(&op);
+   if (A == NULL)
+   {
+      MFEM_ABORT("SparseLDLSolver::SetOperator : not a SparseMatrix!");
+   }
+   if (!SamePattern(*A))
+   {
+      SymbolicFactorization(*A);
+   }
+   NumericFactorization(*A);
+}
+
+bool SparseLDLSolver::SamePattern(const SparseMatrix &A) const
+{
+   const int n = A.Height();
+   if (A_I.Size() != n+1 || A.Width() != n) { return false; }
+   const int *I = A.GetI(), *J = A.GetJ();
+   if (!std::equal(I, I+n+1, A_I.GetData())) { return false; }
+   return std::equal(J, J+I[n], A_J.GetData());
+}
+
+void SparseLDLSolver::SymbolicFactorization(const SparseMatrix &A)
+{
+   MFEM_VERIFY(A.Finalized(), "Matrix must be finalized.");
+   MFEM_VERIFY(A.Height() == A.Width(), "Matrix must be square.");
+
+   const int n = A.Height();
+   height = width = n;
+
+   AdjacencyList adj;
+   SymmetricGraph(A, adj);
+
+   if (ordering == Ordering::MINIMUM_DEGREE)
+   {
+      MinimumDegreeOrdering(adj, perm);
+   }
+   else
+   {
+      perm.SetSize(n);
+      for (int i = 0; i < n; i++) { perm[i] = i; }
+   }
+   iperm.SetSize(n);
+   for (int k = 0; k < n; k++) { iperm[perm[k]] = k; }
+
+   // Postorder the elimination tree: the resulting equivalent ordering has
+   // the same fill, but numbers the columns of each supernode consecutively.
+   Array<int> parent, post;
+   EliminationTree(adj, perm, iperm, parent);
+   Postorder(parent, post);
+   {
+      Array<int> old_perm(perm), ipost(n);
+      for (int k = 0; k < n; k++)
+      {
+         perm[k] = old_perm[post[k]];
+         ipost[post[k]] = k;
+      }
+      for (int k = 0; k < n; k++) { iperm[perm[k]] = k; }
+      Array<int> old_parent(parent);
+      for (int k = 0; k < n; k++)
+      {
+         const int p = old_parent[post[k]];
+         parent[k] = (p == -1) ? -1 : ipost[p];
+      }
+   }
+
+   // Row structure of the columns of L (strictly below the diagonal):
+   // struct(j) = {i > j: A(i,j) != 0} U {struct(c) \ {j}: parent[c] = j}.
+   // Children have smaller indices than their parents. The structure of a
+   // column that is merged in the supernode of its parent is not needed
+   // anymore and is released.
+   Array<int> num_children(n), col_count(n), mark(n);
+   num_children = 0;
+   mark = -1;
+   for (int j = 0; j < n; j++)
+   {
+      if (parent[j] != -1) { num_children[parent[j]]++; }
+   }
+   std::vector<std::vector<int> > cstruct(n);
+   std::vector<std::vector<int> > children(n);
+   for (int j = 0; j < n; j++)
+   {
+      if (parent[j] != -1) { children[parent[j]].push_back(j); }
+   }
+   Array<int> sn_start(n);
+   for (int j = 0; j < n; j++)
+   {
+      std::vector<int> &sj = cstruct[j];
+      mark[j] = j;
+      const std::vector<int> &nbr = adj[perm[j]];
+      for (std::size_t m = 0; m < nbr.size(); m++)
+      {
+         const int i = iperm[nbr[m]];
+         if (i > j && mark[i] != j) { mark[i] = j; sj.push_back(i); }
+      }
+      for (std::size_t c = 0; c < children[j].size(); c++)
+      {
+         const std::vector<int> &sc = cstruct[children[j][c]];
+         for (std::size_t m = 0; m < sc.size(); m++)
+         {
+            const int i = sc[m];
+            if (mark[i] != j) { mark[i] = j; sj.push_back(i); }
+         }
+      }
+      std::sort(sj.begin(), sj.end());
+      col_count[j] = sj.size();
+
+      // Fundamental supernodes: column j-1 joins the supernode of column j
+      // if j is its parent, its only child and struct(j-1) = {j} U struct(j).
+      sn_start[j] = !(j > 0 && parent[j-1] == j && num_children[j] == 1 &&
+                      col_count[j-1] == col_count[j] + 1);
+      if (!sn_start[j]) { std::vector<int>().swap(cstruct[j-1]); }
+   }
+
+   // Supernode partition and structure.
+   int num_sn = 0;
+   for (int j = 0; j < n; j++) { num_sn += sn_start[j]; }
+   sn_ptr.SetSize(num_sn+1);
+   col_sn.SetSize(n);
+   for (int j = 0, s = -1; j < n; j++)
+   {
+      if (sn_start[j]) { sn_ptr[++s] = j; }
+      col_sn[j] = s;
+   }
+   sn_ptr[num_sn] = n;
+
+   sn_rows.MakeI(num_sn);
+   for (int s = 0; s < num_sn; s++)
+   {
+      sn_rows.AddColumnsInRow(s, cstruct[sn_ptr[s+1]-1].size());
+   }
+   sn_rows.MakeJ();
+   for (int s = 0; s < num_sn; s++)
+   {
+      const std::vector<int> &rows = cstruct[sn_ptr[s+1]-1];
+      sn_rows.AddConnections(s, rows.data(), rows.size());
+   }
+   sn_rows.ShiftUpI();
+
+   L_offset.SetSize(num_sn+1);
+   long offset = 0;
+   for (int s = 0; s < num_sn; s++)
+   {
+      const long nc = sn_ptr[s+1] - sn_ptr[s], nb = sn_rows.RowSize(s);
+      L_offset[s] = offset;
+      offset += nc*(nc + nb);
+      MFEM_VERIFY(offset <= INT_MAX, "SparseLDLSolver: the factor is too large");
+   }
+   L_offset[num_sn] = offset;
+
+   // Map the lower triangle of A, in the original ordering, to the supernode
+   // blocks. An entry (i,j) with j <= i goes to the row max(pi,pj) and the
+   // column min(pi,pj) of the permuted factor.
+   const int *I = A.GetI(), *J = A.GetJ();
+   A_to_L.SetSize(I[n]);
+   for (int i = 0; i < n; i++)
+   {
+      for (int k = I[i]; k < I[i+1]; k++)
+      {
+         if (J[k] > i)
+         {
+            A_to_L[k] = -1;
+            continue;
+         }
+         const int pi = std::max(iperm[i], iperm[J[k]]);
+         const int pj = std::min(iperm[i], iperm[J[k]]);
+         const int s = col_sn[pj];
+         const int f = sn_ptr[s], nc = sn_ptr[s+1] - f, nb = sn_rows.RowSize(s);
+         const int c = pj - f;
+         if (pi < f + nc)
+         {
+            A_to_L[k] = L_offset[s] + (pi - f) + c*nc;
+         }
+         else
+         {
+            const int *rows = sn_rows.GetRow(s);
+            const int r = std::lower_bound(rows, rows + nb, pi) - rows;
+            MFEM_ASSERT(r < nb && rows[r] == pi, "invalid structure");
+            A_to_L[k] = L_offset[s] + nc*nc + r + c*nb;
+         }
+      }
+   }
+
+   A_I.SetSize(n+1);
+   A_I.Assign(I);
+   A_J.SetSize(I[n]);
+   A_J.Assign(J);
+}
+
+void SparseLDLSolver::NumericFactorization(const SparseMatrix &A)
+{
+   MFEM_VERIFY(SamePattern(A), "SparseLDLSolver: the sparsity pattern of the "
+               "matrix differs from the one given to SymbolicFactorization");
+
+   const int n = height;
+   const int num_sn = GetNumSupernodes();
+   const double *A_data = A.GetData();
+
+   L.SetSize(L_offset[num_sn]);
+   L = 0.0;
+   for (int k = 0; k < A_to_L.Size(); k++)
+   {
+      if (A_to_L[k] >= 0) { L(A_to_L[k]) += A_data[k]; }
+   }
+   D.SetSize(n);
+
+   Array<int> map(n);
+   DenseMatrix Lb_view, LbD, W;
+   for (int s = 0; s < num_sn; s++)
+   {
+      const int f = sn_ptr[s], nc = sn_ptr[s+1] - f, nb = sn_rows.RowSize(s);
+      const int *rows = sn_rows.GetRow(s);
+      double *Ld = L.GetData() + L_offset[s];
+      double *Lb = Ld + nc*nc;
+      double *d = D.GetData() + f;
+
+      // Dense LDL^T factorization of the diagonal block and computation of
+      // the off-diagonal block, column by column (left-looking).
+      for (int k = 0; k < nc; k++)
+      {
+         for (int m = 0; m < k; m++)
+         {
+            const double lkm = Ld[k+m*nc]*d[m];
+            for (int i = k; i < nc; i++) { Ld[i+k*nc] -= Ld[i+m*nc]*lkm; }
+            for (int i = 0; i < nb; i++) { Lb[i+k*nb] -= Lb[i+m*nb]*lkm; }
+         }
+         d[k] = Ld[k+k*nc];
+         MFEM_VERIFY(d[k] != 0.0, "SparseLDLSolver: zero pivot at row "
+                     << perm[f+k]);
+         const double d_inv = 1.0/d[k];
+         Ld[k+k*nc] = 1.0;
+         for (int i = k+1; i < nc; i++) { Ld[i+k*nc] *= d_inv; }
+         for (int i = 0; i < nb; i++) { Lb[i+k*nb] *= d_inv; }
+      }
+      if (nb == 0) { continue; }
+
+      // Update matrix W = L_b D L_b^T, subtracted from the ancestors.
+      Lb_view.UseExternalData(Lb, nb, nc);
+      LbD = Lb_view;
+      for (int k = 0; k < nc; k++)
+      {
+         for (int i = 0; i < nb; i++) { LbD(i,k) *= d[k]; }
+      }
+      W.SetSize(nb);
+      MultABt(Lb_view, LbD, W);
+
+      // Scatter the lower triangle of W. The rows of supernode s that belong
+      // to the same target supernode t are consecutive.
+      for (int j = 0; j < nb; )
+      {
+         const int t = col_sn[rows[j]];
+         const int tf = sn_ptr[t], tnc = sn_ptr[t+1] - tf;
+         const int tnb = sn_rows.RowSize(t);
+         const int *trows = sn_rows.GetRow(t);
+         double *tLd = L.GetData() + L_offset[t];
+         double *tLb = tLd + tnc*tnc;
+         for (int r = 0; r < tnb; r++) { map[trows[r]] = r; }
+         for ( ; j < nb && rows[j] < tf + tnc; j++)
+         {
+            const int c = rows[j] - tf;
+            for (int i = j; i < nb; i++)
+            {
+               const int r = rows[i];
+               if (r < tf + tnc)
+               {
+                  tLd[(r-tf)+c*tnc] -= W(i,j);
+               }
+               else
+               {
+                  tLb[map[r]+c*tnb] -= W(i,j);
+               }
+            }
+         }
+      }
+   }
+}
+
+void SparseLDLSolver::Mult(const Vector &b, Vector &x) const
+{
+   MFEM_ASSERT(D.Size() == height, "SparseLDLSolver is not factorized");
+
+   const int n = height;
+   const int num_sn = GetNumSupernodes();
+   y.SetSize(n);
+   for (int k = 0; k < n; k++) { y(k) = b(perm[k]); }
+
+   // Forward substitution: L y = P b
+   for (int s = 0; s < num_sn; s++)
+   {
+      const int f = sn_ptr[s], nc = sn_ptr[s+1] - f, nb = sn_rows.RowSize(s);
+      const int *rows = sn_rows.GetRow(s);
+      const double *Ld = L.GetData() + L_offset[s];
+      const double *Lb = Ld + nc*nc;
+      double *ys = y.GetData() + f;
+      for (int k = 0; k < nc; k++)
+      {
+         const double yk = ys[k];
+         for (int i = k+1; i < nc; i++) { ys[i] -= Ld[i+k*nc]*yk; }
+         for (int i = 0; i < nb; i++) { y(rows[i]) -= Lb[i+k*nb]*yk; }
+      }
+   }
+
+   // Diagonal scaling: D z = y
+   for (int k = 0; k < n; k++) { y(k) /= D(k); }
+
+   // Backward substitution: L^T P x = z
+   for (int s = num_sn-1; s >= 0; s--)
+   {
+      const int f = sn_ptr[s], nc = sn_ptr[s+1] - f, nb = sn_rows.RowSize(s);
+      const int *rows = sn_rows.GetRow(s);
+      const double *Ld = L.GetData() + L_offset[s];
+      const double *Lb = Ld + nc*nc;
+      double *ys = y.GetData() + f;
+      for (int k = nc-1; k >= 0; k--)
+      {
+         double yk = ys[k];
+         for (int i = k+1; i < nc; i++) { yk -= Ld[i+k*nc]*ys[i]; }
+         for (int i = 0; i < nb; i++) { yk -= Lb[i+k*nb]*y(rows[i]); }
+         ys[k] = yk;
+      }
+   }
+
+   x.SetSize(n);
+   for (int k = 0; k < n; k++) { x(perm[k]) = y(k); }
+}
+
+long SparseLDLSolver::GetFactorNNZ() const
+{
+   long nnz = 0;
+   for (int s = 0; s < GetNumSupernodes(); s++)
+   {
+      const long nc = sn_ptr[s+1] - sn_ptr[s], nb = sn_rows.RowSize(s);
+      nnz += nc*(nc+1)/2 + nb*nc;
+   }
+   return nnz;
+}
+
+}
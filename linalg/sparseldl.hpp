@@ -0,0 +1,131 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#ifndef MFEM_SPARSELDL
+#define MFEM_SPARSELDL
+
+#include "../config/config.hpp"
+#include "../general/table.hpp"
+#include "operator.hpp"
+#include "sparsemat.hpp"
+
+namespace mfem
+{
+
+/** @brief Direct solver for symmetric sparse matrices based on a supernodal
+    LDL^T factorization.
+
+    The solver does not depend on any external library. The factorization is
+    split in two phases:
+
+    - SymbolicFactorization() computes a fill-reducing ordering (minimum
+      degree on the graph of the matrix), the elimination tree, the structure
+      of the factor L and its partition into (fundamental) supernodes.
+
+    - NumericFactorization() computes the values of L and D, supernode by
+      supernode, using dense kernels for the diagonal blocks and for the
+      updates of the ancestor supernodes (these use BLAS when MFEM is built
+      with LAPACK).
+
+    The symbolic factorization is reused by SetOperator() when the new matrix
+    has the same sparsity pattern as the previous one. No pivoting is
+    performed, so the matrix should be symmetric positive definite (or, more
+    generally, strongly factorizable, e.g. symmetric quasi-definite). Only the
+    lower triangular part of the matrix (in the original ordering) is used, so
+    the matrix can be given either with full symmetric storage or as its lower
+    triangle. */
+class SparseLDLSolver : public Solver
+{
+public:
+   /// The fill-reducing ordering used by the symbolic factorization.
+   enum class Ordering
+   {
+      MINIMUM_DEGREE,
+      NATURAL
+   };
+
+   /** Create an "empty" solver. SetOperator must be called later to actually
+       form the factorization. */
+   SparseLDLSolver(Ordering ordering_ = Ordering::MINIMUM_DEGREE);
+
+   /// Create a solver and factorize the matrix @a A.
+   SparseLDLSolver(const SparseMatrix &A,
+                   Ordering ordering_ = Ordering::MINIMUM_DEGREE);
+
+   /** @brief Factorize the given Operator @a op which must be a finalized
+       SparseMatrix. The symbolic factorization is recomputed only if the
+       sparsity pattern of @a op differs from the previous one. */
+   virtual void SetOperator(const Operator &op);
+
+   /** @brief Compute the ordering and the structure of the factorization for
+       the sparsity pattern of @a A. */
+   void SymbolicFactorization(const SparseMatrix &A);
+
+   /** @brief Compute the numerical values of the factorization of @a A, which
+       must have the sparsity pattern given to SymbolicFactorization(). */
+   void NumericFactorization(const SparseMatrix &A);
+
+   /// Solve the system A x = b using the LDL^T factorization.
+   virtual void Mult(const Vector &b, Vector &x) const;
+
+   /// Since A is symmetric, this is the same as Mult().
+   virtual void MultTranspose(const Vector &b, Vector &x) const
+   { Mult(b, x); }
+
+   /** @brief Return the permutation used by the factorization: the k-th pivot
+       is row/column @a perm[k] of the original matrix. */
+   const Array<int> &GetPermutation() const { return perm; }
+
+   /// Return the number of supernodes of the factorization.
+   int GetNumSupernodes() const { return sn_ptr.Size() - 1; }
+
+   /// Return the number of nonzero entries in the lower triangle of L + D.
+   long GetFactorNNZ() const;
+
+protected:
+   Ordering ordering;
+
+   /// Permutation and inverse permutation, see GetPermutation().
+   Array<int> perm, iperm;
+
+   /** Supernodes: supernode s contains the columns sn_ptr[s], ...,
+       sn_ptr[s+1]-1 of the permuted matrix. */
+   Array<int> sn_ptr;
+   /// The supernode containing each column of the permuted matrix.
+   Array<int> col_sn;
+   /** Row s of the table lists the rows (in the permuted numbering, sorted)
+       below the diagonal block of supernode s. */
+   Table sn_rows;
+   /** Offsets of the supernodes in #L: the diagonal block of supernode s (of
+       size nc x nc, column-major) starts at L[L_offset[s]] and is followed by
+       the nb x nc off-diagonal block (column-major), where nc is the number
+       of columns and nb the number of rows below the diagonal block. */
+   Array<int> L_offset;
+   /// Position in #L of each entry of the lower triangle of A, -1 otherwise.
+   Array<int> A_to_L;
+
+   /// Sparsity pattern of the last analyzed matrix.
+   Array<int> A_I, A_J;
+
+   /// Numerical values of the factors.
+   Vector L, D;
+
+   /// Temporary vector used in Mult().
+   mutable Vector y;
+
+   /** Check if the sparsity pattern of @a A is the same as the one used in the
+       last call to SymbolicFactorization(). */
+   bool SamePattern(const SparseMatrix &A) const;
+};
+
+}
+
+#endif
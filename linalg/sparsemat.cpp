@@ -613,6 +613,77 @@ void SparseMatrix::AddMult(const Vector &x, Vector &y, const double a) const
 #endif
 }
 
+void SparseMatrix::ArrayMult(const Array<const Vector *> &X,
+                             Array<Vector *> &Y) const
+{
+   MFEM_ASSERT(X.Size() == Y.Size(), "incompatible sizes");
+   const int k = X.Size();
+   if (!Finalized() || k == 1)
+   {
+      Operator::ArrayMult(X, Y);
+      return;
+   }
+
+#ifndef MFEM_USE_LEGACY_OPENMP
+   const int height = this->height;
+   const int nnz = J.Capacity();
+   auto d_I = Read(I, height+1);
+   auto d_J = Read(J, nnz);
+   auto d_A = Read(A, nnz);
+   // the (device) pointers to the vectors
+   Array<const double *> xp(k);
+   Array<double *> yp(k);
+   for (int j = 0; j < k; j++)
+   {
+      MFEM_ASSERT(X[j]->Size() == width && Y[j]->Size() == height,
+                  "incompatible dimensions");
+      Y[j]->UseDevice(true);
+      xp[j] = X[j]->Read();
+      yp[j] = Y[j]->Write();
+   }
+   auto d_x = xp.Read();
+   auto d_y = yp.Read();
+   MFEM_FORALL(i, height,
+   {
+      for (int j = 0; j < k; j++) { d_y[j][i] = 0.0; }
+      for (int p = d_I[i]; p < d_I[i+1]; p++)
+      {
+         const double a = d_A[p];
+         const int c = d_J[p];
+         for (int j = 0; j < k; j++) { d_y[j][i] += a * d_x[j][c]; }
+      }
+   });
+#else
+   const int nnz = J.Capacity();
+   const int *Ip = HostRead(I, height+1);
+   const int *Jp = HostRead(J, nnz);
+   const double *Ap = HostRead(A, nnz);
+   Array<const double *> xp(k);
+   Array<double *> yp(k);
+   for (int j = 0; j < k; j++)
+   {
+      MFEM_ASSERT(X[j]->Size() == width && Y[j]->Size() == height,
+                  "incompatible dimensions");
+      xp[j] = X[j]->HostRead();
+      yp[j] = Y[j]->HostWrite();
+   }
+   const double **xpp = xp.GetData();
+   double **ypp = yp.GetData();
+
+   #pragma omp parallel for
+   for (int i = 0; i < height; i++)
+   {
+      for (int j = 0; j < k; j++) { ypp[j][i] = 0.0; }
+      for (int p = Ip[i]; p < Ip[i+1]; p++)
+      {
+         const double a = Ap[p];
+         const int c = Jp[p];
+         for (int j = 0; j < k; j++) { ypp[j][i] += a * xpp[j][c]; }
+      }
+   }
+#endif
+}
+
 void SparseMatrix::MultTranspose(const Vector &x, Vector &y) const
 {
    if (Finalized()) { y.UseDevice(true); }
@@ -2074,6 +2145,141 @@ void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y) const
    }
 }
 
+void SparseMatrix::GetGaussSeidelLevels(Table &levels) const
+{
+   MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+   MFEM_VERIFY(height == width, "Matrix must be square.");
+
+   const int s = height;
+   const int *Ip = HostRead(I, s+1);
+   const int *Jp = HostRead(J, J.Capacity());
+
+   // Row i depends on all rows c < i with A(i,c) != 0 or A(c,i) != 0. The
+   // rows are visited in increasing order, so when row i is reached its level
+   // is final and can be pushed to the rows c > i that it is coupled with.
+   Array<int> level(s);
+   level = 0;
+   int num_levels = 0;
+   for (int i = 0; i < s; i++)
+   {
+      int lev = level[i];
+      for (int j = Ip[i]; j < Ip[i+1]; j++)
+      {
+         const int c = Jp[j];
+         if (c < i) { lev = std::max(lev, level[c] + 1); }
+      }
+      level[i] = lev;
+      for (int j = Ip[i]; j < Ip[i+1]; j++)
+      {
+         const int c = Jp[j];
+         if (c > i) { level[c] = std::max(level[c], lev + 1); }
+      }
+      num_levels = std::max(num_levels, lev + 1);
+   }
+
+   Transpose(level, levels, num_levels);
+}
+
+// Gauss-Seidel update of row i of a finalized matrix; returns false if the
+// row has a zero diagonal entry and the update is not well defined.
+static inline bool GaussSeidelRow(const int i, const int *Ip, const int *Jp,
+                                  const double *Ap, const double *xp,
+                                  double *yp)
+{
+   double sum = 0.0;
+   int d = -1;
+   for (int j = Ip[i]; j < Ip[i+1]; j++)
+   {
+      const int c = Jp[j];
+      if (c == i)
+      {
+         d = j;
+      }
+      else
+      {
+         sum += Ap[j] * yp[c];
+      }
+   }
+
+   if (d >= 0 && Ap[d] != 0.0)
+   {
+      yp[i] = (xp[i] - sum) / Ap[d];
+   }
+   else if (xp[i] == sum)
+   {
+      yp[i] = sum;
+   }
+   else
+   {
+      return false;
+   }
+   return true;
+}
+
+void SparseMatrix::Gauss_Seidel_forw(const Vector &x, Vector &y,
+                                     const Table &levels) const
+{
+   MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+
+   const int s = height;
+   const int nnz = J.Capacity();
+   const int *Ip = HostRead(I, s+1);
+   const int *Jp = HostRead(J, nnz);
+   const double *Ap = HostRead(A, nnz);
+   double *yp = y.HostReadWrite();
+   const double *xp = x.HostRead();
+
+   bool ok = true;
+   for (int l = 0; l < levels.Size(); l++)
+   {
+      const int *rows = levels.GetRow(l);
+      const int nrows = levels.RowSize(l);
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel for reduction(&&:ok)
+#endif
+      for (int k = 0; k < nrows; k++)
+      {
+         ok = GaussSeidelRow(rows[k], Ip, Jp, Ap, xp, yp) && ok;
+      }
+   }
+   if (!ok)
+   {
+      mfem_error("SparseMatrix::Gauss_Seidel_forw(...) #3");
+   }
+}
+
+void SparseMatrix::Gauss_Seidel_back(const Vector &x, Vector &y,
+                                     const Table &levels) const
+{
+   MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
+
+   const int s = height;
+   const int nnz = J.Capacity();
+   const int *Ip = HostRead(I, s+1);
+   const int *Jp = HostRead(J, nnz);
+   const double *Ap = HostRead(A, nnz);
+   double *yp = y.HostReadWrite();
+   const double *xp = x.HostRead();
+
+   bool ok = true;
+   for (int l = levels.Size()-1; l >= 0; l--)
+   {
+      const int *rows = levels.GetRow(l);
+      const int nrows = levels.RowSize(l);
+#ifdef MFEM_USE_LEGACY_OPENMP
+      #pragma omp parallel for reduction(&&:ok)
+#endif
+      for (int k = 0; k < nrows; k++)
+      {
+         ok = GaussSeidelRow(rows[k], Ip, Jp, Ap, xp, yp) && ok;
+      }
+   }
+   if (!ok)
+   {
+      mfem_error("SparseMatrix::Gauss_Seidel_back(...) #3");
+   }
+}
+
 double SparseMatrix::GetJacobiScaling() const
 {
    MFEM_VERIFY(Finalized(), "Matrix must be finalized.");
@@ -270,6 +270,14 @@ public:
    /// Multiply a vector with the transposed matrix. y = At * x
    void MultTranspose(const Vector &x, Vector &y) const;
 
+   /** @brief Multiply a set of vectors with the matrix: Y[i] = A * X[i].
+
+       For a finalized matrix, this is a sparse matrix - multivector product
+       (SpMM) that reads the matrix once for all vectors. Like Mult(), it runs
+       on the device when the vectors use it. */
+   virtual void ArrayMult(const Array<const Vector *> &X,
+                          Array<Vector *> &Y) const;
+
    /// y += At * x (default)  or  y += a * At * x
    void AddMultTranspose(const Vector &x, Vector &y,
                          const double a = 1.0) const;
@@ -395,6 +403,25 @@ public:
    void Gauss_Seidel_forw(const Vector &x, Vector &y) const;
    void Gauss_Seidel_back(const Vector &x, Vector &y) const;
 
+   /** @brief Compute the level sets (wavefronts) of the Gauss-Seidel sweeps.
+
+       Row i of the returned Table @a levels lists the matrix rows of level i,
+       in increasing order. All rows in one level are independent, i.e. they
+       can be updated concurrently by both the forward sweep (levels traversed
+       in increasing order) and the backward sweep (levels traversed in
+       decreasing order). The levels are computed on the symmetrized sparsity
+       pattern, so the level-scheduled sweeps below produce exactly the same
+       result as the sequential ones. The matrix must be finalized. */
+   void GetGaussSeidelLevels(Table &levels) const;
+
+   /** @brief Level-scheduled Gauss-Seidel forward and backward iterations,
+       using the level sets computed by GetGaussSeidelLevels(). The rows in
+       each level are processed in parallel when OpenMP is enabled. */
+   void Gauss_Seidel_forw(const Vector &x, Vector &y,
+                          const Table &levels) const;
+   void Gauss_Seidel_back(const Vector &x, Vector &y,
+                          const Table &levels) const;
+
    /// Determine appropriate scaling for Jacobi iteration
    double GetJacobiScaling() const;
    /** One scaled Jacobi iteration for the system A x = b.
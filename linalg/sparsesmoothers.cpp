@@ -31,6 +31,45 @@ void SparseSmoother::SetOperator(const Operator &a)
    width = oper->Width();
 }
 
+#ifdef MFEM_USE_OPENMP
+static const bool gs_default_levels = true;
+#else
+static const bool gs_default_levels = false;
+#endif
+
+GSSmoother::GSSmoother(int t, int it)
+   : type(t), iterations(it), use_levels(gs_default_levels) { }
+
+GSSmoother::GSSmoother(const SparseMatrix &a, int t, int it)
+   : SparseSmoother(a), type(t), iterations(it), use_levels(gs_default_levels)
+{
+   SetupLevels();
+}
+
+void GSSmoother::SetupLevels()
+{
+   if (use_levels && oper && oper->Finalized())
+   {
+      oper->GetGaussSeidelLevels(levels);
+   }
+   else
+   {
+      levels.Clear();
+   }
+}
+
+void GSSmoother::SetLevelScheduling(bool use_levels_)
+{
+   use_levels = use_levels_;
+   SetupLevels();
+}
+
+void GSSmoother::SetOperator(const Operator &a)
+{
+   SparseSmoother::SetOperator(a);
+   SetupLevels();
+}
+
 /// Matrix vector multiplication with GS Smoother.
 void GSSmoother::Mult(const Vector &x, Vector &y) const
 {
@@ -38,15 +77,18 @@ void GSSmoother::Mult(const Vector &x, Vector &y) const
    {
       y = 0.0;
    }
+   const bool lev = (levels.Size() > 0);
    for (int i = 0; i < iterations; i++)
    {
       if (type != 2)
       {
-         oper->Gauss_Seidel_forw(x, y);
+         if (lev) { oper->Gauss_Seidel_forw(x, y, levels); }
+         else { oper->Gauss_Seidel_forw(x, y); }
       }
       if (type != 1)
       {
-         oper->Gauss_Seidel_back(x, y);
+         if (lev) { oper->Gauss_Seidel_back(x, y, levels); }
+         else { oper->Gauss_Seidel_back(x, y); }
       }
    }
 }
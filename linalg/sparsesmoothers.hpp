@@ -39,13 +39,29 @@ protected:
    int type; // 0, 1, 2 - symmetric, forward, backward
    int iterations;
 
+   /// Use level-scheduled (threaded) sweeps, see SetLevelScheduling().
+   bool use_levels;
+   /// Level sets of the sweeps, computed once in SetOperator().
+   Table levels;
+
+   void SetupLevels();
+
 public:
    /// Create GSSmoother.
-   GSSmoother(int t = 0, int it = 1) { type = t; iterations = it; }
+   GSSmoother(int t = 0, int it = 1);
 
    /// Create GSSmoother.
-   GSSmoother(const SparseMatrix &a, int t = 0, int it = 1)
-      : SparseSmoother(a) { type = t; iterations = it; }
+   GSSmoother(const SparseMatrix &a, int t = 0, int it = 1);
+
+   /** @brief Enable or disable the level-scheduled sweeps.
+
+       When enabled, the level sets of the matrix are computed once (in
+       SetOperator) and the rows in each level are updated in parallel when
+       OpenMP is enabled. The result is identical to the sequential sweeps.
+       This is enabled by default when MFEM is built with OpenMP. */
+   void SetLevelScheduling(bool use_levels_);
+
+   virtual void SetOperator(const Operator &a);
 
    /// Matrix vector multiplication with GS Smoother.
    virtual void Mult(const Vector &x, Vector &y) const;
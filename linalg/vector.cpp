@@ -1130,6 +1130,246 @@ vector_min_cpu:
 }
 
 
+// The host multi-vector kernels process the entries in chunks that stay in
+// cache while they are combined with all vectors, four vectors at a time, so
+// that the single vector is loaded from memory only once. With
+// MFEM_USE_LEGACY_OPENMP, the chunks are distributed among the OpenMP threads.
+static const int MULTI_VEC_CHUNK = 1024;
+
+// d[j] += x * y[j] over the entries [i0,i1), j = 0,...,k-1
+static void HostMultiDotChunk(int i0, int i1, const double *x,
+                              const double *const *y, int k, double *d)
+{
+   int j = 0;
+   for ( ; j + 4 <= k; j += 4)
+   {
+      const double *y0 = y[j], *y1 = y[j+1], *y2 = y[j+2], *y3 = y[j+3];
+      double s0 = 0.0, s1 = 0.0, s2 = 0.0, s3 = 0.0;
+      for (int i = i0; i < i1; i++)
+      {
+         const double xi = x[i];
+         s0 += xi*y0[i];
+         s1 += xi*y1[i];
+         s2 += xi*y2[i];
+         s3 += xi*y3[i];
+      }
+      d[j] += s0;
+      d[j+1] += s1;
+      d[j+2] += s2;
+      d[j+3] += s3;
+   }
+   for ( ; j < k; j++)
+   {
+      const double *yj = y[j];
+      double s = 0.0;
+      for (int i = i0; i < i1; i++)
+      {
+         s += x[i]*yj[i];
+      }
+      d[j] += s;
+   }
+}
+
+static void HostMultiDot(int n, const double *x, const double *const *y,
+                         int k, double *d)
+{
+   for (int j = 0; j < k; j++) { d[j] = 0.0; }
+   const int nc = (n + MULTI_VEC_CHUNK - 1)/MULTI_VEC_CHUNK;
+#ifdef MFEM_USE_LEGACY_OPENMP
+   // The partial sums of each chunk are added in the order of the chunks, so
+   // the result does not depend on the number of threads.
+   Array<double> pd(nc*k);
+   pd = 0.0;
+   #pragma omp parallel for
+   for (int c = 0; c < nc; c++)
+   {
+      const int i0 = c*MULTI_VEC_CHUNK;
+      HostMultiDotChunk(i0, std::min(i0 + MULTI_VEC_CHUNK, n), x, y, k,
+                        pd.GetData() + c*k);
+   }
+   for (int c = 0; c < nc; c++)
+   {
+      for (int j = 0; j < k; j++) { d[j] += pd[c*k+j]; }
+   }
+#else
+   for (int c = 0; c < nc; c++)
+   {
+      const int i0 = c*MULTI_VEC_CHUNK;
+      HostMultiDotChunk(i0, std::min(i0 + MULTI_VEC_CHUNK, n), x, y, k, d);
+   }
+#endif
+}
+
+// x += sum_j a[j] y[j], j = 0,...,k-1
+static void HostMultiAXPY(int n, const double *a, const double *const *y,
+                          int k, double *x)
+{
+   const int nc = (n + MULTI_VEC_CHUNK - 1)/MULTI_VEC_CHUNK;
+#ifdef MFEM_USE_LEGACY_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int c = 0; c < nc; c++)
+   {
+      const int i0 = c*MULTI_VEC_CHUNK, i1 = std::min(i0 + MULTI_VEC_CHUNK, n);
+      int j = 0;
+      for ( ; j + 4 <= k; j += 4)
+      {
+         const double *y0 = y[j], *y1 = y[j+1], *y2 = y[j+2], *y3 = y[j+3];
+         const double a0 = a[j], a1 = a[j+1], a2 = a[j+2], a3 = a[j+3];
+         for (int i = i0; i < i1; i++)
+         {
+            x[i] += a0*y0[i] + a1*y1[i] + a2*y2[i] + a3*y3[i];
+         }
+      }
+      for ( ; j < k; j++)
+      {
+         const double *yj = y[j], aj = a[j];
+         for (int i = i0; i < i1; i++)
+         {
+            x[i] += aj*yj[i];
+         }
+      }
+   }
+}
+
+void MultiDot(const Vector &x, const Vector &Y, Vector &d)
+{
+   const int n = x.Size();
+   if (n == 0)
+   {
+      // the number of vectors is unknown, keep the size of d
+      d = 0.0;
+      return;
+   }
+   const int k = Y.Size()/n;
+   MFEM_ASSERT(Y.Size() == n*k, "incompatible Vectors!");
+   d.SetSize(k);
+   if (k == 0) { return; }
+
+   const bool use_dev = x.UseDevice() || Y.UseDevice();
+   if (use_dev)
+   {
+      // Two-stage reduction: each of the nt threads accumulates the partial
+      // sums of a strided (coalesced) subset of the entries.
+      const int nt = std::max((n + 63)/64, 1);
+      Vector p(nt*k);
+      p.UseDevice(true);
+      auto X = x.Read();
+      auto Yd = Y.Read();
+      auto P = p.Write();
+      MFEM_FORALL(t, nt,
+      {
+         for (int j = 0; j < k; j++)
+         {
+            const double *yj = Yd + j*n;
+            double s = 0.0;
+            for (int i = t; i < n; i += nt)
+            {
+               s += X[i]*yj[i];
+            }
+            P[t + j*nt] = s;
+         }
+      });
+      const double *hp = p.HostRead();
+      double *hd = d.HostWrite();
+      for (int j = 0; j < k; j++)
+      {
+         double s = 0.0;
+         for (int t = 0; t < nt; t++) { s += hp[t + j*nt]; }
+         hd[j] = s;
+      }
+      return;
+   }
+
+   const double *Yd = Y.HostRead();
+   Array<const double *> y(k);
+   for (int j = 0; j < k; j++) { y[j] = Yd + j*n; }
+   HostMultiDot(n, x.HostRead(), y.GetData(), k, d.HostWrite());
+}
+
+void MultiDot(const Vector &x, const Array<Vector*> &y, Vector &d)
+{
+   const int n = x.Size(), k = y.Size();
+   d.SetSize(k);
+   bool use_dev = x.UseDevice();
+   for (int j = 0; j < k; j++)
+   {
+      MFEM_ASSERT(y[j]->Size() == n, "incompatible Vectors!");
+      use_dev = use_dev || y[j]->UseDevice();
+   }
+   if (use_dev)
+   {
+      for (int j = 0; j < k; j++) { d(j) = x * (*y[j]); }
+      return;
+   }
+
+   Array<const double *> yp(k);
+   for (int j = 0; j < k; j++) { yp[j] = y[j]->HostRead(); }
+   HostMultiDot(n, x.HostRead(), yp.GetData(), k, d.HostWrite());
+}
+
+void MultiAXPY(double alpha, const Vector &a, const Vector &Y, Vector &x)
+{
+   const int n = x.Size(), k = a.Size();
+   MFEM_ASSERT(Y.Size() == n*k, "incompatible Vectors!");
+   if (k == 0 || alpha == 0.0) { return; }
+
+   Vector c(k);
+   c.Set(alpha, a);
+   const bool use_dev = x.UseDevice() || Y.UseDevice();
+   if (use_dev)
+   {
+      auto C = c.Read();
+      auto Yd = Y.Read();
+      auto X = x.ReadWrite();
+      MFEM_FORALL(i, n,
+      {
+         double s = 0.0;
+         for (int j = 0; j < k; j++)
+         {
+            s += C[j]*Yd[i + j*n];
+         }
+         X[i] += s;
+      });
+      return;
+   }
+
+   const double *Yd = Y.HostRead();
+   Array<const double *> y(k);
+   for (int j = 0; j < k; j++) { y[j] = Yd + j*n; }
+   HostMultiAXPY(n, c.HostRead(), y.GetData(), k, x.HostReadWrite());
+}
+
+void MultiAXPY(double alpha, const Vector &a, const Array<Vector*> &y,
+               Vector &x)
+{
+   const int n = x.Size(), k = y.Size();
+   MFEM_ASSERT(a.Size() == k, "incompatible Vectors!");
+   if (k == 0 || alpha == 0.0) { return; }
+
+   bool use_dev = x.UseDevice();
+   for (int j = 0; j < k; j++)
+   {
+      MFEM_ASSERT(y[j]->Size() == n, "incompatible Vectors!");
+      use_dev = use_dev || y[j]->UseDevice();
+   }
+   const double *ha = a.HostRead();
+   if (use_dev)
+   {
+      for (int j = 0; j < k; j++) { x.Add(alpha*ha[j], *y[j]); }
+      return;
+   }
+
+   Vector c(k);
+   Array<const double *> yp(k);
+   for (int j = 0; j < k; j++)
+   {
+      c(j) = alpha*ha[j];
+      yp[j] = y[j]->HostRead();
+   }
+   HostMultiAXPY(n, c.GetData(), yp.GetData(), k, x.HostReadWrite());
+}
+
 #ifdef MFEM_USE_SUNDIALS
 
 Vector::Vector(N_Vector nv)
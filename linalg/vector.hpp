@@ -567,6 +567,60 @@ inline double InnerProduct(MPI_Comm comm, const Vector &x, const Vector &y)
 }
 #endif
 
+/** @brief Compute the inner products d(j) = x * Y_j, j = 0,...,k-1, where
+    k = Y.Size()/x.Size() and the vectors Y_j are stored consecutively in @a Y,
+    i.e. Y_j is the sub-vector of @a Y of size x.Size() at offset j*x.Size().
+    The vector @a d is resized to k; if @a x is empty (e.g. on an empty
+    partition), the size of @a d is kept and @a d is set to zero. */
+/** The inner products are computed in a single pass over @a x, with the
+    entries of @a x reused from cache for all Y_j. With a device backend the
+    computation is done with MFEM_FORALL, as a two-stage reduction. In
+    parallel this computes the inner products of the local vectors, see
+    MultiDot(MPI_Comm, const Vector &, const Vector &, Vector &). */
+void MultiDot(const Vector &x, const Vector &Y, Vector &d);
+
+/** @brief Compute the inner products d(j) = x * (*y[j]), j = 0,...,k-1, where
+    k = y.Size(), in a single pass over @a x. */
+/** If one of the vectors uses the device, the inner products are computed
+    one at a time; the version for consecutively stored vectors,
+    MultiDot(const Vector &, const Vector &, Vector &), should be used in that
+    case. */
+void MultiDot(const Vector &x, const Array<Vector*> &y, Vector &d);
+
+/** @brief Compute x += alpha sum_j a(j) Y_j, j = 0,...,k-1, where k = a.Size()
+    and the vectors Y_j are stored consecutively in @a Y, as in
+    MultiDot(const Vector &, const Vector &, Vector &). */
+/** The update is done in a single pass over @a x. */
+void MultiAXPY(double alpha, const Vector &a, const Vector &Y, Vector &x);
+
+/** @brief Compute x += alpha sum_j a(j) (*y[j]), j = 0,...,k-1, where
+    k = y.Size(), in a single pass over @a x. */
+void MultiAXPY(double alpha, const Vector &a, const Array<Vector*> &y,
+               Vector &x);
+
+#ifdef MFEM_USE_MPI
+/** @brief Compute the inner products d(j) = x * Y_j of the global vectors,
+    see MultiDot(const Vector &, const Vector &, Vector &), with a single
+    MPI_Allreduce for all of them. */
+inline void MultiDot(MPI_Comm comm, const Vector &x, const Vector &Y,
+                     Vector &d)
+{
+   MultiDot(x, Y, d);
+   MPI_Allreduce(MPI_IN_PLACE, d.HostReadWrite(), d.Size(), MPI_DOUBLE,
+                 MPI_SUM, comm);
+}
+
+/** @brief Compute the inner products d(j) = x * (*y[j]) of the global
+    vectors with a single MPI_Allreduce for all of them. */
+inline void MultiDot(MPI_Comm comm, const Vector &x, const Array<Vector*> &y,
+                     Vector &d)
+{
+   MultiDot(x, y, d);
+   MPI_Allreduce(MPI_IN_PLACE, d.HostReadWrite(), d.Size(), MPI_DOUBLE,
+                 MPI_SUM, comm);
+}
+#endif
+
 } // namespace mfem
 
 #endif
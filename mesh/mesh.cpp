@@ -56,6 +56,12 @@ using namespace std;
 namespace mfem
 {
 
+#ifdef MFEM_USE_OPENMP
+bool Mesh::threaded_topology = true;
+#else
+bool Mesh::threaded_topology = false;
+#endif
+
 void Mesh::GetElementJacobian(int i, DenseMatrix &J)
 {
    Geometry::Type geom = GetElementBaseGeometry(i);
@@ -759,21 +765,52 @@ void Mesh::GetLocalQuadToWdgTransformation(
    Transf.FinalizeTransformation();
 }
 
+// Return true if the two rules have the same points in the first 'dim'
+// coordinates (the weights do not affect the geometric factors and the unused
+// coordinates may not be initialized).
+static bool SameIntegrationPoints(const IntegrationRule &a,
+                                  const IntegrationRule &b, int dim)
+{
+   if (&a == &b) { return true; }
+   if (a.GetNPoints() != b.GetNPoints()) { return false; }
+   for (int i = 0; i < a.GetNPoints(); i++)
+   {
+      const IntegrationPoint &ip = a.IntPoint(i), &jp = b.IntPoint(i);
+      if (ip.x != jp.x ||
+          (dim > 1 && ip.y != jp.y) ||
+          (dim > 2 && ip.z != jp.z)) { return false; }
+   }
+   return true;
+}
+
 const GeometricFactors* Mesh::GetGeometricFactors(const IntegrationRule& ir,
                                                   const int flags)
 {
+   // factors computed before the mesh was refined are stale
+   for (int i = 0; i < geom_factors.Size(); i++)
+   {
+      if (geom_factors[i]->sequence != sequence)
+      {
+         DeleteGeometricFactors();
+         break;
+      }
+   }
+
+   int all_flags = flags;
    for (int i = 0; i < geom_factors.Size(); i++)
    {
       GeometricFactors *gf = geom_factors[i];
-      if (gf->IntRule == &ir && (gf->computed_factors & flags) == flags)
+      if (SameIntegrationPoints(*gf->IntRule, ir, Dim))
       {
-         return gf;
+         if ((gf->computed_factors & flags) == flags) { return gf; }
+         all_flags |= gf->computed_factors;
       }
    }
 
    this->EnsureNodes();
 
-   GeometricFactors *gf = new GeometricFactors(this, ir, flags);
+   // NOTE: the entries with fewer flags are kept, callers may still use them
+   GeometricFactors *gf = new GeometricFactors(this, ir, all_flags);
    geom_factors.Append(gf);
    return gf;
 }
@@ -785,6 +822,21 @@ void Mesh::DeleteGeometricFactors()
       delete geom_factors[i];
    }
    geom_factors.SetSize(0);
+
+   delete element_bvh;
+   element_bvh = NULL;
+}
+
+const ElementBVH &Mesh::GetElementBVH()
+{
+   if (element_bvh && (element_bvh->sequence != sequence ||
+                       element_bvh->checksum != ElementBVH::GetChecksum(*this)))
+   {
+      delete element_bvh;
+      element_bvh = NULL;
+   }
+   if (!element_bvh) { element_bvh = new ElementBVH(this); }
+   return *element_bvh;
 }
 
 void Mesh::GetLocalFaceTransformation(
@@ -979,6 +1031,7 @@ void Mesh::Init()
    own_nodes = 1;
    NURBSext = NULL;
    ncmesh = NULL;
+   element_bvh = NULL;
    last_operation = Mesh::NONE;
 }
 
@@ -1569,6 +1622,56 @@ void Mesh::GetHilbertElementOrdering(Array<int> &ordering)
    }
 }
 
+// Spread the lowest 21 bits of 'x', leaving two zero bits between consecutive
+// bits, so that three such values can be interleaved.
+static inline unsigned long long MortonSpread(unsigned long long x)
+{
+   x &= 0x1fffffULL;
+   x = (x | x << 32) & 0x1f00000000ffffULL;
+   x = (x | x << 16) & 0x1f0000ff0000ffULL;
+   x = (x | x << 8)  & 0x100f00f00f00f00fULL;
+   x = (x | x << 4)  & 0x10c30c30c30c30c3ULL;
+   x = (x | x << 2)  & 0x1249249249249249ULL;
+   return x;
+}
+
+void Mesh::GetMortonElementOrdering(Array<int> &ordering)
+{
+   MFEM_VERIFY(spaceDim <= 3, "");
+
+   Vector min, max, center;
+   GetBoundingBox(min, max);
+
+   // the key of an element interleaves the bits of the coordinates of its
+   // center, quantized to 21 bits within the bounding box
+   const double scale = (1 << 21) - 1;
+   Array<int> indices(GetNE());
+   Array<unsigned long long> keys(GetNE());
+   for (int i = 0; i < GetNE(); i++)
+   {
+      GetElementCenter(i, center);
+      unsigned long long key = 0;
+      for (int j = 0; j < spaceDim; j++)
+      {
+         const double len = max(j) - min(j);
+         double t = (len > 0.0) ? (center(j) - min(j))/len : 0.0;
+         t = std::min(std::max(t, 0.0), 1.0);
+         key |= MortonSpread((unsigned long long)(t*scale)) << (2-j);
+      }
+      keys[i] = key;
+      indices[i] = i;
+   }
+   indices.Sort([&](int a, int b)
+   { return keys[a] < keys[b] || (keys[a] == keys[b] && a < b); });
+
+   // return ordering in the format required by ReorderElements
+   ordering.SetSize(GetNE());
+   for (int i = 0; i < GetNE(); i++)
+   {
+      ordering[indices[i]] = i;
+   }
+}
+
 
 void Mesh::ReorderElements(const Array<int> &ordering, bool reorder_vertices)
 {
@@ -2915,6 +3018,9 @@ Mesh::Mesh(const Mesh &mesh, bool copy_nodes)
       ncmesh = mesh.ncmesh ? new NCMesh(*mesh.ncmesh) : NULL;
    }
 
+   // The element bounding box hierarchy is rebuilt on demand
+   element_bvh = NULL;
+
    // Duplicate the Nodes, including the FiniteElementCollection and the
    // FiniteElementSpace
    if (mesh.Nodes && copy_nodes)
@@ -2943,6 +3049,11 @@ Mesh::Mesh(const char *filename, int generate_edges, int refine,
    // Initialization as in the default constructor
    SetEmpty();
 
+   if (LoadBinaryMapped(filename, generate_edges, refine, fix_orientation))
+   {
+      return;
+   }
+
    named_ifgzstream imesh(filename);
    if (!imesh)
    {
@@ -3165,6 +3276,7 @@ void Mesh::Loader(std::istream &input, int generate_edges,
    bool mfem_v10 = (mesh_type == "MFEM mesh v1.0");
    bool mfem_v11 = (mesh_type == "MFEM mesh v1.1");
    bool mfem_v12 = (mesh_type == "MFEM mesh v1.2");
+   bool mfem_binary = (mesh_type == "MFEM binary mesh v1.0");
    if (mfem_v10 || mfem_v11 || mfem_v12) // MFEM's own mesh formats
    {
       // Formats mfem_v12 and newer have a tag indicating the end of the mesh
@@ -3177,6 +3289,11 @@ void Mesh::Loader(std::istream &input, int generate_edges,
       }
       ReadMFEMMesh(input, mfem_v11, curved);
    }
+   else if (mfem_binary)
+   {
+      ReadMFEMBinaryMesh(input, curved);
+      read_gf = 0; // the nodes are read below, in binary form
+   }
    else if (mesh_type == "linemesh") // 1D mesh
    {
       ReadLineMesh(input);
@@ -3286,6 +3403,10 @@ void Mesh::Loader(std::istream &input, int generate_edges,
          }
       }
    }
+   else if (curved && mfem_binary)
+   {
+      ReadMFEMBinaryNodes(input);
+   }
 
    // If a parse tag was supplied, keep reading the stream until the tag is
    // encountered.
@@ -4635,6 +4756,161 @@ double Mesh::GetLength(int i, int j) const
    return sqrt(length);
 }
 
+// Identifies the distinct entities (edges or faces) in a list of occurrences,
+// each given by a key of NK = 2 or 3 vertex indices in increasing order. The
+// entities are numbered in the order of their first occurrence, i.e. the
+// numbering of DSTable and STable3D, but the occurrences are sorted in
+// independent buckets (one per smallest vertex) instead of being inserted one
+// by one into linked lists.
+template <int NK>
+class EntityIdentifier
+{
+private:
+   struct Entry
+   {
+      int key[NK-1]; // the key without its smallest vertex
+      int occ;
+
+      bool operator<(const Entry &other) const
+      {
+         for (int i = 0; i < NK-1; i++)
+         {
+            if (key[i] != other.key[i]) { return key[i] < other.key[i]; }
+         }
+         return occ < other.occ;
+      }
+      bool SameKey(const Entry &other) const
+      {
+         for (int i = 0; i < NK-1; i++)
+         {
+            if (key[i] != other.key[i]) { return false; }
+         }
+         return true;
+      }
+   };
+
+   const int nv;
+   Array<int> keys, start, entity;
+   Array<Entry> entries;
+   int num_entities;
+
+public:
+   EntityIdentifier(int num_vertices, int num_occurrences)
+      : nv(num_vertices), keys(NK*num_occurrences), entity(num_occurrences),
+        num_entities(0) { }
+
+   /// The key of occurrence @a k, to be set before calling Finalize().
+   int *Key(int k) { return keys.GetData() + NK*k; }
+
+   /// Number the entities; the buckets are sorted in parallel with OpenMP.
+   void Finalize();
+
+   int NumberOfEntities() const { return num_entities; }
+
+   /// The entity of occurrence @a k.
+   int operator[](int k) const { return entity[k]; }
+
+   /// The entity with the given key, or -1 if it does not occur.
+   int Find(const int *key) const;
+};
+
+template <int NK>
+void EntityIdentifier<NK>::Finalize()
+{
+   const int nocc = entity.Size();
+   const int *K = keys.GetData();
+
+   // counting sort of the occurrences by their smallest vertex
+   start.SetSize(nv+1);
+   start = 0;
+   for (int k = 0; k < nocc; k++) { start[K[NK*k]+1]++; }
+   for (int v = 0; v < nv; v++) { start[v+1] += start[v]; }
+   entries.SetSize(nocc);
+   {
+      Array<int> pos;
+      start.Copy(pos);
+      for (int k = 0; k < nocc; k++)
+      {
+         Entry &en = entries[pos[K[NK*k]]++];
+         for (int i = 0; i < NK-1; i++) { en.key[i] = K[NK*k+1+i]; }
+         en.occ = k;
+      }
+   }
+   keys.DeleteAll();
+
+   // sort each bucket and record the first occurrence of each entity in
+   // 'entity'; the buckets are usually small, so use insertion sort for them
+   int *E = entity.GetData();
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int v = 0; v < nv; v++)
+   {
+      Entry *b = entries.GetData() + start[v];
+      Entry *e = entries.GetData() + start[v+1];
+      if (e - b > 32)
+      {
+         std::sort(b, e);
+      }
+      else
+      {
+         for (Entry *p = b + 1; p < e; p++)
+         {
+            const Entry en = *p;
+            Entry *q = p;
+            for ( ; q > b && en < q[-1]; q--) { *q = q[-1]; }
+            *q = en;
+         }
+      }
+      for (Entry *p = b; p < e; p++)
+      {
+         E[p->occ] = (p > b && p->SameKey(p[-1])) ? E[p[-1].occ] : p->occ;
+      }
+   }
+
+   // the first occurrences come before the others, so one in-place pass
+   // replaces them with the entity numbers
+   for (int k = 0; k < nocc; k++)
+   {
+      E[k] = (E[k] == k) ? num_entities++ : E[E[k]];
+   }
+}
+
+template <int NK>
+int EntityIdentifier<NK>::Find(const int *key) const
+{
+   Entry en;
+   for (int i = 0; i < NK-1; i++) { en.key[i] = key[1+i]; }
+   en.occ = -1;
+   const Entry *b = entries.GetData() + start[key[0]];
+   const Entry *e = entries.GetData() + start[key[0]+1];
+   const Entry *p = std::lower_bound(b, e, en);
+   return (p < e && p->SameKey(en)) ? entity[p->occ] : -1;
+}
+
+// Sort the vertices of an edge into 'key'.
+static inline void GetEdgeKey(int v0, int v1, int *key)
+{
+   key[0] = std::min(v0, v1);
+   key[1] = std::max(v0, v1);
+}
+
+// Store the smallest three of the 'nfv' (3 or 4) face vertices 'fv' into 'key'
+// in increasing order, like STable3D::Push4().
+static inline void GetFaceKey(int nfv, const int *fv, int *key)
+{
+   int a = fv[0], b = fv[1], c = fv[2];
+   if (nfv == 4)
+   {
+      int &m = (a > b) ? ((a > c) ? a : c) : ((b > c) ? b : c);
+      if (fv[3] < m) { m = fv[3]; }
+   }
+   if (a > b) { std::swap(a, b); }
+   if (b > c) { std::swap(b, c); }
+   if (a > b) { std::swap(a, b); }
+   key[0] = a; key[1] = b; key[2] = c;
+}
+
 // static method
 void Mesh::GetElementArrayEdgeTable(const Array<Element*> &elem_array,
                                     const DSTable &v_to_v, Table &el_to_edge)
@@ -4685,6 +4961,11 @@ void Mesh::GetVertexToVertexTable(DSTable &v_to_v) const
 
 int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
 {
+   if (threaded_topology)
+   {
+      return GetElementToEdgeTableThreaded(e_to_f, be_to_f);
+   }
+
    int i, NumberOfEdges;
 
    DSTable v_to_v(NumOfVertices);
@@ -4722,6 +5003,134 @@ int Mesh::GetElementToEdgeTable(Table & e_to_f, Array<int> &be_to_f)
    return NumberOfEdges;
 }
 
+int Mesh::GetElementToEdgeTableThreaded(Table &e_to_f, Array<int> &be_to_f)
+{
+   if (Dim == 1)
+   {
+      mfem_error("1D GetElementToEdgeTable is not yet implemented.");
+   }
+
+   // Row offsets of the element (and, in 3D, boundary element) to edge tables,
+   // which are the positions of the edge occurrences.
+   e_to_f.MakeI(NumOfElements);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      e_to_f.AddColumnsInRow(i, elements[i]->GetNEdges());
+   }
+   e_to_f.MakeJ();
+   if (Dim == 3)
+   {
+      if (bel_to_edge == NULL)
+      {
+         bel_to_edge = new Table;
+      }
+      bel_to_edge->MakeI(NumOfBdrElements);
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         bel_to_edge->AddColumnsInRow(i, boundary[i]->GetNEdges());
+      }
+      bel_to_edge->MakeJ();
+   }
+
+   // The edges are defined by edge_vertex, if present, and by the element
+   // edges otherwise, see GetVertexToVertexTable().
+   const int *I = e_to_f.GetI();
+   int *J = e_to_f.GetJ();
+   const int nev = edge_vertex ? edge_vertex->Size() : I[NumOfElements];
+   EntityIdentifier<2> edges(NumOfVertices, nev);
+   if (edge_vertex)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < nev; i++)
+      {
+         const int *v = edge_vertex->GetRow(i);
+         GetEdgeKey(v[0], v[1], edges.Key(i));
+      }
+   }
+   else
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const int *v = elements[i]->GetVertices();
+         const int ne = elements[i]->GetNEdges();
+         for (int j = 0; j < ne; j++)
+         {
+            const int *e = elements[i]->GetEdgeVertices(j);
+            GetEdgeKey(v[e[0]], v[e[1]], edges.Key(I[i]+j));
+         }
+      }
+   }
+   edges.Finalize();
+
+   // Fill the element to edge table
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const int *v = elements[i]->GetVertices();
+      const int ne = elements[i]->GetNEdges();
+      for (int j = 0; j < ne; j++)
+      {
+         if (edge_vertex)
+         {
+            const int *e = elements[i]->GetEdgeVertices(j);
+            int key[2];
+            GetEdgeKey(v[e[0]], v[e[1]], key);
+            J[I[i]+j] = edges.Find(key);
+         }
+         else
+         {
+            J[I[i]+j] = edges[I[i]+j];
+         }
+      }
+   }
+
+   if (Dim == 2)
+   {
+      // Initialize the indices for the boundary elements.
+      be_to_f.SetSize(NumOfBdrElements);
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         const int *v = boundary[i]->GetVertices();
+         int key[2];
+         GetEdgeKey(v[0], v[1], key);
+         be_to_f[i] = edges.Find(key);
+      }
+   }
+   else
+   {
+      const int *bI = bel_to_edge->GetI();
+      int *bJ = bel_to_edge->GetJ();
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         const int *v = boundary[i]->GetVertices();
+         const int ne = boundary[i]->GetNEdges();
+         for (int j = 0; j < ne; j++)
+         {
+            const int *e = boundary[i]->GetEdgeVertices(j);
+            int key[2];
+            GetEdgeKey(v[e[0]], v[e[1]], key);
+            bJ[bI[i]+j] = edges.Find(key);
+         }
+      }
+   }
+
+   // Return the number of edges
+   return edges.NumberOfEntities();
+}
+
 const Table & Mesh::ElementToElementTable()
 {
    if (el_to_el)
@@ -4891,6 +5300,11 @@ void Mesh::GenerateFaces()
       faces_info[i].Elem1No = -1;
       faces_info[i].NCFace = -1;
    }
+   if (threaded_topology)
+   {
+      GenerateFacesThreaded();
+      return;
+   }
    for (i = 0; i < NumOfElements; i++)
    {
       const int *v = elements[i]->GetVertices();
@@ -4958,6 +5372,86 @@ void Mesh::GenerateFaces()
    }
 }
 
+void Mesh::GenerateFacesThreaded()
+{
+   const int nfaces = faces.Size();
+
+   // The local faces of the elements, in order, are the face occurrences;
+   // 'ftbl' gives their global face numbers (in 1D, the vertices).
+   const Table *ftbl = (Dim == 2) ? el_to_edge : el_to_face;
+   const int *fI = (Dim == 1) ? NULL : ftbl->GetI();
+   const int *fJ = (Dim == 1) ? NULL : ftbl->GetJ();
+   const int nocc = (Dim == 1) ? 2*NumOfElements : fI[NumOfElements];
+   Array<int> occ_face;
+   if (Dim == 1)
+   {
+      occ_face.SetSize(nocc);
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const int *v = elements[i]->GetVertices();
+         occ_face[2*i] = v[0];
+         occ_face[2*i+1] = v[1];
+      }
+      fJ = occ_face.GetData();
+   }
+
+   // A face gets its first element from its first occurrence and its second
+   // element from its last occurrence, as when the occurrences are added in
+   // order. Each of the two passes below touches every face at most once, so
+   // the elements can be processed in parallel.
+   Array<int> first(nfaces), last(nfaces);
+   first = -1;
+   for (int k = 0; k < nocc; k++)
+   {
+      const int gf = fJ[k];
+      if (first[gf] < 0) { first[gf] = k; }
+      last[gf] = k;
+   }
+
+   for (int pass = 0; pass < 2; pass++)
+   {
+#ifdef MFEM_USE_OPENMP
+      #pragma omp parallel for
+#endif
+      for (int i = 0; i < NumOfElements; i++)
+      {
+         const int *v = elements[i]->GetVertices();
+         const int nf = (Dim == 1) ? 2 : (fI[i+1] - fI[i]);
+         const int k0 = (Dim == 1) ? 2*i : fI[i];
+         for (int j = 0; j < nf; j++)
+         {
+            const int k = k0 + j, gf = fJ[k];
+            const bool add = (pass == 0) ? (first[gf] == k) :
+                             (last[gf] == k && first[gf] != k);
+            if (!add) { continue; }
+            if (Dim == 1)
+            {
+               AddPointFaceElement(j, gf, i);
+            }
+            else if (Dim == 2)
+            {
+               const int *e = elements[i]->GetEdgeVertices(j);
+               AddSegmentFaceElement(j, gf, i, v[e[0]], v[e[1]]);
+            }
+            else
+            {
+               const int *fv = elements[i]->GetFaceVertices(j);
+               if (elements[i]->GetNFaceVertices(j) == 3)
+               {
+                  AddTriangleFaceElement(j, gf, i,
+                                         v[fv[0]], v[fv[1]], v[fv[2]]);
+               }
+               else
+               {
+                  AddQuadFaceElement(j, gf, i,
+                                     v[fv[0]], v[fv[1]], v[fv[2]], v[fv[3]]);
+               }
+            }
+         }
+      }
+   }
+}
+
 void Mesh::GenerateNCFaceInfo()
 {
    MFEM_VERIFY(ncmesh, "missing NCMesh.");
@@ -5062,6 +5556,13 @@ STable3D *Mesh::GetFacesTable()
 
 STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
 {
+   if (threaded_topology)
+   {
+      GetElementToFaceTableThreaded();
+      // the faces table numbers the faces in the same order
+      return ret_ftbl ? GetFacesTable() : NULL;
+   }
+
    int i, *v;
    STable3D *faces_tbl;
 
@@ -5149,6 +5650,68 @@ STable3D *Mesh::GetElementToFaceTable(int ret_ftbl)
    return NULL;
 }
 
+void Mesh::GetElementToFaceTableThreaded()
+{
+   if (el_to_face != NULL)
+   {
+      delete el_to_face;
+   }
+   el_to_face = new Table;
+   el_to_face->MakeI(NumOfElements);
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      el_to_face->AddColumnsInRow(i, elements[i]->GetNFaces());
+   }
+   el_to_face->MakeJ();
+   const int *I = el_to_face->GetI();
+   int *J = el_to_face->GetJ();
+
+   // find the faces by the vertices with the smallest 3 numbers
+   EntityIdentifier<3> faces_id(NumOfVertices, I[NumOfElements]);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      const int *v = elements[i]->GetVertices();
+      const int nf = elements[i]->GetNFaces();
+      for (int j = 0; j < nf; j++)
+      {
+         const int *fv = elements[i]->GetFaceVertices(j);
+         const int nfv = elements[i]->GetNFaceVertices(j);
+         MFEM_ASSERT(nfv == 3 || nfv == 4, "Unexpected type of Element.");
+         int w[4];
+         for (int l = 0; l < nfv; l++) { w[l] = v[fv[l]]; }
+         GetFaceKey(nfv, w, faces_id.Key(I[i]+j));
+      }
+   }
+   faces_id.Finalize();
+
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int k = 0; k < I[NumOfElements]; k++)
+   {
+      J[k] = faces_id[k];
+   }
+   NumOfFaces = faces_id.NumberOfEntities();
+
+   be_to_face.SetSize(NumOfBdrElements);
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NumOfBdrElements; i++)
+   {
+      const int nv = boundary[i]->GetNVertices();
+      MFEM_VERIFY(nv == 3 || nv == 4, "Unexpected type of boundary Element.");
+      int key[3];
+      GetFaceKey(nv, boundary[i]->GetVertices(), key);
+      be_to_face[i] = faces_id.Find(key);
+      MFEM_VERIFY(be_to_face[i] >= 0, "boundary element " << i
+                  << " is not a face of the mesh");
+   }
+}
+
 // shift cyclically 3 integers so that the smallest is first
 static inline
 void Rotate3(int &a, int &b, int &c)
@@ -5274,8 +5837,68 @@ int *Mesh::CartesianPartitioning(int nxyz[])
    return partitioning;
 }
 
+int *Mesh::SpaceFillingCurvePartitioning(int nparts,
+                                         const Vector *elem_weights,
+                                         bool morton)
+{
+   MFEM_VERIFY(nparts > 0, "invalid number of parts: " << nparts);
+   MFEM_VERIFY(!elem_weights || elem_weights->Size() == NumOfElements,
+               "invalid size of the element weights");
+
+   int *partitioning = new int[NumOfElements];
+
+   Array<int> ordering, curve(NumOfElements);
+   if (morton) { GetMortonElementOrdering(ordering); }
+   else { GetHilbertElementOrdering(ordering); }
+   for (int i = 0; i < NumOfElements; i++)
+   {
+      curve[ordering[i]] = i;
+   }
+
+   if (NumOfElements <= nparts)
+   {
+      for (int k = 0; k < NumOfElements; k++)
+      {
+         partitioning[curve[k]] = k;
+      }
+      return partitioning;
+   }
+
+   double total = 0.0;
+   if (elem_weights)
+   {
+      MFEM_VERIFY(elem_weights->Min() >= 0.0, "negative element weight");
+      total = elem_weights->Sum();
+   }
+   const bool unit = (total <= 0.0);
+   if (unit) { total = NumOfElements; }
+
+   // Split the curve into segments of equal weight: an element is assigned
+   // to the segment containing the middle of its weight interval. Parts are
+   // not skipped, so no part is empty.
+   double sum = 0.0;
+   int part = -1;
+   for (int k = 0; k < NumOfElements; k++)
+   {
+      const double w = unit ? 1.0 : (*elem_weights)(curve[k]);
+      const int target = (int) std::floor(nparts*(sum + 0.5*w)/total);
+      sum += w;
+      part = std::max(part, std::min(target, part + 1));
+      part = std::max(part, nparts - (NumOfElements - k));
+      part = std::min(part, nparts - 1);
+      partitioning[curve[k]] = part;
+   }
+
+   return partitioning;
+}
+
 int *Mesh::GeneratePartitioning(int nparts, int part_method)
 {
+   if (part_method == 6 || part_method == 7)
+   {
+      return SpaceFillingCurvePartitioning(nparts, NULL, part_method == 7);
+   }
+
 #ifdef MFEM_USE_METIS
 
    int print_messages = 1;
@@ -6048,6 +6671,8 @@ void Mesh::CheckDisplacements(const Vector &displacements, double &tmax)
 
 void Mesh::MoveVertices(const Vector &displacements)
 {
+   DeleteGeometricFactors();
+
    for (int i = 0, nv = vertices.Size(); i < nv; i++)
       for (int j = 0; j < spaceDim; j++)
       {
@@ -6068,6 +6693,8 @@ void Mesh::GetVertices(Vector &vert_coord) const
 
 void Mesh::SetVertices(const Vector &vert_coord)
 {
+   DeleteGeometricFactors();
+
    for (int i = 0, nv = vertices.Size(); i < nv; i++)
       for (int j = 0; j < spaceDim; j++)
       {
@@ -6096,6 +6723,8 @@ void Mesh::GetNode(int i, double *coord) const
 
 void Mesh::SetNode(int i, const double *coord)
 {
+   DeleteGeometricFactors();
+
    if (Nodes)
    {
       FiniteElementSpace *fes = Nodes->FESpace();
@@ -6116,6 +6745,8 @@ void Mesh::SetNode(int i, const double *coord)
 
 void Mesh::MoveNodes(const Vector &displacements)
 {
+   DeleteGeometricFactors();
+
    if (Nodes)
    {
       (*Nodes) += displacements;
@@ -6140,6 +6771,8 @@ void Mesh::GetNodes(Vector &node_coord) const
 
 void Mesh::SetNodes(const Vector &node_coord)
 {
+   DeleteGeometricFactors();
+
    if (Nodes)
    {
       (*Nodes) = node_coord;
@@ -6152,6 +6785,8 @@ void Mesh::SetNodes(const Vector &node_coord)
 
 void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
 {
+   DeleteGeometricFactors();
+
    if (own_nodes) { delete Nodes; }
    Nodes = &nodes;
    spaceDim = Nodes->FESpace()->GetVDim();
@@ -6166,6 +6801,8 @@ void Mesh::NewNodes(GridFunction &nodes, bool make_owner)
 
 void Mesh::SwapNodes(GridFunction *&nodes, int &own_nodes_)
 {
+   DeleteGeometricFactors();
+
    mfem::Swap<GridFunction*>(Nodes, nodes);
    mfem::Swap<int>(own_nodes, own_nodes_);
    // TODO:
@@ -7419,7 +8056,9 @@ void Mesh::Swap(Mesh& other, bool non_geometry)
    mfem::Swap(attributes, other.attributes);
    mfem::Swap(bdr_attributes, other.bdr_attributes);
 
-   mfem::Swap(geom_factors, other.geom_factors);
+   // the cached data points back to its mesh
+   DeleteGeometricFactors();
+   other.DeleteGeometricFactors();
 
 #ifdef MFEM_USE_MEMALLOC
    TetMemory.Swap(other.TetMemory);
@@ -8326,6 +8965,63 @@ void Mesh::Printer(std::ostream &out, std::string section_delimiter) const
    }
 }
 
+// Write the attributes, the geometries and the vertex indices of the given
+// elements as three contiguous blocks.
+static void PrintBinaryElements(const Array<Element *> &elems,
+                                std::ostream &out)
+{
+   const int ne = elems.Size();
+   Array<int> attr(ne), geom(ne);
+   int nconn = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      attr[i] = elems[i]->GetAttribute();
+      geom[i] = elems[i]->GetGeometryType();
+      nconn += elems[i]->GetNVertices();
+   }
+   Array<int> conn(nconn);
+   for (int i = 0, k = 0; i < ne; i++)
+   {
+      const int nv = elems[i]->GetNVertices();
+      const int *v = elems[i]->GetVertices();
+      for (int j = 0; j < nv; j++) { conn[k++] = v[j]; }
+   }
+   bin_io::write(out, attr.GetData(), ne);
+   bin_io::write(out, geom.GetData(), ne);
+   bin_io::write(out, conn.GetData(), nconn);
+}
+
+void Mesh::PrintBinary(std::ostream &out) const
+{
+   MFEM_VERIFY(!NURBSext && !ncmesh,
+               "the binary format does not support NURBS and NC meshes");
+
+   out << "MFEM binary mesh v1.0\n";
+   // byte order mark, sizes, flag for the nodes, reserved
+   const int header[8] = { 0x01020304, Dim, spaceDim, NumOfElements,
+                           NumOfBdrElements, NumOfVertices, Nodes ? 1 : 0, 0
+                         };
+   bin_io::write(out, header, 8);
+
+   PrintBinaryElements(elements, out);
+   PrintBinaryElements(boundary, out);
+   bin_io::write(out, vertices.GetData(), NumOfVertices);
+
+   if (Nodes)
+   {
+      const FiniteElementSpace *fes = Nodes->FESpace();
+      const char *name = fes->FEColl()->Name();
+      const int len = strlen(name);
+      const int info[4] = { len, fes->GetVDim(), fes->GetOrdering(),
+                            Nodes->Size()
+                          };
+      bin_io::write(out, info, 4);
+      bin_io::write(out, name, len);
+      bin_io::write(out, Nodes->HostRead(), Nodes->Size());
+   }
+   out.flush();
+}
+
 void Mesh::PrintTopo(std::ostream &out,const Array<int> &e_to_k) const
 {
    int i;
@@ -9788,6 +10484,8 @@ void Mesh::ScaleElements(double sf)
 
 void Mesh::Transform(void (*f)(const Vector&, Vector&))
 {
+   DeleteGeometricFactors();
+
    // TODO: support for different new spaceDim.
    if (Nodes == NULL)
    {
@@ -9815,6 +10513,7 @@ void Mesh::Transform(VectorCoefficient &deformation)
 {
    MFEM_VERIFY(spaceDim == deformation.GetVDim(),
                "incompatible vector dimensions");
+   DeleteGeometricFactors();
    if (Nodes == NULL)
    {
       LinearFECollection fec;
@@ -10067,104 +10766,307 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
    elem_ids = -1;
    if (!GetNE()) { return 0; }
 
-   double *data = point_mat.GetData();
-   InverseElementTransformation *inv_tr = inv_trans;
-   inv_tr = inv_tr ? inv_tr : new InverseElementTransformation;
+   int pts_found = GetElementBVH().FindPoints(point_mat, elem_ids, ips,
+                                              inv_trans);
+
+   if (warn && pts_found != npts)
+   {
+      MFEM_WARNING((npts-pts_found) << " points were not found");
+   }
+   return pts_found;
+}
+
 
-   // For each point in 'point_mat', find the element whose center is closest.
-   Vector min_dist(npts);
-   Array<int> e_idx(npts);
-   min_dist = std::numeric_limits<double>::max();
-   e_idx = -1;
+ElementBVH::ElementBVH(Mesh *mesh, double curved_pad)
+   : mesh(mesh), sequence(mesh->GetSequence()), checksum(GetChecksum(*mesh)),
+     sdim(mesh->SpaceDimension())
+{
+   const int NE = mesh->GetNE();
+   if (NE == 0) { return; }
 
-   Vector pt(spaceDim);
-   for (int i = 0; i < GetNE(); i++)
+   ComputeElementBoxes(curved_pad);
+
+   Array<double> centers(NE*sdim);
+   for (int i = 0; i < NE; i++)
    {
-      GetElementTransformation(i)->Transform(
-         Geometries.GetCenter(GetElementBaseGeometry(i)), pt);
-      for (int k = 0; k < npts; k++)
+      for (int d = 0; d < sdim; d++)
       {
-         double dist = pt.DistanceTo(data+k*spaceDim);
-         if (dist < min_dist(k))
-         {
-            min_dist(k) = dist;
-            e_idx[k] = i;
-         }
+         centers[i*sdim + d] =
+            0.5*(elem_box[2*sdim*i + d] + elem_box[2*sdim*i + sdim + d]);
       }
    }
 
-   // Checks if the points lie in the closest element
-   int pts_found = 0;
-   pt.NewDataAndSize(NULL, spaceDim);
-   for (int k = 0; k < npts; k++)
+   elems.SetSize(NE);
+   for (int i = 0; i < NE; i++) { elems[i] = i; }
+
+   // a binary tree with at least one element per leaf has < 2*NE nodes
+   nodes.Reserve(2*NE);
+   node_box.Reserve(2*NE*2*sdim);
+   nodes.SetSize(1);
+   node_box.SetSize(2*sdim);
+   nodes[0].begin = 0;
+   nodes[0].end = NE;
+   Split(0, centers);
+}
+
+unsigned long long ElementBVH::GetChecksum(const Mesh &mesh)
+{
+   // 64-bit FNV-1a hash of the coordinates
+   unsigned long long h = 14695981039346656037ULL;
+   const unsigned long long prime = 1099511628211ULL;
+   const double *x;
+   int n;
+   if (const GridFunction *Nodes = mesh.GetNodes())
    {
-      pt.SetData(data+k*spaceDim);
-      inv_tr->SetTransformation(*GetElementTransformation(e_idx[k]));
-      int res = inv_tr->Transform(pt, ips[k]);
-      if (res == InverseElementTransformation::Inside)
-      {
-         elem_ids[k] = e_idx[k];
-         pts_found++;
-      }
+      x = Nodes->HostRead();
+      n = Nodes->Size();
    }
-   if (pts_found != npts)
+   else
    {
-      Array<int> vertices;
-      Table *vtoel = GetVertexToElementTable();
-      for (int k = 0; k < npts; k++)
+      // the Vertex objects store 3 coordinates each
+      x = NULL;
+      n = mesh.GetNV()*mesh.SpaceDimension();
+   }
+   const int sdim = mesh.SpaceDimension();
+   for (int i = 0; i < n; i++)
+   {
+      const double c = x ? x[i] : mesh.GetVertex(i/sdim)[i%sdim];
+      unsigned long long bits;
+      std::memcpy(&bits, &c, sizeof(double));
+      h = (h ^ bits) * prime;
+   }
+   return h;
+}
+
+void ElementBVH::ComputeElementBoxes(double curved_pad)
+{
+   const int NE = mesh->GetNE();
+   const GridFunction *Nodes = mesh->GetNodes();
+   const FiniteElementSpace *fes = Nodes ? Nodes->FESpace() : NULL;
+   if (Nodes) { Nodes->HostRead(); }
+
+   elem_box.SetSize(2*sdim*NE);
+
+   // the boxes are computed from the node coordinates only (no evaluation of
+   // the shape functions), so the loop is thread safe
+#ifdef MFEM_USE_OPENMP
+   #pragma omp parallel for
+#endif
+   for (int i = 0; i < NE; i++)
+   {
+      double *box = elem_box.GetData() + 2*sdim*i;
+      for (int d = 0; d < sdim; d++)
       {
-         if (elem_ids[k] != -1) { continue; }
-         // Try all vertex-neighbors of element e_idx[k]
-         pt.SetData(data+k*spaceDim);
-         GetElementVertices(e_idx[k], vertices);
-         for (int v = 0; v < vertices.Size(); v++)
+         box[d] = infinity();
+         box[sdim + d] = -infinity();
+      }
+
+      double pad = 0.0;
+      Array<int> dofs;
+      if (!Nodes)
+      {
+         mesh->GetElementVertices(i, dofs);
+         for (int j = 0; j < dofs.Size(); j++)
          {
-            int vv = vertices[v];
-            int ne = vtoel->RowSize(vv);
-            const int* els = vtoel->GetRow(vv);
-            for (int e = 0; e < ne; e++)
+            const double *v = mesh->GetVertex(dofs[j]);
+            for (int d = 0; d < sdim; d++)
             {
-               if (els[e] == e_idx[k]) { continue; }
-               inv_tr->SetTransformation(*GetElementTransformation(els[e]));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = els[e];
-                  pts_found++;
-                  goto next_point;
-               }
+               box[d] = std::min(box[d], v[d]);
+               box[sdim + d] = std::max(box[sdim + d], v[d]);
             }
          }
-         // Try neighbours for non-conforming meshes
-         if (ncmesh)
+      }
+      else
+      {
+         fes->GetElementVDofs(i, dofs);
+         const int nd = dofs.Size()/sdim;
+         for (int j = 0; j < nd; j++)
          {
-            Array<int> neigh;
-            int le = ncmesh->leaf_elements[e_idx[k]];
-            ncmesh->FindNeighbors(le,neigh);
-            for (int e = 0; e < neigh.Size(); e++)
+            for (int d = 0; d < sdim; d++)
             {
-               int nn = neigh[e];
-               if (ncmesh->IsGhost(ncmesh->elements[nn])) { continue; }
-               int el = ncmesh->elements[nn].index;
-               inv_tr->SetTransformation(*GetElementTransformation(el));
-               int res = inv_tr->Transform(pt, ips[k]);
-               if (res == InverseElementTransformation::Inside)
-               {
-                  elem_ids[k] = el;
-                  pts_found++;
-                  goto next_point;
-               }
+               int k = dofs[d*nd + j];
+               double x = (k >= 0) ? (*Nodes)(k) : -(*Nodes)(-1-k);
+               box[d] = std::min(box[d], x);
+               box[sdim + d] = std::max(box[sdim + d], x);
             }
          }
-      next_point: ;
+         // interpolatory high-order elements may bulge out of their nodes
+         const FiniteElement *fe = fes->GetFE(i);
+         if (fe->GetOrder() > 1 &&
+             !dynamic_cast<const PositiveFiniteElement*>(fe) &&
+             !dynamic_cast<const NURBSFiniteElement*>(fe))
+         {
+            pad = curved_pad;
+         }
+      }
+
+      // add a small relative tolerance to include points on the boundary;
+      // the pad is relative to the largest side, flat boxes get a thickness
+      pad = std::max(pad, 1e-12);
+      double size = 0.0;
+      for (int d = 0; d < sdim; d++)
+      {
+         size = std::max(size, box[sdim + d] - box[d]);
+      }
+      for (int d = 0; d < sdim; d++)
+      {
+         box[d] -= pad*size;
+         box[sdim + d] += pad*size;
       }
-      delete vtoel;
    }
-   if (inv_trans == NULL) { delete inv_tr; }
+}
 
-   if (warn && pts_found != npts)
+void ElementBVH::Split(int n, const Array<double> &centers)
+{
+   const int begin = nodes[n].begin, end = nodes[n].end;
+   nodes[n].child = -1;
+
+   // the node box, and the bounds of the element centers
+   double *box = node_box.GetData() + 2*sdim*n;
+   double cmin[3], cmax[3];
+   for (int d = 0; d < sdim; d++)
    {
-      MFEM_WARNING((npts-pts_found) << " points were not found");
+      box[d] = cmin[d] = infinity();
+      box[sdim + d] = cmax[d] = -infinity();
+   }
+   for (int k = begin; k < end; k++)
+   {
+      const double *ebox = elem_box.GetData() + 2*sdim*elems[k];
+      const double *c = centers.GetData() + sdim*elems[k];
+      for (int d = 0; d < sdim; d++)
+      {
+         box[d] = std::min(box[d], ebox[d]);
+         box[sdim + d] = std::max(box[sdim + d], ebox[sdim + d]);
+         cmin[d] = std::min(cmin[d], c[d]);
+         cmax[d] = std::max(cmax[d], c[d]);
+      }
+   }
+   if (end - begin <= leaf_size) { return; }
+
+   int axis = 0;
+   for (int d = 1; d < sdim; d++)
+   {
+      if (cmax[d] - cmin[d] > cmax[axis] - cmin[axis]) { axis = d; }
+   }
+   if (cmax[axis] == cmin[axis]) { return; } // coincident centers, keep a leaf
+
+   const int mid = (begin + end)/2;
+   const int dim = sdim;
+   std::nth_element(elems.GetData() + begin, elems.GetData() + mid,
+                    elems.GetData() + end, [&](int a, int b)
+   {
+      return centers[a*dim + axis] < centers[b*dim + axis];
+   });
+
+   const int child = nodes.Size();
+   nodes[n].child = child;
+   nodes.SetSize(child + 2);
+   node_box.SetSize(2*sdim*(child + 2));
+   nodes[child].begin = begin;
+   nodes[child].end = mid;
+   nodes[child+1].begin = mid;
+   nodes[child+1].end = end;
+
+   Split(child, centers);
+   Split(child + 1, centers);
+}
+
+int ElementBVH::GetDepth(int n) const
+{
+   if (nodes.Size() == 0 || nodes[n].child < 0) { return 0; }
+   return 1 + std::max(GetDepth(nodes[n].child), GetDepth(nodes[n].child+1));
+}
+
+void ElementBVH::FindCandidates(const double *x, Array<int> &el) const
+{
+   el.SetSize(0);
+   if (nodes.Size() == 0) { return; }
+
+   // the tree is balanced, its depth is at most log2(NE) < 64
+   int stack[64], top = 0;
+   stack[top++] = 0;
+   while (top)
+   {
+      const int n = stack[--top];
+      if (!InBox(node_box.GetData() + 2*sdim*n, x)) { continue; }
+      const Node &node = nodes[n];
+      if (node.child >= 0)
+      {
+         stack[top++] = node.child + 1;
+         stack[top++] = node.child;
+         continue;
+      }
+      for (int k = node.begin; k < node.end; k++)
+      {
+         if (InBox(elem_box.GetData() + 2*sdim*elems[k], x))
+         {
+            el.Append(elems[k]);
+         }
+      }
+   }
+}
+
+int ElementBVH::FindPoint(const double *x, IsoparametricTransformation &T,
+                          InverseElementTransformation &inv_tr,
+                          IntegrationPoint &ip) const
+{
+   Array<int> cand;
+   FindCandidates(x, cand);
+   Vector pt(const_cast<double*>(x), sdim);
+   for (int i = 0; i < cand.Size(); i++)
+   {
+      mesh->GetElementTransformation(cand[i], &T);
+      inv_tr.SetTransformation(T);
+      if (inv_tr.Transform(pt, ip) == InverseElementTransformation::Inside)
+      {
+         return cand[i];
+      }
+   }
+   return -1;
+}
+
+int ElementBVH::FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                           Array<IntegrationPoint> &ips,
+                           InverseElementTransformation *inv_trans) const
+{
+   const int npts = point_mat.Width();
+   MFEM_VERIFY(npts == 0 || point_mat.Height() == sdim,
+               "Invalid points matrix");
+   MFEM_VERIFY(sequence == mesh->GetSequence(),
+               "the hierarchy is outdated, the mesh has been updated");
+   elem_ids.SetSize(npts);
+   ips.SetSize(npts);
+   if (mesh->GetNodes()) { mesh->GetNodes()->HostRead(); }
+
+   // A user-provided 'inv_trans' object is shared by all points, and it may
+   // use thread-unsafe methods, e.g. the GlobGeometryRefiner for the initial
+   // guess, so only the default inversion is threaded.
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   const bool threaded = (inv_trans == NULL);
+#else
+   const bool threaded = false;
+#endif
+   MFEM_CONTRACT_VAR(threaded);
+
+   const double *data = point_mat.GetData();
+   int pts_found = 0;
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+   #pragma omp parallel if (threaded) reduction(+:pts_found)
+#endif
+   {
+      IsoparametricTransformation T;
+      InverseElementTransformation default_inv;
+      InverseElementTransformation &inv_tr =
+         inv_trans ? *inv_trans : default_inv;
+
+#if defined(MFEM_USE_OPENMP) && defined(MFEM_THREAD_SAFE)
+      #pragma omp for schedule(dynamic, 256)
+#endif
+      for (int k = 0; k < npts; k++)
+      {
+         elem_ids[k] = FindPoint(data + k*sdim, T, inv_tr, ips[k]);
+         if (elem_ids[k] >= 0) { pts_found++; }
+      }
    }
    return pts_found;
 }
@@ -10172,16 +11074,28 @@ int Mesh::FindPoints(DenseMatrix &point_mat, Array<int>& elem_ids,
 
 GeometricFactors::GeometricFactors(const Mesh *mesh, const IntegrationRule &ir,
                                    int flags)
+   : rule(ir)
 {
    this->mesh = mesh;
-   IntRule = &ir;
+   IntRule = &rule;
    computed_factors = flags;
+   sequence = mesh->GetSequence();
 
    const GridFunction *nodes = mesh->GetNodes();
    const FiniteElementSpace *fespace = nodes->FESpace();
+   const int NE   = fespace->GetNE();
+   if (NE == 0) { return; } // e.g. an empty partition of a ParMesh
+
+   // the element restriction below assumes that all elements are of one type
+   const Geometry::Type geom = mesh->GetElementBaseGeometry(0);
+   for (int e = 1; e < NE; e++)
+   {
+      MFEM_VERIFY(mesh->GetElementBaseGeometry(e) == geom,
+                  "meshes with mixed element types are not supported");
+   }
+
    const FiniteElement *fe = fespace->GetFE(0);
    const int vdim = fespace->GetVDim();
-   const int NE   = fespace->GetNE();
    const int ND   = fe->GetDof();
    const int NQ   = ir.GetNPoints();
 
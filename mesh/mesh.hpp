@@ -31,6 +31,7 @@ namespace mfem
 // Data type mesh
 
 class GeometricFactors;
+class ElementBVH;
 class KnotVector;
 class NURBSExtension;
 class FiniteElementSpace;
@@ -182,12 +183,19 @@ public:
    NURBSExtension *NURBSext; ///< Optional NURBS mesh extension.
    NCMesh *ncmesh;           ///< Optional non-conforming mesh extension.
    Array<GeometricFactors*> geom_factors; ///< Optional geometric factors.
+   ElementBVH *element_bvh;  ///< Optional element bounding box hierarchy.
 
    // Global parameter that can be used to control the removal of unused
    // vertices performed when reading a mesh in MFEM format. The default value
    // (true) is set in mesh_readers.cpp.
    static bool remove_unused_vertices;
 
+   // Global parameter that selects the sort-based construction of the edges and
+   // faces, which runs in parallel with OpenMP and numbers them exactly as the
+   // serial construction (faster on a single thread) does. The default value
+   // (true only in builds with MFEM_USE_OPENMP) is set in mesh.cpp.
+   static bool threaded_topology;
+
 protected:
    Operation last_operation;
 
@@ -218,6 +226,8 @@ protected:
    void ReadNURBSMesh(std::istream &input, int &curved, int &read_gf);
    void ReadInlineMesh(std::istream &input, bool generate_edges = false);
    void ReadGmshMesh(std::istream &input);
+   void ReadMFEMBinaryMesh(std::istream &input, int &curved);
+   void ReadMFEMBinaryNodes(std::istream &input);
    /* Note NetCDF (optional library) is used for reading cubit files */
 #ifdef MFEM_USE_NETCDF
    void ReadCubit(const char *filename, int &curved, int &read_gf);
@@ -372,6 +382,13 @@ protected:
        to vertex 1, etc. Returns the number of the edges. */
    int GetElementToEdgeTable(Table &, Array<int> &);
 
+   /** Sort-based versions of GetElementToEdgeTable(), GetElementToFaceTable()
+       and of the face loop of GenerateFaces() that process the elements in
+       parallel with OpenMP, used when threaded_topology is set. */
+   int GetElementToEdgeTableThreaded(Table &e_to_f, Array<int> &be_to_f);
+   void GetElementToFaceTableThreaded();
+   void GenerateFacesThreaded();
+
    /// Used in GenerateFaces()
    void AddPointFaceElement(int lf, int gf, int el);
 
@@ -404,6 +421,13 @@ protected:
    void Loader(std::istream &input, int generate_edges = 0,
                std::string parse_tag = "");
 
+   /** Load the mesh from the file @a filename if it is in the binary MFEM
+       format, see PrintBinary(), reading it through a memory map. Returns
+       false, without modifying the mesh, if the file is in another format or
+       memory maps are not supported. */
+   bool LoadBinaryMapped(const char *filename, int generate_edges, int refine,
+                         bool fix_orientation);
+
    // If NURBS mesh, write NURBS format. If NCMesh, write mfem v1.1 format.
    // If section_delimiter is empty, write mfem v1.0 format. Otherwise, write
    // mfem v1.2 format with the given section_delimiter at the end.
@@ -581,6 +605,11 @@ public:
        ReorderElements. This is a cheap alternative to GetGeckoElementOrdering.*/
    void GetHilbertElementOrdering(Array<int> &ordering);
 
+   /** Return an ordering of the elements along the Morton (Z-order) curve,
+       in the same format as GetHilbertElementOrdering. The Morton curve is
+       cheaper to compute, but its segments are less compact. */
+   void GetMortonElementOrdering(Array<int> &ordering);
+
    /** Rebuilds the mesh with a different order of elements. For each element i,
        the array ordering[i] contains its desired new index. Note that the method
        reorders vertices, edges and faces along with the elements. */
@@ -621,7 +650,8 @@ public:
 
    /** Creates mesh by reading a file in MFEM, Netgen, or VTK format. If
        generate_edges = 0 (default) edges are not generated, if 1 edges are
-       generated. */
+       generated. Files in the binary MFEM format, see PrintBinary(), are read
+       through a memory map when supported by the system. */
    explicit Mesh(const char *filename, int generate_edges = 0, int refine = 1,
                  bool fix_orientation = true);
 
@@ -701,14 +731,32 @@ public:
 
    /** @brief Return the mesh geometric factors corresponding to the given
        integration rule. */
+   /** The factors are cached by the Mesh and shared by all callers that use
+       an integration rule with the same points, e.g. the partial assembly
+       setup of all forms on this mesh. A cached entry is reused if it has
+       (at least) the requested @a flags; otherwise the factors are computed
+       for the union of the flags requested so far with that rule. The cache
+       is cleared when the mesh is refined or when its nodes are changed with
+       the Mesh methods, e.g. MoveNodes(), SetNodes() or Transform(). */
    const GeometricFactors* GetGeometricFactors(const IntegrationRule& ir,
                                                const int flags);
 
    /// Destroy all GeometricFactors stored by the Mesh.
    /** This method can be used to force recomputation of the GeometricFactors,
-       for example, after the mesh nodes are modified externally. */
+       for example, after the mesh nodes are modified externally. It also
+       destroys the ElementBVH used by FindPoints(), which depends on the nodes
+       as well. */
    void DeleteGeometricFactors();
 
+   /** @brief Return the bounding volume hierarchy of the element bounding
+       boxes, used by FindPoints(). */
+   /** The hierarchy is built on the first call and cached by the Mesh. It is
+       rebuilt when the mesh sequence changes, or when the vertex or node
+       coordinates differ from the ones it was built from, e.g. after the nodes
+       are modified in place through GetNodes(). The coordinates are compared
+       with a checksum, computed on every call. */
+   const ElementBVH &GetElementBVH();
+
    /// Equals 1 + num_holes - num_loops
    inline int EulerNumber() const
    { return NumOfVertices - NumOfEdges + NumOfFaces - NumOfElements; }
@@ -1006,6 +1054,28 @@ public:
    virtual void ReorientTetMesh();
 
    int *CartesianPartitioning(int nxyz[]);
+
+   /** @brief Partition the elements by splitting a space-filling curve through
+       their centers into @a nparts segments of equal total weight.
+
+       The curve is the one of GetHilbertElementOrdering, or of
+       GetMortonElementOrdering if @a morton is true. If @a elem_weights is
+       NULL, all elements have unit weight; otherwise, it gives a non-negative
+       weight for each element, e.g. its number of dofs on p-adaptive or mixed
+       meshes. If there are at least @a nparts elements, no part is empty. The
+       returned array must be deleted by the caller. METIS is not required. */
+   int *SpaceFillingCurvePartitioning(int nparts,
+                                      const Vector *elem_weights = NULL,
+                                      bool morton = false);
+
+   /** @brief Return a new array with the part of each element in a
+       partitioning of the mesh into @a nparts parts.
+
+       The values 0-5 of @a part_method select the METIS graph partitioner:
+       PartGraphRecursive (0, 3), PartGraphKway (1, 4) or PartGraphVKway
+       (2, 5), with sorted neighbor lists for 0-2. The values 6 and 7 select
+       SpaceFillingCurvePartitioning with the Hilbert or the Morton curve,
+       respectively, which do not require METIS. */
    int *GeneratePartitioning(int nparts, int part_method = 1);
    void CheckPartitioning(int *partitioning);
 
@@ -1162,6 +1232,19 @@ public:
    /// \see mfem::ogzstream() for on-the-fly compression of ascii outputs
    virtual void Print(std::ostream &out = mfem::out) const { Printer(out); }
 
+   /** @brief Print the mesh to the given stream using the binary MFEM mesh
+       format. */
+   /** After the text line "MFEM binary mesh v1.0", the format stores the mesh
+       sizes, followed by contiguous blocks for the attributes, geometries and
+       vertex indices of the elements and of the boundary elements, the vertex
+       coordinates (3 per vertex, as in mfem::Vertex) and, if the mesh is
+       curved, the nodes: the name of their FiniteElementCollection, the vector
+       dimension, the ordering and the values. Data is stored in the native
+       byte order, which is checked when reading. The format is read by
+       Load(), and by the constructor from a file name through a memory map.
+       Nonconforming and NURBS meshes are not supported. */
+   void PrintBinary(std::ostream &out) const;
+
    /// Print the mesh in VTK format (linear and quadratic meshes only).
    /// \see mfem::ogzstream() for on-the-fly compression of ascii outputs
    void PrintVTK(std::ostream &out);
@@ -1263,9 +1346,14 @@ public:
        The DenseMatrix @a point_mat describes the given points - one point for
        each column; it should have SpaceDimension() rows.
 
-       The InverseElementTransformation object, @a inv_trans, is used to attempt
-       the element transformation inversion. If NULL pointer is given, the
-       method will use a default constructed InverseElementTransformation. Note
+       The candidate elements of each point are the elements whose bounding
+       boxes contain it, found with the (cached) hierarchy returned by
+       GetElementBVH(). The InverseElementTransformation object, @a inv_trans,
+       is used to attempt the element transformation inversion on the
+       candidates. If NULL pointer is given, the method will use a default
+       constructed InverseElementTransformation; in that case, the points are
+       processed in parallel in builds with MFEM_USE_OPENMP and
+       MFEM_THREAD_SAFE. Note
        that the algorithms in the base class InverseElementTransformation can be
        completely overwritten by deriving custom classes that override the
        Transform() method.
@@ -1281,7 +1369,8 @@ public:
        @returns The total number of points that were found.
 
        @note This method is not 100 percent reliable, i.e. it is not guaranteed
-       to find a point, even if it lies inside a mesh element. */
+       to find a point, even if it lies inside a mesh element, e.g. when the
+       Newton iteration of @a inv_trans fails on a strongly curved element. */
    virtual int FindPoints(DenseMatrix& point_mat, Array<int>& elem_ids,
                           Array<IntegrationPoint>& ips, bool warn = true,
                           InverseElementTransformation *inv_trans = NULL);
@@ -1308,8 +1397,9 @@ class GeometricFactors
 {
 public:
    const Mesh *mesh;
-   const IntegrationRule *IntRule;
+   const IntegrationRule *IntRule; ///< Points to a copy of the rule
    int computed_factors;
+   long sequence; ///< Mesh sequence at the time the factors were computed
 
    enum FactorFlags
    {
@@ -1342,6 +1432,94 @@ public:
        - NQ = number of quadrature points per element, and
        - NE = number of elements in the mesh. */
    Vector detJ;
+
+protected:
+   IntegrationRule rule; ///< Copy of the rule, the key of the Mesh cache
+};
+
+
+/** @brief Bounding volume hierarchy over the bounding boxes of the elements of
+    a Mesh, used to locate points in the mesh. */
+/** The box of an element contains its vertices, or its nodes for a curved
+    mesh. Elements of order 1, and elements with a positive or NURBS basis, lie
+    in the convex hull of their nodes; the boxes of the other high-order
+    elements are enlarged by a fraction of their size, see ElementBVH(). The
+    hierarchy is a binary tree whose nodes are split at the median of the box
+    centers along their longest axis, so its depth is about log2(NE/4).
+
+    Typically objects of this type are constructed and owned by objects of class
+    Mesh. See Mesh::GetElementBVH(). */
+class ElementBVH
+{
+public:
+   Mesh *mesh;
+   long sequence; ///< Mesh sequence at the time the hierarchy was built
+   /// Checksum of the vertex or node coordinates, see GetChecksum().
+   unsigned long long checksum;
+
+   /** @brief Build the hierarchy for the current elements and nodes of
+       @a mesh. */
+   /** The boxes of high-order elements with a nodal (interpolatory) basis are
+       enlarged by @a curved_pad times their size in each direction. */
+   ElementBVH(Mesh *mesh, double curved_pad = 0.1);
+
+   /** @brief Return a checksum of the coordinates of the vertices of @a mesh,
+       or of its nodes for a curved mesh. */
+   static unsigned long long GetChecksum(const Mesh &mesh);
+
+   /// Return the ids of the elements whose bounding boxes contain @a x.
+   void FindCandidates(const double *x, Array<int> &elems) const;
+
+   /** @brief Locate the points given by the columns of @a point_mat, see
+       Mesh::FindPoints(). */
+   /** If @a inv_trans is NULL, the points are processed in parallel in builds
+       with MFEM_USE_OPENMP and MFEM_THREAD_SAFE, since the element
+       transformations are then evaluated concurrently. Returns the number of
+       points found. */
+   int FindPoints(const DenseMatrix &point_mat, Array<int> &elem_ids,
+                  Array<IntegrationPoint> &ips,
+                  InverseElementTransformation *inv_trans = NULL) const;
+
+   /// Return the number of nodes (inner nodes and leaves) of the tree.
+   int GetNNodes() const { return nodes.Size(); }
+
+   /// Return the depth of the tree, i.e. the number of levels below the root.
+   int GetDepth() const { return GetDepth(0); }
+
+protected:
+   struct Node
+   {
+      int child;      ///< The first of two consecutive children, -1 in leaves
+      int begin, end; ///< The range of the node elements in 'elems'
+   };
+
+   /// Maximum number of elements in a leaf of the tree.
+   static const int leaf_size = 4;
+
+   int sdim;
+   Array<Node> nodes;       ///< The root is nodes[0]
+   Array<double> node_box;  ///< Min. and max. corner of each node, 2*sdim each
+   Array<double> elem_box;  ///< Min. and max. corner of each element
+   Array<int> elems;        ///< Element ids, contiguous in each tree node
+
+   void ComputeElementBoxes(double curved_pad);
+   void Split(int n, const Array<double> &centers);
+   int GetDepth(int n) const;
+
+   bool InBox(const double *box, const double *x) const
+   {
+      for (int d = 0; d < sdim; d++)
+      {
+         if (x[d] < box[d] || x[d] > box[sdim + d]) { return false; }
+      }
+      return true;
+   }
+
+   /** Return the first candidate element in which @a inv_tr finds @a x, or -1.
+       The reference coordinates are returned in @a ip. */
+   int FindPoint(const double *x, IsoparametricTransformation &T,
+                 InverseElementTransformation &inv_tr,
+                 IntegrationPoint &ip) const;
 };
 
 
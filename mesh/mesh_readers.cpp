@@ -11,10 +11,20 @@
 
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
+#include "../general/binaryio.hpp"
 #include "../general/text.hpp"
 
 #include <iostream>
 #include <cstdio>
+#include <cstring>
+#include <streambuf>
+
+#ifndef _WIN32
+#include <fcntl.h>
+#include <sys/mman.h>
+#include <sys/stat.h>
+#include <unistd.h>
+#endif
 
 #ifdef MFEM_USE_NETCDF
 #include "netcdf.h"
@@ -1295,6 +1305,153 @@ void Mesh::ReadGmshMesh(std::istream &input)
 }
 
 
+// Read the elements written by PrintBinaryElements() in mesh.cpp.
+static void ReadBinaryElements(Mesh &mesh, std::istream &input, int ne,
+                               Array<Element *> &elems)
+{
+   Array<int> attr(ne), geom(ne);
+   MFEM_VERIFY(bin_io::read(input, attr.GetData(), ne) &&
+               bin_io::read(input, geom.GetData(), ne),
+               "error reading the binary mesh elements");
+   int nconn = 0;
+   for (int i = 0; i < ne; i++)
+   {
+      MFEM_VERIFY(geom[i] >= 0 && geom[i] < Geometry::NumGeom,
+                  "invalid geometry type: " << geom[i]);
+      nconn += Geometry::NumVerts[geom[i]];
+   }
+   Array<int> conn(nconn);
+   MFEM_VERIFY(bin_io::read(input, conn.GetData(), nconn),
+               "error reading the binary mesh elements");
+
+   elems.SetSize(ne);
+   for (int i = 0, k = 0; i < ne; i++)
+   {
+      Element *el = mesh.NewElement(geom[i]);
+      el->SetVertices(conn.GetData() + k);
+      el->SetAttribute(attr[i]);
+      k += el->GetNVertices();
+      elems[i] = el;
+   }
+}
+
+void Mesh::ReadMFEMBinaryMesh(std::istream &input, int &curved)
+{
+   int header[8];
+   MFEM_VERIFY(bin_io::read(input, header, 8), "invalid binary mesh file");
+   MFEM_VERIFY(header[0] == 0x01020304,
+               "the binary mesh file was written with a different byte order "
+               "or integer size");
+   Dim = header[1];
+   spaceDim = header[2];
+   NumOfElements = header[3];
+   NumOfBdrElements = header[4];
+   NumOfVertices = header[5];
+   curved = header[6];
+
+   ReadBinaryElements(*this, input, NumOfElements, elements);
+   ReadBinaryElements(*this, input, NumOfBdrElements, boundary);
+
+   static_assert(sizeof(Vertex) == 3*sizeof(double),
+                 "the binary format assumes 3 coordinates per Vertex");
+   vertices.SetSize(NumOfVertices);
+   MFEM_VERIFY(bin_io::read(input, vertices.GetData(), NumOfVertices),
+               "error reading the binary mesh vertices");
+}
+
+void Mesh::ReadMFEMBinaryNodes(std::istream &input)
+{
+   int info[4];
+   MFEM_VERIFY(bin_io::read(input, info, 4), "error reading the mesh nodes");
+   std::string name(info[0], ' ');
+   MFEM_VERIFY(bin_io::read(input, &name[0], info[0]),
+               "error reading the mesh nodes");
+
+   FiniteElementCollection *fec = FiniteElementCollection::New(name.c_str());
+   FiniteElementSpace *fes = new FiniteElementSpace(this, fec, info[1],
+                                                    info[2]);
+   Nodes = new GridFunction(fes);
+   Nodes->MakeOwner(fec);
+   own_nodes = 1;
+   MFEM_VERIFY(Nodes->Size() == info[3], "invalid size of the mesh nodes");
+   MFEM_VERIFY(bin_io::read(input, Nodes->HostWrite(), info[3]),
+               "error reading the mesh nodes");
+   spaceDim = Nodes->VectorDim();
+}
+
+namespace internal
+{
+
+// Read-only stream buffer over a memory region, used to parse memory mapped
+// files; the bulk reads of the binary formats become plain memory copies.
+class MemoryStreamBuf : public std::streambuf
+{
+public:
+   MemoryStreamBuf(char *data, std::size_t size)
+   { setg(data, data, data + size); }
+};
+
+#ifndef _WIN32
+// Read-only memory mapping of a file. The mapping is released by the
+// destructor, so it is not leaked when parsing the mapped data throws.
+class MappedFile
+{
+   void *addr;
+   std::size_t size;
+
+public:
+   MappedFile(const char *filename) : addr(MAP_FAILED), size(0)
+   {
+      const int fd = open(filename, O_RDONLY);
+      if (fd < 0) { return; }
+      struct stat st;
+      if (fstat(fd, &st) == 0 && st.st_size > 0)
+      {
+         size = st.st_size;
+         addr = mmap(NULL, size, PROT_READ, MAP_PRIVATE, fd, 0);
+      }
+      // the mapping stays valid after the file is closed
+      close(fd);
+   }
+
+   ~MappedFile() { if (IsMapped()) { munmap(addr, size); } }
+
+   bool IsMapped() const { return addr != MAP_FAILED; }
+   char *Data() const { return (char *) addr; }
+   std::size_t Size() const { return size; }
+
+private:
+   MappedFile(const MappedFile &);
+   MappedFile &operator=(const MappedFile &);
+};
+#endif
+
+} // namespace internal
+
+bool Mesh::LoadBinaryMapped(const char *filename, int generate_edges,
+                            int refine, bool fix_orientation)
+{
+#ifdef _WIN32
+   return false;
+#else
+   static const char magic[] = "MFEM binary mesh v1.0";
+   const std::size_t magic_len = sizeof(magic) - 1;
+
+   internal::MappedFile file(filename);
+   if (!file.IsMapped() || file.Size() <= magic_len ||
+       strncmp(file.Data(), magic, magic_len) != 0)
+   {
+      return false;
+   }
+   madvise(file.Data(), file.Size(), MADV_SEQUENTIAL);
+
+   internal::MemoryStreamBuf buf(file.Data(), file.Size());
+   std::istream input(&buf);
+   Load(input, generate_edges, refine, fix_orientation);
+   return true;
+#endif
+}
+
 #ifdef MFEM_USE_NETCDF
 void Mesh::ReadCubit(const char *filename, int &curved, int &read_gf)
 {
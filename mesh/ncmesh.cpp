@@ -1800,6 +1800,9 @@ void NCMesh::Derefine(const Array<int> &derefs)
       DerefineElement(parent);
    }
 
+   // release the ids freed by repeated derefinement
+   Compact(&fine_coarse);
+
    // update leaf_elements, Element::index etc.
    Update();
 
@@ -1841,6 +1844,121 @@ void NCMesh::SetDerefMatrixCodes(int parent, Array<int> &fine_coarse)
    }
 }
 
+bool NCMesh::Compact(Array<int> *elem_ids)
+{
+   bool compact_elements = 2*free_element_ids.Size() > elements.Size();
+   bool compact_nodes = 2*nodes.NumFreeIds() > nodes.NumIds();
+   bool compact_faces = 2*faces.NumFreeIds() > faces.NumIds();
+
+   if (compact_nodes)
+   {
+      // top-level vertex nodes are their own parents and index 'top_vertex_pos'
+      // so they need to keep their ids
+      int first_free = 0;
+      while (nodes.IdExists(first_free)) { first_free++; }
+      for (int id = first_free + 1; id < nodes.NumIds(); id++)
+      {
+         if (nodes.IdExists(id) && nodes[id].p1 == nodes[id].p2)
+         {
+            compact_nodes = false;
+            break;
+         }
+      }
+   }
+   if (!compact_elements && !compact_nodes && !compact_faces) { return false; }
+
+   // renumber the nodes first, the faces are hashed by their node ids
+   Array<int> node_map, face_map;
+   if (compact_nodes)
+   {
+      nodes.Compact(node_map, &node_map);
+      faces.Compact(face_map, &node_map);
+   }
+   else if (compact_faces)
+   {
+      faces.Compact(face_map);
+   }
+
+   Array<int> elem_map;
+   if (compact_elements)
+   {
+      // the root elements are never freed, so they keep their ids
+      elem_map.SetSize(elements.Size());
+      int num_elements = 0;
+      for (int i = 0; i < elements.Size(); i++)
+      {
+         elem_map[i] = (elements[i].parent != -2) ? num_elements++ : -1;
+      }
+      for (int i = 0; i < elements.Size(); i++)
+      {
+         if (elem_map[i] >= 0 && elem_map[i] != i)
+         {
+            elements[elem_map[i]] = elements[i];
+         }
+      }
+      elements.Truncate(num_elements);
+      free_element_ids.DeleteAll();
+   }
+
+   for (int i = 0; i < elements.Size(); i++)
+   {
+      Element &el = elements[i];
+      if (el.parent == -2) { continue; } // free, only if !compact_elements
+      if (el.ref_type)
+      {
+         if (compact_elements)
+         {
+            for (int j = 0; j < 8 && el.child[j] >= 0; j++)
+            {
+               el.child[j] = elem_map[el.child[j]];
+            }
+         }
+      }
+      else if (compact_nodes)
+      {
+         for (int j = 0; j < 8; j++)
+         {
+            if (el.node[j] >= 0) { el.node[j] = node_map[el.node[j]]; }
+         }
+      }
+      if (compact_elements && el.parent >= 0)
+      {
+         el.parent = elem_map[el.parent];
+      }
+   }
+
+   if (compact_elements)
+   {
+      for (face_iterator face = faces.begin(); face != faces.end(); ++face)
+      {
+         for (int i = 0; i < 2; i++)
+         {
+            if (face->elem[i] >= 0) { face->elem[i] = elem_map[face->elem[i]]; }
+         }
+      }
+
+      Array<int>* lists[2] = { &coarse_elements, elem_ids };
+      for (int k = 0; k < 2; k++)
+      {
+         if (!lists[k]) { continue; }
+         for (int i = 0; i < lists[k]->Size(); i++)
+         {
+            int &id = (*lists[k])[i];
+            if (id >= 0) { id = elem_map[id]; }
+         }
+      }
+   }
+
+   // the secondary data is rebuilt by Update(), release its storage as well
+   vertex_list.Clear(true);
+   face_list.Clear(true);
+   edge_list.Clear(true);
+   boundary_faces.DeleteAll();
+   leaf_elements.DeleteAll();
+   vertex_nodeId.DeleteAll();
+   return true;
+}
+
 
 //// Mesh Interface ////////////////////////////////////////////////////////////
 
@@ -5135,10 +5253,17 @@ long NCMesh::MemoryUsage() const
 
 int NCMesh::PrintMemoryDetail() const
 {
-   nodes.PrintMemoryDetail(); mfem::out << " nodes\n";
-   faces.PrintMemoryDetail(); mfem::out << " faces\n";
-
-   mfem::out << elements.MemoryUsage() << " elements\n"
+   nodes.PrintMemoryDetail();
+   mfem::out << " nodes (" << nodes.Size() << " used + "
+             << nodes.NumFreeIds() << " free, " << sizeof(Node) << " B each)\n";
+   faces.PrintMemoryDetail();
+   mfem::out << " faces (" << faces.Size() << " used + "
+             << faces.NumFreeIds() << " free, " << sizeof(Face) << " B each)\n";
+
+   mfem::out << elements.MemoryUsage() << " elements ("
+             << elements.Size() - free_element_ids.Size() << " used + "
+             << free_element_ids.Size() << " free, "
+             << sizeof(Element) << " B each)\n"
              << free_element_ids.MemoryUsage() << " free_element_ids\n"
              << root_state.MemoryUsage() << " root_state\n"
              << top_vertex_pos.MemoryUsage() << " top_vertex_pos\n"
@@ -5153,7 +5278,8 @@ int NCMesh::PrintMemoryDetail() const
              << derefinements.MemoryUsage() << " derefinements\n"
              << transforms.MemoryUsage() << " transforms\n"
              << coarse_elements.MemoryUsage() << " coarse_elements\n"
-             << sizeof(*this) << " NCMesh"
+             << sizeof(*this) << " NCMesh\n"
+             << MemoryUsage() << " NCMesh total"
              << std::endl;
 
    return elements.Size() - free_element_ids.Size();
@@ -551,6 +551,14 @@ protected: // implementation
       elements[id].parent = -2; // mark the element as free
    }
 
+   /** Remove the unused element, node and face ids once they make up more
+       than half of their container, renumbering the remaining ids in their
+       original order. The memory of the removed items and of the secondary
+       data is released. Element ids stored in @a elem_ids are renumbered too.
+       Returns true if anything changed, in which case Update() is needed.
+       Only called by the serial Derefine(): ParNCMesh does not compact. */
+   bool Compact(Array<int> *elem_ids = NULL);
+
    int NewHexahedron(int n0, int n1, int n2, int n3,
                      int n4, int n5, int n6, int n7, int attr,
                      int fattr0, int fattr1, int fattr2,
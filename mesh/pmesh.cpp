@@ -15,6 +15,7 @@
 
 #include "mesh_headers.hpp"
 #include "../fem/fem.hpp"
+#include "../general/binaryio.hpp"
 #include "../general/sets.hpp"
 #include "../general/sort_pairs.hpp"
 #include "../general/text.hpp"
@@ -22,6 +23,7 @@
 
 #include <iostream>
 #include <fstream>
+#include <algorithm>
 
 using namespace std;
 
@@ -1057,6 +1059,746 @@ ParMesh::ParMesh(MPI_Comm comm, istream &input, bool refine)
    // TODO: AMR meshes, NURBS meshes?
 }
 
+// Begin of the slice of rank 'r' when 'n' entries are split into 'np'
+// contiguous slices.
+static inline long long SliceBegin(long long n, int np, int r)
+{
+   return n*r/np;
+}
+
+// Rank whose slice contains entry 'i', see SliceBegin().
+static int SliceOwner(long long n, int np, long long i)
+{
+   int r = (int)(i*np/n);
+   while (r > 0 && SliceBegin(n, np, r) > i) { r--; }
+   while (r+1 < np && SliceBegin(n, np, r+1) <= i) { r++; }
+   return r;
+}
+
+// Read 'n' values of type T starting at position 'pos' of the stream.
+template <typename T>
+static void ReadBinaryBlock(istream &input, streamoff pos, T *data,
+                            long long n)
+{
+   input.seekg(pos);
+   MFEM_VERIFY(bin_io::read(input, data, n),
+               "error reading the binary mesh file");
+}
+
+// Personalized exchange: the data for rank p is send[k] for k in
+// [send_off[p],send_off[p+1]); on return, the data received from rank p is
+// recv[k] for k in [recv_off[p],recv_off[p+1]). Only the ranks with data to
+// send are contacted: the senders are discovered with MPI_Iprobe and the end
+// of the exchange is detected with a nonblocking barrier that is entered once
+// all synchronous sends were received. Consecutive calls must use different
+// tags, since a rank may start the next exchange while others are still
+// completing the barrier.
+template <typename T>
+static void ExchangeData(MPI_Comm comm, int tag, const Array<int> &send_off,
+                         const Array<T> &send, Array<int> &recv_off,
+                         Array<T> &recv)
+{
+   int np, rank;
+   MPI_Comm_size(comm, &np);
+   MPI_Comm_rank(comm, &rank);
+   const MPI_Datatype type = MPITypeMap<T>::mpi_type;
+   Array<MPI_Request> send_req;
+   for (int p = 0; p < np; p++)
+   {
+      const int cnt = send_off[p+1] - send_off[p];
+      if (cnt == 0 || p == rank) { continue; }
+      send_req.Append(MPI_REQUEST_NULL);
+      MPI_Issend(const_cast<T*>(send.GetData()) + send_off[p], cnt, type, p,
+                 tag, comm, &send_req.Last());
+   }
+
+   // the messages are received in arrival order, then sorted by source
+   Array<int> recv_cnt(np), recv_pos(np);
+   Array<T> buf(send_off[rank+1] - send_off[rank]);
+   recv_cnt = 0;
+   recv_cnt[rank] = buf.Size();
+   recv_pos[rank] = 0;
+   for (int k = 0; k < buf.Size(); k++) { buf[k] = send[send_off[rank]+k]; }
+   MPI_Request barrier = MPI_REQUEST_NULL;
+   for (int done = 0; !done; )
+   {
+      int flag;
+      MPI_Status status;
+      MPI_Iprobe(MPI_ANY_SOURCE, tag, comm, &flag, &status);
+      if (flag)
+      {
+         const int p = status.MPI_SOURCE;
+         MPI_Get_count(&status, type, &recv_cnt[p]);
+         recv_pos[p] = buf.Size();
+         buf.SetSize(buf.Size() + recv_cnt[p]);
+         MPI_Recv(buf.GetData() + recv_pos[p], recv_cnt[p], type, p, tag,
+                  comm, MPI_STATUS_IGNORE);
+      }
+      if (barrier != MPI_REQUEST_NULL)
+      {
+         MPI_Test(&barrier, &done, MPI_STATUS_IGNORE);
+      }
+      else
+      {
+         int sent;
+         MPI_Testall(send_req.Size(), send_req.GetData(), &sent,
+                     MPI_STATUSES_IGNORE);
+         if (sent) { MPI_Ibarrier(comm, &barrier); }
+      }
+   }
+
+   recv_off.SetSize(np+1);
+   recv_off[0] = 0;
+   for (int p = 0; p < np; p++)
+   {
+      recv_off[p+1] = recv_off[p] + recv_cnt[p];
+   }
+   recv.SetSize(recv_off[np]);
+   for (int p = 0; p < np; p++)
+   {
+      for (int k = 0; k < recv_cnt[p]; k++)
+      {
+         recv[recv_off[p]+k] = buf[recv_pos[p]+k];
+      }
+   }
+}
+
+// List of variable-size integer records, each with a destination rank.
+struct RecordList
+{
+   Array<int> dest, offsets, data;
+
+   RecordList() : offsets(1) { offsets[0] = 0; }
+
+   // Call after appending the entries of a record to 'data'.
+   void Finish(int rank) { dest.Append(rank); offsets.Append(data.Size()); }
+
+   // Send the records to their destinations, see ExchangeData(). On return,
+   // 'recv' holds the records received from all ranks.
+   void Exchange(MPI_Comm comm, int tag, Array<int> &recv_off,
+                 Array<int> &recv) const
+   {
+      int np;
+      MPI_Comm_size(comm, &np);
+      Array<int> send_off(np+1), send(data.Size()), pos(np);
+      send_off = 0;
+      for (int i = 0; i < dest.Size(); i++)
+      {
+         send_off[dest[i]+1] += offsets[i+1] - offsets[i];
+      }
+      send_off.PartialSum();
+      for (int p = 0; p < np; p++) { pos[p] = send_off[p]; }
+      for (int i = 0; i < dest.Size(); i++)
+      {
+         for (int k = offsets[i]; k < offsets[i+1]; k++)
+         {
+            send[pos[dest[i]]++] = data[k];
+         }
+      }
+      ExchangeData(comm, tag, send_off, send, recv_off, recv);
+   }
+};
+
+// An edge or face exchanged by the distributed reader: the indices of its
+// vertices, in the given orientation and sorted, the latter being used for
+// ordering the entities consistently on all ranks. The fourth vertex of edges
+// and triangles is -1.
+struct DistEntity
+{
+   int group, v[4], key[4], rank;
+
+   void SetKey()
+   {
+      for (int j = 0; j < 4; j++) { key[j] = v[j]; }
+      std::sort(key, key + ((key[2] < 0) ? 2 : (key[3] < 0) ? 3 : 4));
+   }
+
+   bool SameKey(const DistEntity &other) const
+   {
+      return std::equal(key, key + 4, other.key);
+   }
+
+   bool operator<(const DistEntity &other) const
+   {
+      if (group != other.group) { return group < other.group; }
+      for (int j = 0; j < 4; j++)
+      {
+         if (key[j] != other.key[j]) { return key[j] < other.key[j]; }
+      }
+      return rank < other.rank;
+   }
+};
+
+// Oriented vertices of the faces of a 3D element, with -1 as the fourth
+// vertex of triangular faces; returns the number of faces.
+static int GetElementFaceVertices(const Element *el, int fv[][4])
+{
+   typedef Geometry::Constants<Geometry::TETRAHEDRON> tet_t;
+   typedef Geometry::Constants<Geometry::CUBE>        hex_t;
+   typedef Geometry::Constants<Geometry::PRISM>       pri_t;
+
+   const int *v = el->GetVertices();
+   int nf = 0;
+   switch (el->GetType())
+   {
+      case Element::TETRAHEDRON:
+         for (nf = 0; nf < 4; nf++)
+         {
+            const int *f = tet_t::FaceVert[nf];
+            fv[nf][0] = v[f[0]]; fv[nf][1] = v[f[1]]; fv[nf][2] = v[f[2]];
+            fv[nf][3] = -1;
+         }
+         break;
+      case Element::WEDGE:
+         for (nf = 0; nf < 5; nf++)
+         {
+            const int *f = pri_t::FaceVert[nf];
+            fv[nf][0] = v[f[0]]; fv[nf][1] = v[f[1]]; fv[nf][2] = v[f[2]];
+            fv[nf][3] = (nf < 2) ? -1 : v[f[3]];
+         }
+         break;
+      case Element::HEXAHEDRON:
+         for (nf = 0; nf < 6; nf++)
+         {
+            const int *f = hex_t::FaceVert[nf];
+            for (int j = 0; j < 4; j++) { fv[nf][j] = v[f[j]]; }
+         }
+         break;
+      default:
+         MFEM_ABORT("Unexpected type of Element.");
+   }
+   return nf;
+}
+
+// Index of the face with the given vertices in 'faces_tbl', or -1.
+static int FindFace(const STable3D &faces_tbl, const int *v)
+{
+   if (v[3] < 0) { return faces_tbl.Index(v[0], v[1], v[2]); }
+   int w[4] = { v[0], v[1], v[2], v[3] };
+   std::sort(w, w + 4);
+   return faces_tbl.Index(w[0], w[1], w[2]);
+}
+
+ParMesh::ParMesh(MPI_Comm comm, const char *filename, bool refine,
+                 bool fix_orientation)
+   : gtopo(comm)
+{
+   MyComm = comm;
+   MPI_Comm_size(MyComm, &NRanks);
+   MPI_Comm_rank(MyComm, &MyRank);
+
+   have_face_nbr_data = false;
+   pncmesh = NULL;
+
+   // 1. Read the header and the local slices of the elements and of the
+   //    boundary elements, see Mesh::PrintBinary() for the file layout.
+   ifstream input(filename, ios::in | ios::binary);
+   MFEM_VERIFY(input.good(), "Mesh file not found: " << filename);
+   string ident;
+   getline(input, ident);
+   filter_dos(ident);
+   MFEM_VERIFY(ident == "MFEM binary mesh v1.0",
+               "not a binary MFEM mesh: " << filename);
+   int header[8];
+   MFEM_VERIFY(bin_io::read(input, header, 8) && header[0] == 0x01020304,
+               "invalid binary mesh file or different byte order");
+   Dim = header[1];
+   spaceDim = header[2];
+   const long long glob_ne = header[3], glob_nbe = header[4];
+   const long long glob_nv = header[5];
+   MFEM_VERIFY(header[6] == 0, "curved meshes are not supported");
+   MFEM_VERIFY(glob_nv >= NRanks, "the mesh has fewer vertices than ranks");
+   int xtag = 1000; // the tag of the next ExchangeData() call
+
+   Array<int> attr, geom, conn, bdr_attr, bdr_geom, bdr_conn;
+   long long bdr_begin = 0;
+   streamoff vert_pos = input.tellg();
+   for (int b = 0; b < 2; b++)
+   {
+      const long long glob_n = b ? glob_nbe : glob_ne;
+      const long long begin = SliceBegin(glob_n, NRanks, MyRank);
+      const int n = SliceBegin(glob_n, NRanks, MyRank+1) - begin;
+      Array<int> &a = b ? bdr_attr : attr, &g = b ? bdr_geom : geom;
+      Array<int> &c = b ? bdr_conn : conn;
+      if (b) { bdr_begin = begin; }
+
+      a.SetSize(n);
+      g.SetSize(n);
+      ReadBinaryBlock(input, vert_pos + begin*sizeof(int), a.GetData(), n);
+      ReadBinaryBlock(input, vert_pos + (glob_n + begin)*sizeof(int),
+                      g.GetData(), n);
+      long long nconn = 0, conn_begin = 0, glob_nconn = 0;
+      for (int i = 0; i < n; i++)
+      {
+         MFEM_VERIFY(g[i] >= 0 && g[i] < Geometry::NumGeom,
+                     "invalid geometry type: " << g[i]);
+         nconn += Geometry::NumVerts[g[i]];
+      }
+      MPI_Exscan(&nconn, &conn_begin, 1, MPI_LONG_LONG, MPI_SUM, MyComm);
+      if (MyRank == 0) { conn_begin = 0; }
+      MPI_Allreduce(&nconn, &glob_nconn, 1, MPI_LONG_LONG, MPI_SUM, MyComm);
+      c.SetSize(nconn);
+      ReadBinaryBlock(input, vert_pos + (2*glob_n + conn_begin)*sizeof(int),
+                      c.GetData(), nconn);
+      vert_pos += (2*glob_n + glob_nconn)*sizeof(int);
+   }
+   NumOfElements = attr.Size();
+
+   // 2. Number the local vertices following the global order. Each rank owns
+   //    a slice of the vertices: it reads their coordinates and collects the
+   //    ranks using each of them.
+   Array<int> lvert(conn);
+   lvert.Sort();
+   lvert.Unique();
+   NumOfVertices = lvert.Size();
+
+   const long long v_begin = SliceBegin(glob_nv, NRanks, MyRank);
+   const int nv_slice = SliceBegin(glob_nv, NRanks, MyRank+1) - v_begin;
+   Table slice_ranks; // the ranks using each vertex of the slice
+   Table vert_ranks;  // the ranks using each local vertex, if shared
+   {
+      // the local vertices are sorted, so they are grouped by owner
+      Array<int> req_off(NRanks+1), req_recv_off, req_recv;
+      req_off = 0;
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         req_off[SliceOwner(glob_nv, NRanks, lvert[i])+1]++;
+      }
+      req_off.PartialSum();
+      ExchangeData(MyComm, xtag++, req_off, lvert, req_recv_off, req_recv);
+
+      slice_ranks.MakeI(nv_slice);
+      for (int k = 0; k < req_recv.Size(); k++)
+      {
+         slice_ranks.AddAColumnInRow(req_recv[k] - v_begin);
+      }
+      slice_ranks.MakeJ();
+      for (int p = 0; p < NRanks; p++)
+      {
+         for (int k = req_recv_off[p]; k < req_recv_off[p+1]; k++)
+         {
+            slice_ranks.AddConnection(req_recv[k] - v_begin, p);
+         }
+      }
+      slice_ranks.ShiftUpI();
+
+      // send back the coordinates of the requested vertices
+      Array<double> coords(3*nv_slice), coords_send(3*req_recv.Size());
+      ReadBinaryBlock(input, vert_pos + v_begin*3*sizeof(double),
+                      coords.GetData(), 3*nv_slice);
+      for (int k = 0; k < req_recv.Size(); k++)
+      {
+         for (int d = 0; d < 3; d++)
+         {
+            coords_send[3*k+d] = coords[3*(req_recv[k]-v_begin)+d];
+         }
+      }
+      Array<int> coords_send_off(NRanks+1), coords_recv_off;
+      Array<double> coords_recv;
+      for (int p = 0; p <= NRanks; p++)
+      {
+         coords_send_off[p] = 3*req_recv_off[p];
+      }
+      ExchangeData(MyComm, xtag++, coords_send_off, coords_send,
+                   coords_recv_off, coords_recv);
+      vertices.SetSize(NumOfVertices);
+      for (int i = 0; i < NumOfVertices; i++)
+      {
+         for (int d = 0; d < 3; d++)
+         {
+            vertices[i](d) = coords_recv[3*i+d];
+         }
+      }
+
+      // send back the ranks using the requested vertices: their number,
+      // followed by the ranks if there is more than one
+      RecordList rec;
+      for (int p = 0; p < NRanks; p++)
+      {
+         for (int k = req_recv_off[p]; k < req_recv_off[p+1]; k++)
+         {
+            const int n = slice_ranks.RowSize(req_recv[k] - v_begin);
+            const int *row = slice_ranks.GetRow(req_recv[k] - v_begin);
+            rec.data.Append(n);
+            if (n > 1) { rec.data.Append(row, n); }
+            rec.Finish(p);
+         }
+      }
+      Array<int> ranks_off, ranks;
+      rec.Exchange(MyComm, xtag++, ranks_off, ranks);
+      vert_ranks.MakeI(NumOfVertices);
+      for (int i = 0, k = 0; i < NumOfVertices; i++)
+      {
+         const int n = ranks[k];
+         if (n > 1) { vert_ranks.AddColumnsInRow(i, n); }
+         k += (n > 1) ? n + 1 : 1;
+      }
+      vert_ranks.MakeJ();
+      for (int i = 0, k = 0; i < NumOfVertices; i++)
+      {
+         const int n = ranks[k];
+         if (n > 1) { vert_ranks.AddConnections(i, &ranks[k+1], n); }
+         k += (n > 1) ? n + 1 : 1;
+      }
+      vert_ranks.ShiftUpI();
+   }
+
+   // 3. Create the local elements.
+   elements.SetSize(NumOfElements);
+   for (int i = 0, k = 0; i < NumOfElements; i++)
+   {
+      const int nv = Geometry::NumVerts[geom[i]];
+      for (int j = 0; j < nv; j++)
+      {
+         conn[k+j] = lvert.FindSorted(conn[k+j]);
+      }
+      elements[i] = NewElement(geom[i]);
+      elements[i]->SetVertices(conn.GetData() + k);
+      elements[i]->SetAttribute(attr[i]);
+      k += nv;
+   }
+
+   // 4. Find the shared edges and faces: the local edges (faces) whose
+   //    vertices are all shared are sent to the owner of their smallest
+   //    vertex, which returns the ranks containing each of them. The
+   //    orientation of a shared face is the one in the lowest such rank.
+   Array<DistEntity> sedges, sfaces;
+   Array<int> sedge_ranks, sface_ranks; // the ranks of each shared entity
+   Array<int> sedge_off(1), sface_off(1);
+   sedge_off[0] = sface_off[0] = 0;
+   DSTable v_to_v(NumOfVertices);
+   STable3D *faces_tbl = NULL;
+   if (Dim > 1) { GetVertexToVertexTable(v_to_v); }
+   if (Dim > 2) { faces_tbl = GetFacesTable(); }
+   for (int fdim = 1; fdim < Dim; fdim++)
+   {
+      // records: the global indices of the 4 oriented vertices (or -1)
+      RecordList rec;
+      if (fdim == 1)
+      {
+         for (int a = 0; a < NumOfVertices; a++)
+         {
+            if (vert_ranks.RowSize(a) == 0) { continue; }
+            for (DSTable::RowIterator it(v_to_v, a); !it; ++it)
+            {
+               const int b = it.Column();
+               if (vert_ranks.RowSize(b) == 0) { continue; }
+               const int rv[4] = { lvert[a], lvert[b], -1, -1 };
+               rec.data.Append(rv, 4);
+               rec.Finish(SliceOwner(glob_nv, NRanks, lvert[a]));
+            }
+         }
+      }
+      else
+      {
+         Array<bool> done(faces_tbl->NumberOfElements());
+         done = false;
+         int fv[6][4];
+         for (int i = 0; i < NumOfElements; i++)
+         {
+            const int nf = GetElementFaceVertices(elements[i], fv);
+            for (int f = 0; f < nf; f++)
+            {
+               const int fi = FindFace(*faces_tbl, fv[f]);
+               if (done[fi]) { continue; }
+               done[fi] = true;
+               const int nfv = (fv[f][3] < 0) ? 3 : 4;
+               int vmin = fv[f][0], j;
+               for (j = 0; j < nfv && vert_ranks.RowSize(fv[f][j]); j++)
+               {
+                  vmin = std::min(vmin, fv[f][j]);
+               }
+               if (j < nfv) { continue; }
+               for (j = 0; j < 4; j++)
+               {
+                  rec.data.Append((j < nfv) ? lvert[fv[f][j]] : -1);
+               }
+               rec.Finish(SliceOwner(glob_nv, NRanks, lvert[vmin]));
+            }
+         }
+      }
+      Array<int> recv_off, recv;
+      rec.Exchange(MyComm, xtag++, recv_off, recv);
+
+      // owner side: entities with the same vertices are consecutive after
+      // sorting; reply with the oriented vertices and the ranks
+      Array<DistEntity> ent(recv.Size()/4);
+      for (int p = 0, k = 0; p < NRanks; p++)
+      {
+         for ( ; 4*k < recv_off[p+1]; k++)
+         {
+            for (int j = 0; j < 4; j++) { ent[k].v[j] = recv[4*k+j]; }
+            ent[k].SetKey();
+            ent[k].group = 0;
+            ent[k].rank = p;
+         }
+      }
+      ent.Sort();
+      RecordList reply;
+      for (int k = 0, l; k < ent.Size(); k = l)
+      {
+         for (l = k+1; l < ent.Size() && ent[l].SameKey(ent[k]); l++) { }
+         if (l - k == 1) { continue; }
+         for (int m = k; m < l; m++)
+         {
+            reply.data.Append(ent[k].v, 4);
+            reply.data.Append(l - k);
+            for (int j = k; j < l; j++) { reply.data.Append(ent[j].rank); }
+            reply.Finish(ent[m].rank);
+         }
+      }
+      reply.Exchange(MyComm, xtag++, recv_off, recv);
+
+      Array<DistEntity> &sent = (fdim == 1) ? sedges : sfaces;
+      Array<int> &sent_ranks = (fdim == 1) ? sedge_ranks : sface_ranks;
+      Array<int> &sent_off = (fdim == 1) ? sedge_off : sface_off;
+      for (int k = 0; k < recv.Size(); )
+      {
+         DistEntity e;
+         for (int j = 0; j < 4; j++)
+         {
+            e.v[j] = (recv[k+j] < 0) ? -1 : lvert.FindSorted(recv[k+j]);
+         }
+         e.SetKey();
+         e.group = -1; // set below
+         e.rank = sent.Size();
+         sent.Append(e);
+         sent_ranks.Append(&recv[k+5], recv[k+4]);
+         sent_off.Append(sent_ranks.Size());
+         k += 5 + recv[k+4];
+      }
+   }
+
+   // 5. Create the groups and the shared entities. Sorting by local indices
+   //    gives the same order on all ranks, as the local numbering of the
+   //    vertices follows the global one.
+   ListOfIntegerSets groups;
+   {
+      // the first group is the local one
+      IntegerSet group;
+      group.Recreate(1, &MyRank);
+      groups.Insert(group);
+   }
+   Array<Pair<int,int> > svert;
+   for (int i = 0; i < NumOfVertices; i++)
+   {
+      if (vert_ranks.RowSize(i) == 0) { continue; }
+      IntegerSet group(vert_ranks.RowSize(i), vert_ranks.GetRow(i));
+      svert.Append(Pair<int,int>(groups.Insert(group) - 1, i));
+   }
+   for (int fdim = 1; fdim < Dim; fdim++)
+   {
+      Array<DistEntity> &sent = (fdim == 1) ? sedges : sfaces;
+      const Array<int> &sent_ranks = (fdim == 1) ? sedge_ranks : sface_ranks;
+      const Array<int> &sent_off = (fdim == 1) ? sedge_off : sface_off;
+      for (int i = 0; i < sent.Size(); i++)
+      {
+         const int k = sent_off[i];
+         IntegerSet group(sent_off[i+1] - k, sent_ranks.GetData() + k);
+         sent[i].group = groups.Insert(group) - 1;
+      }
+      sent.Sort();
+   }
+   gtopo.Create(groups, 822);
+   const int ngroups = groups.Size()-1;
+
+   // stable, to keep the (global) order of the vertices within each group
+   std::stable_sort(svert.begin(), svert.end());
+   svert_lvert.SetSize(svert.Size());
+   group_svert.MakeI(ngroups);
+   for (int i = 0; i < svert.Size(); i++)
+   {
+      group_svert.AddAColumnInRow(svert[i].one);
+   }
+   group_svert.MakeJ();
+   for (int i = 0; i < svert.Size(); i++)
+   {
+      group_svert.AddConnection(svert[i].one, i);
+      svert_lvert[i] = svert[i].two;
+   }
+   group_svert.ShiftUpI();
+
+   group_sedge.MakeI(ngroups);
+   for (int i = 0; i < sedges.Size(); i++)
+   {
+      group_sedge.AddAColumnInRow(sedges[i].group);
+   }
+   group_sedge.MakeJ();
+   shared_edges.SetSize(sedges.Size());
+   for (int i = 0; i < sedges.Size(); i++)
+   {
+      group_sedge.AddConnection(sedges[i].group, i);
+      shared_edges[i] = new Segment(sedges[i].v[0], sedges[i].v[1], 1);
+   }
+   group_sedge.ShiftUpI();
+
+   group_stria.MakeI(ngroups);
+   group_squad.MakeI(ngroups);
+   for (int i = 0; i < sfaces.Size(); i++)
+   {
+      if (sfaces[i].v[3] < 0)
+      {
+         group_stria.AddAColumnInRow(sfaces[i].group);
+      }
+      else
+      {
+         group_squad.AddAColumnInRow(sfaces[i].group);
+      }
+   }
+   group_stria.MakeJ();
+   group_squad.MakeJ();
+   for (int i = 0; i < sfaces.Size(); i++)
+   {
+      const int *v = sfaces[i].v;
+      if (v[3] < 0)
+      {
+         group_stria.AddConnection(sfaces[i].group, shared_trias.Size());
+         shared_trias.Append(Vert3(v[0], v[1], v[2]));
+      }
+      else
+      {
+         group_squad.AddConnection(sfaces[i].group, shared_quads.Size());
+         shared_quads.Append(Vert4(v[0], v[1], v[2], v[3]));
+      }
+   }
+   group_stria.ShiftUpI();
+   group_squad.ShiftUpI();
+
+   // 6. Boundary elements: they are sent to the owner of their smallest
+   //    vertex, which forwards them to the ranks using that vertex. A rank
+   //    keeps the boundary elements that are faces of its elements; if such
+   //    a face is shared, the boundary element is kept by the lower rank.
+   {
+      // records: global index, attribute, geometry, global vertex indices
+      RecordList rec;
+      for (int i = 0, k = 0; i < bdr_attr.Size(); i++)
+      {
+         const int nv = Geometry::NumVerts[bdr_geom[i]];
+         int vmin = bdr_conn[k];
+         rec.data.Append(bdr_begin + i);
+         rec.data.Append(bdr_attr[i]);
+         rec.data.Append(bdr_geom[i]);
+         for (int j = 0; j < nv; j++, k++)
+         {
+            rec.data.Append(bdr_conn[k]);
+            vmin = std::min(vmin, bdr_conn[k]);
+         }
+         rec.Finish(SliceOwner(glob_nv, NRanks, vmin));
+      }
+      Array<int> recv_off, recv;
+      rec.Exchange(MyComm, xtag++, recv_off, recv);
+
+      RecordList fwd;
+      for (int k = 0; k < recv.Size(); )
+      {
+         const int nv = Geometry::NumVerts[recv[k+2]];
+         const int vmin = *std::min_element(&recv[k+3], &recv[k+3] + nv);
+         const int *row = slice_ranks.GetRow(vmin - v_begin);
+         for (int j = 0; j < slice_ranks.RowSize(vmin - v_begin); j++)
+         {
+            fwd.data.Append(&recv[k], 3 + nv);
+            fwd.Finish(row[j]);
+         }
+         k += 3 + nv;
+      }
+      fwd.Exchange(MyComm, xtag++, recv_off, recv);
+
+      // the rank sharing each local edge (2D) or face (3D), if any
+      Array<int> other;
+      if (Dim > 1)
+      {
+         Array<DistEntity> &sent = (Dim == 2) ? sedges : sfaces;
+         const Array<int> &sent_ranks = (Dim == 2) ? sedge_ranks : sface_ranks;
+         const Array<int> &sent_off = (Dim == 2) ? sedge_off : sface_off;
+         other.SetSize((Dim == 2) ? v_to_v.NumberOfEntries() :
+                       faces_tbl->NumberOfElements());
+         other = -1;
+         for (int i = 0; i < sent.Size(); i++)
+         {
+            const int *v = sent[i].v;
+            const int fi = (Dim == 2) ? v_to_v(v[0], v[1]) :
+                           FindFace(*faces_tbl, v);
+            // the index of sent[i] before sorting is in sent[i].rank
+            const int s = sent[i].rank;
+            for (int j = sent_off[s]; j < sent_off[s+1]; j++)
+            {
+               if (sent_ranks[j] != MyRank) { other[fi] = sent_ranks[j]; }
+            }
+         }
+      }
+
+      Array<Pair<int,int> > kept; // (global index, position in recv)
+      for (int k = 0; k < recv.Size(); )
+      {
+         const int nv = Geometry::NumVerts[recv[k+2]];
+         int v[4] = { -1, -1, -1, -1 }, j;
+         for (j = 0; j < nv; j++)
+         {
+            v[j] = lvert.FindSorted(recv[k+3+j]);
+            if (v[j] < 0) { break; }
+         }
+         bool keep = false;
+         if (j == nv)
+         {
+            int fi, orank = -1;
+            switch (Dim)
+            {
+               case 1:
+                  // a shared vertex is kept by the lowest rank using it
+                  if (vert_ranks.RowSize(v[0]) > 0)
+                  {
+                     orank = vert_ranks.GetRow(v[0])[0];
+                  }
+                  keep = (orank < 0 || orank == MyRank);
+                  break;
+               case 2:
+                  fi = v_to_v(v[0], v[1]);
+                  keep = (fi >= 0 && (other[fi] < 0 || MyRank < other[fi]));
+                  break;
+               case 3:
+                  fi = FindFace(*faces_tbl, v);
+                  keep = (fi >= 0 && (other[fi] < 0 || MyRank < other[fi]));
+                  break;
+            }
+         }
+         if (keep) { kept.Append(Pair<int,int>(recv[k], k)); }
+         k += 3 + nv;
+      }
+      SortPairs<int,int>(kept, kept.Size());
+      NumOfBdrElements = kept.Size();
+      boundary.SetSize(NumOfBdrElements);
+      for (int i = 0; i < NumOfBdrElements; i++)
+      {
+         const int *r = &recv[kept[i].two];
+         boundary[i] = NewElement(r[2]);
+         int *v = boundary[i]->GetVertices();
+         for (int j = 0; j < boundary[i]->GetNVertices(); j++)
+         {
+            v[j] = lvert.FindSorted(r[3+j]);
+         }
+         boundary[i]->SetAttribute(r[1]);
+      }
+   }
+   delete faces_tbl;
+
+   // 7. Generate the local topology and the secondary parallel data, as in
+   //    ParMesh(MPI_Comm, std::istream &, bool). The orientation is fixed and
+   //    the elements are marked for refinement here: when Mesh::Finalize()
+   //    does it, it regenerates the topology with FinalizeTopology(), which
+   //    adds bogus boundary elements on ranks without boundary elements.
+   FinalizeTopology(false);
+   ReduceMeshGen(); // determine the global 'meshgen'
+   if (fix_orientation || refine)
+   {
+      CheckElementOrientation(fix_orientation);
+      if (refine) { MarkForRefinement(); } // may change topology!
+      const int meshgen_save = meshgen; // FinalizeTopology() calls SetMeshGen()
+      FinalizeTopology(false);
+      meshgen = meshgen_save;
+   }
+   Finalize(false, false);
+}
+
 ParMesh::ParMesh(ParMesh *orig_mesh, int ref_factor, int ref_type)
    : Mesh(orig_mesh, ref_factor, ref_type),
      MyComm(orig_mesh->GetComm()),
@@ -1295,7 +2037,7 @@ void ParMesh::Finalize(bool refine, bool fix_orientation)
 void ParMesh::DistributeAttributes(Array<int> &attr)
 {
    // Determine the largest attribute number across all processors
-   int max_attr = attr.Max();
+   int max_attr = attr.Size() ? attr.Max() : 0;
    int glb_max_attr = -1;
    MPI_Allreduce(&max_attr, &glb_max_attr, 1, MPI_INT, MPI_MAX, MyComm);
 
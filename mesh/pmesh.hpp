@@ -210,6 +210,23 @@ public:
    /** The @a refine parameter is passed to the method Mesh::Finalize(). */
    ParMesh(MPI_Comm comm, std::istream &input, bool refine = true);
 
+   /** @brief Read in parallel a mesh in the binary MFEM format, see
+       Mesh::PrintBinary(), without constructing the global mesh on any rank.
+
+       Every rank reads a contiguous slice of the elements in the file, which
+       becomes its part of the mesh, and a slice of the vertices, for which it
+       acts as a directory: the coordinates of the vertices, the shared
+       vertices, edges and faces, and the ranks of the boundary elements are
+       determined by exchanging data with the owners of the corresponding
+       vertex slices only. For a good partitioning, the elements in the file
+       should be ordered along a space-filling curve, e.g. with
+       Mesh::GetHilbertElementOrdering() and Mesh::ReorderElements().
+
+       Curved meshes are not supported. The parameters @a refine and
+       @a fix_orientation are passed to the method Mesh::Finalize(). */
+   ParMesh(MPI_Comm comm, const char *filename, bool refine = true,
+           bool fix_orientation = true);
+
    /// Create a uniformly refined (by any factor) version of @a orig_mesh.
    /** @param[in] orig_mesh  The starting coarse mesh.
        @param[in] ref_factor The refinement factor, an integer > 1.
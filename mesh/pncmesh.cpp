@@ -2960,7 +2960,8 @@ int ParNCMesh::PrintMemoryDetail(bool with_base) const
              << map_memory_usage(recv_rebalance_dofs) << " recv_rebalance_dofs\n"
              << old_index_or_rank.MemoryUsage() << " old_index_or_rank\n"
              << aux_pm_store.MemoryUsage() << " aux_pm_store\n"
-             << sizeof(ParNCMesh) - sizeof(NCMesh) << " ParNCMesh" << std::endl;
+             << sizeof(ParNCMesh) - sizeof(NCMesh) << " ParNCMesh\n"
+             << MemoryUsage(with_base) << " ParNCMesh total" << std::endl;
 
    return leaf_elements.Size();
 }
@@ -757,6 +757,8 @@ int main (int argc, char *argv[])
                  "3) METIS_PartGraphRecursive\n"
                  "4) METIS_PartGraphKway\n"
                  "5) METIS_PartGraphVKway\n"
+                 "6) Hilbert space-filling curve\n"
+                 "7) Morton space-filling curve\n"
                  "--> " << flush;
             char pk;
             cin >> pk;
@@ -791,7 +793,7 @@ int main (int argc, char *argv[])
             else
             {
                int part_method = pk - '0';
-               if (part_method < 0 || part_method > 5)
+               if (part_method < 0 || part_method > 7)
                {
                   continue;
                }
@@ -0,0 +1,306 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+// Add the mismatches between the signed dofs 'd0' of the natural space and
+// 'd1' of the renumbered space to 'mismatch', collecting the map in 'ren'.
+static void MatchDofs(const Array<int> &d0, const Array<int> &d1,
+                      Array<int> &ren, int &mismatch)
+{
+   if (d0.Size() != d1.Size()) { mismatch++; return; }
+   for (int i = 0; i < d0.Size(); i++)
+   {
+      if ((d0[i] < 0) != (d1[i] < 0)) { mismatch++; continue; }
+      const int a = (d0[i] >= 0) ? d0[i] : -1-d0[i];
+      const int b = (d1[i] >= 0) ? d1[i] : -1-d1[i];
+      if (ren[a] < 0) { ren[a] = b; }
+      if (ren[a] != b) { mismatch++; }
+   }
+}
+
+// Compare all dof queries of 'fes0' (natural numbering) and 'fes1'
+// (renumbered), returning the renumbering in 'ren'.
+static int CompareSpaces(FiniteElementSpace &fes0, FiniteElementSpace &fes1,
+                         Array<int> &ren)
+{
+   Mesh *mesh = fes0.GetMesh();
+   int mismatch = (fes0.GetNDofs() != fes1.GetNDofs());
+   ren.SetSize(fes0.GetNDofs());
+   ren = -1;
+   Array<int> d0, d1;
+   for (int i = 0; i < mesh->GetNE(); i++)
+   {
+      fes0.GetElementDofs(i, d0);
+      fes1.GetElementDofs(i, d1);
+      MatchDofs(d0, d1, ren, mismatch);
+   }
+   // the renumbering is a permutation
+   Array<int> inv(ren.Size());
+   inv = -1;
+   for (int i = 0; i < ren.Size(); i++)
+   {
+      if (ren[i] < 0 || inv[ren[i]] >= 0) { mismatch++; continue; }
+      inv[ren[i]] = i;
+   }
+   for (int i = 0; i < mesh->GetNBE(); i++)
+   {
+      fes0.GetBdrElementDofs(i, d0);
+      fes1.GetBdrElementDofs(i, d1);
+      MatchDofs(d0, d1, ren, mismatch);
+   }
+   for (int i = 0; i < mesh->GetNumFaces(); i++)
+   {
+      fes0.GetFaceDofs(i, d0);
+      fes1.GetFaceDofs(i, d1);
+      MatchDofs(d0, d1, ren, mismatch);
+   }
+   for (int i = 0; i < mesh->GetNEdges(); i++)
+   {
+      fes0.GetEdgeDofs(i, d0);
+      fes1.GetEdgeDofs(i, d1);
+      MatchDofs(d0, d1, ren, mismatch);
+   }
+   for (int i = 0; i < mesh->GetNV(); i++)
+   {
+      fes0.GetVertexDofs(i, d0);
+      fes1.GetVertexDofs(i, d1);
+      MatchDofs(d0, d1, ren, mismatch);
+   }
+   return mismatch;
+}
+
+static int Bandwidth(const SparseMatrix &A)
+{
+   int bw = 0;
+   for (int i = 0; i < A.Height(); i++)
+   {
+      for (int k = A.GetI()[i]; k < A.GetI()[i+1]; k++)
+      {
+         bw = std::max(bw, std::abs(A.GetJ()[k] - i));
+      }
+   }
+   return bw;
+}
+
+// Check that the element-to-dof table of 'fes' numbers the dofs in the order
+// of their first appearance, keeping the signs of the original table 'el_dof'.
+static int CheckElementOrder(const FiniteElementSpace &fes,
+                             const Table &el_dof)
+{
+   const Table &tbl = fes.GetElementToDofTable();
+   const int nnz = tbl.Size_of_connections();
+   int mismatch = (nnz != el_dof.Size_of_connections());
+   if (mismatch) { return mismatch; }
+   const int *J = tbl.GetJ(), *J0 = el_dof.GetJ();
+   Array<int> ren(fes.GetNDofs());
+   ren = -1;
+   for (int k = 0, next = 0; k < nnz; k++)
+   {
+      if ((J[k] < 0) != (J0[k] < 0)) { mismatch++; }
+      const int a = (J0[k] >= 0) ? J0[k] : -1-J0[k];
+      const int b = (J[k] >= 0) ? J[k] : -1-J[k];
+      if (ren[a] < 0) { ren[a] = next++; }
+      if (ren[a] != b) { mismatch++; }
+   }
+   return mismatch;
+}
+
+TEST_CASE("DOF renumbering", "[FiniteElementSpace]")
+{
+   const DofRenumbering types[] = { DofRenumbering::ELEMENT,
+                                    DofRenumbering::RCM
+                                  };
+
+   SECTION("H1 space, partial and full assembly")
+   {
+      Mesh mesh(8, 8, Element::QUADRILATERAL, 1, 1.0, 1.0);
+      H1_FECollection fec(3, 2);
+      FiniteElementSpace fes0(&mesh, &fec);
+
+      ConstantCoefficient one(1.0);
+      FunctionCoefficient f([](const Vector &x)
+      { return sin(3.0*x(0))*cos(2.0*x(1)); });
+
+      BilinearForm a0(&fes0);
+      a0.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a0.Assemble();
+      a0.Finalize();
+      GridFunction x0(&fes0), y0(&fes0);
+      x0.ProjectCoefficient(f);
+      a0.Mult(x0, y0);
+
+      for (int t = 0; t < 2; t++)
+      {
+         FiniteElementSpace fes1(&mesh, &fec);
+         fes1.RenumberDofs(types[t]);
+         REQUIRE(fes1.GetDofRenumbering() == types[t]);
+         Array<int> ren;
+         REQUIRE(CompareSpaces(fes0, fes1, ren) == 0);
+
+         // full assembly: the same matrix up to the permutation
+         BilinearForm a1(&fes1);
+         a1.AddDomainIntegrator(new DiffusionIntegrator(one));
+         a1.Assemble();
+         a1.Finalize();
+         if (types[t] == DofRenumbering::RCM)
+         {
+            REQUIRE(Bandwidth(a1.SpMat()) < Bandwidth(a0.SpMat()));
+         }
+
+         // partial assembly uses the ElementRestriction
+         BilinearForm pa(&fes1);
+         pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         pa.AddDomainIntegrator(new DiffusionIntegrator(one));
+         pa.Assemble();
+
+         GridFunction x1(&fes1), y1(&fes1), z1(&fes1);
+         x1.ProjectCoefficient(f);
+         a1.Mult(x1, y1);
+         pa.Mult(x1, z1);
+         double err = 0.0;
+         for (int i = 0; i < ren.Size(); i++)
+         {
+            err = std::max(err, fabs(x1(ren[i]) - x0(i)));
+            err = std::max(err, fabs(y1(ren[i]) - y0(i)));
+            err = std::max(err, fabs(z1(ren[i]) - y0(i)));
+         }
+         REQUIRE(err < 1e-12*std::max(1.0, y0.Normlinf()));
+      }
+   }
+
+   SECTION("H(curl) space with refinement")
+   {
+      Mesh mesh(2, 3, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+      ND_FECollection fec(2, 3);
+      FiniteElementSpace fes0(&mesh, &fec);
+      for (int t = 0; t < 2; t++)
+      {
+         FiniteElementSpace fes1(&mesh, &fec);
+         fes1.RenumberDofs(types[t]);
+         Array<int> ren;
+         REQUIRE(CompareSpaces(fes0, fes1, ren) == 0);
+
+         // a copy keeps the numbering
+         FiniteElementSpace fes2(fes1);
+         Array<int> ren2;
+         REQUIRE(CompareSpaces(fes0, fes2, ren2) == 0);
+         REQUIRE(ren == ren2);
+      }
+
+      FiniteElementSpace fes1(&mesh, &fec);
+      fes1.RenumberDofs(DofRenumbering::RCM);
+      GridFunction x(&fes1);
+      VectorFunctionCoefficient f(3, [](const Vector &p, Vector &v)
+      {
+         v(0) = p(1);
+         v(1) = p(2)*p(0);
+         v(2) = -p(0);
+      });
+      x.ProjectCoefficient(f);
+
+      // the numbering is recomputed after the update
+      mesh.UniformRefinement();
+      fes0.Update();
+      fes1.Update();
+      x.Update();
+      REQUIRE(fes1.GetDofRenumbering() == DofRenumbering::RCM);
+      Array<int> ren;
+      REQUIRE(CompareSpaces(fes0, fes1, ren) == 0);
+      REQUIRE(x.ComputeL2Error(f) < 1e-12);
+   }
+
+   SECTION("ReorderElementToDofTable and Save/Load")
+   {
+      Mesh mesh(4, 3, Element::TRIANGLE, 1, 1.0, 1.0);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes0(&mesh, &fec), fes1(&mesh, &fec);
+      fes1.RenumberDofs(DofRenumbering::ELEMENT);
+      Array<int> ren1;
+      REQUIRE(CompareSpaces(fes0, fes1, ren1) == 0);
+
+      // the same numbering, also when combined with RenumberDofs()
+      for (int t = 0; t < 2; t++)
+      {
+         FiniteElementSpace fes2(&mesh, &fec);
+         if (t == 1) { fes2.RenumberDofs(DofRenumbering::RCM); }
+         fes2.ReorderElementToDofTable();
+         REQUIRE(fes2.GetDofRenumbering() == DofRenumbering::ELEMENT);
+         Array<int> ren2;
+         REQUIRE(CompareSpaces(fes0, fes2, ren2) == 0);
+         REQUIRE(ren1 == ren2);
+      }
+
+      // the renumbering is restored by Load()
+      FiniteElementSpace fes3(&mesh, &fec);
+      fes3.RenumberDofs(DofRenumbering::RCM);
+      FunctionCoefficient f([](const Vector &x)
+      { return x(0)*x(0) - x(0)*x(1); });
+      GridFunction x(&fes3);
+      x.ProjectCoefficient(f);
+      std::stringstream buf;
+      buf.precision(16);
+      x.Save(buf);
+      GridFunction y(&mesh, buf);
+      REQUIRE(y.FESpace()->GetDofRenumbering() == DofRenumbering::RCM);
+      Array<int> ren3, ren4;
+      REQUIRE(CompareSpaces(fes0, fes3, ren3) == 0);
+      REQUIRE(CompareSpaces(fes0, *y.FESpace(), ren4) == 0);
+      REQUIRE(ren3 == ren4);
+      REQUIRE(y.ComputeL2Error(f) < 1e-12);
+   }
+
+   SECTION("ReorderElementToDofTable on a nonconforming mesh")
+   {
+      Mesh mesh(3, 3, 3, Element::HEXAHEDRON);
+      mesh.EnsureNCMesh();
+      Array<Refinement> refs;
+      refs.Append(Refinement(0));
+      refs.Append(Refinement(13));
+      mesh.GeneralRefinement(refs);
+      ND_FECollection fec(2, 3);
+      FiniteElementSpace fes(&mesh, &fec);
+      Table el_dof(fes.GetElementToDofTable());
+      fes.ReorderElementToDofTable();
+      // only the table is permuted
+      REQUIRE(fes.GetDofRenumbering() == DofRenumbering::NONE);
+      REQUIRE(CheckElementOrder(fes, el_dof) == 0);
+   }
+}
+
+#ifdef MFEM_USE_MPI
+
+TEST_CASE("Parallel ReorderElementToDofTable", "[Parallel], [ParFiniteElementSpace]")
+{
+   for (int nc = 0; nc < 2; nc++)
+   {
+      Mesh mesh(4, 3, 2, Element::HEXAHEDRON);
+      if (nc) { mesh.EnsureNCMesh(); }
+      ParMesh pmesh(MPI_COMM_WORLD, mesh);
+      if (nc)
+      {
+         Array<Refinement> refs;
+         refs.Append(Refinement(0));
+         pmesh.GeneralRefinement(refs);
+      }
+      H1_FECollection fec(2, 3);
+      ParFiniteElementSpace fes(&pmesh, &fec);
+      Table el_dof(fes.GetElementToDofTable());
+      fes.ReorderElementToDofTable();
+      REQUIRE(fes.GetDofRenumbering() == DofRenumbering::NONE);
+      REQUIRE(CheckElementOrder(fes, el_dof) == 0);
+   }
+}
+
+#endif // MFEM_USE_MPI
@@ -13,6 +13,8 @@
 using namespace mfem;
 
 #include "catch.hpp"
+#include <thread>
+#include <vector>
 
 //You typically want to start by testing things one object at a time.
 TEST_CASE("Integration rule container with no refinement", "[IntegrationRules]")
@@ -199,3 +201,110 @@ TEST_CASE("Simplex integration rules", "[SimplexRules]")
       }
    }
 }
+
+TEST_CASE("Concurrent integration rule generation", "[IntegrationRules]")
+{
+   // Several threads request the same rules, with orders beyond the size of
+   // the lookup table, in different orders; all of them must get the same,
+   // fully constructed, rules.
+   const int nthreads = 8, max_order = 80;
+   const Geometry::Type geoms[] = { Geometry::SEGMENT, Geometry::TRIANGLE,
+                                    Geometry::SQUARE, Geometry::TETRAHEDRON,
+                                    Geometry::CUBE, Geometry::PRISM
+                                  };
+   const int ngeoms = 6;
+   IntegrationRules my_intrules(0, Quadrature1D::GaussLegendre);
+   IntegrationRules ref_intrules(0, Quadrature1D::GaussLegendre);
+   std::vector<const IntegrationRule *> rules(nthreads*ngeoms*(max_order+1));
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nthreads; t++)
+   {
+      threads.push_back(std::thread([&, t]()
+      {
+         for (int k = 0; k <= max_order; k++)
+         {
+            const int order = (t % 2) ? k : max_order - k;
+            for (int g = 0; g < ngeoms; g++)
+            {
+               const IntegrationRule &ir = my_intrules.Get(geoms[g], order);
+               ir.GetWeights();
+               rules[(t*ngeoms + g)*(max_order+1) + order] = &ir;
+            }
+         }
+      }));
+   }
+   for (int t = 0; t < nthreads; t++) { threads[t].join(); }
+
+   for (int g = 0; g < ngeoms; g++)
+   {
+      for (int order = 0; order <= max_order; order++)
+      {
+         const IntegrationRule *ir = rules[g*(max_order+1) + order];
+         for (int t = 1; t < nthreads; t++)
+         {
+            REQUIRE(rules[(t*ngeoms + g)*(max_order+1) + order] == ir);
+         }
+         // compare with the rule generated serially
+         const IntegrationRule &ir_ref = ref_intrules.Get(geoms[g], order);
+         REQUIRE(ir->GetOrder() == ir_ref.GetOrder());
+         REQUIRE(ir->GetNPoints() == ir_ref.GetNPoints());
+         REQUIRE(ir->GetWeights().Size() == ir->GetNPoints());
+         const int dim = Geometry::Dimension[geoms[g]];
+         int mismatch = 0;
+         for (int i = 0; i < ir->GetNPoints(); i++)
+         {
+            const IntegrationPoint &ip = ir->IntPoint(i);
+            const IntegrationPoint &ip_ref = ir_ref.IntPoint(i);
+            if (ip.x != ip_ref.x || ip.weight != ip_ref.weight ||
+                (dim > 1 && ip.y != ip_ref.y) ||
+                (dim > 2 && ip.z != ip_ref.z)) { mismatch++; }
+         }
+         REQUIRE(mismatch == 0);
+      }
+   }
+}
+
+TEST_CASE("Concurrent DofToQuad generation", "[IntegrationRules][DofToQuad]")
+{
+   const int nthreads = 8, nrules = 6;
+   H1_HexahedronElement el(3);
+   L2_TriangleElement tri(2);
+   const IntegrationRule *irs[nrules], *irt[nrules];
+   for (int i = 0; i < nrules; i++)
+   {
+      irs[i] = &IntRules.Get(Geometry::CUBE, 2*i + 1);
+      irt[i] = &IntRules.Get(Geometry::TRIANGLE, 2*i + 1);
+   }
+   std::vector<const DofToQuad *> maps(nthreads*nrules*3);
+   std::vector<std::thread> threads;
+   for (int t = 0; t < nthreads; t++)
+   {
+      threads.push_back(std::thread([&, t]()
+      {
+         for (int k = 0; k < nrules; k++)
+         {
+            const int i = (t % 2) ? k : nrules - 1 - k;
+            const int o = 3*(t*nrules + i);
+            maps[o] = &el.GetDofToQuad(*irs[i], DofToQuad::TENSOR);
+            maps[o+1] = &el.GetDofToQuad(*irs[i], DofToQuad::FULL);
+            maps[o+2] = &tri.GetDofToQuad(*irt[i], DofToQuad::FULL);
+         }
+      }));
+   }
+   for (int t = 0; t < nthreads; t++) { threads[t].join(); }
+
+   for (int i = 0; i < 3*nrules; i++)
+   {
+      for (int t = 1; t < nthreads; t++)
+      {
+         REQUIRE(maps[3*t*nrules + i] == maps[i]);
+      }
+   }
+   for (int i = 0; i < nrules; i++)
+   {
+      REQUIRE(maps[3*i]->IntRule == irs[i]);
+      REQUIRE(maps[3*i]->mode == DofToQuad::TENSOR);
+      REQUIRE(maps[3*i+1]->nqpt == irs[i]->GetNPoints());
+      REQUIRE(maps[3*i+2]->ndof == tri.GetDof());
+   }
+}
@@ -353,6 +353,105 @@ TEST_CASE("PA Vector Diffusion", "[PartialAssembly], [VectorPA]")
    }
 }
 
+TEST_CASE("PA Element Subsets", "[PartialAssembly]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 3, Element::QUADRILATERAL, true) :
+                   new Mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      const int ne = mesh->GetNE();
+      for (int order = 1; order <= 3; order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+
+         BilinearForm pa(&fes);
+         pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         pa.AddDomainIntegrator(new DiffusionIntegrator);
+         pa.AddDomainIntegrator(new MassIntegrator);
+         pa.Assemble();
+
+         PABilinearFormExtension pa_ext(&pa);
+         REQUIRE(pa_ext.SupportsElements());
+         const ElementRestriction *R = pa_ext.GetElementRestriction();
+
+         Vector x(fes.GetVSize()), y(fes.GetVSize()), y_sub(fes.GetVSize());
+         x.Randomize(1);
+         pa.Mult(x, y);
+
+         // Restrict a vector with zero values on the first half of the dofs,
+         // then update the entries of these dofs
+         Array<int> dofs;
+         const int nd = x.Size()/2;
+         for (int i = 0; i < nd; i++) { dofs.Append(i); }
+         Vector x0(x), xe(R->Height()), xe_ref(R->Height());
+         for (int i = 0; i < nd; i++) { x0(i) = 0.0; }
+         R->Mult(x0, xe);
+         R->MultDofs(x, xe, dofs);
+         R->Mult(x, xe_ref);
+         xe_ref -= xe;
+         REQUIRE(xe_ref.Normlinf() == 0.0);
+
+         // Apply the odd and the even elements separately
+         Array<int> odd, even;
+         for (int e = 0; e < ne; e++) { (e % 2 ? odd : even).Append(e); }
+         Vector ye(R->Height());
+         ye = 0.0;
+         pa_ext.AddMultElements(xe, ye, odd);
+         pa_ext.AddMultElements(xe, ye, even);
+         R->MultTranspose(ye, y_sub);
+         y_sub -= y;
+         REQUIRE(y_sub.Normlinf() == Approx(0.0));
+      }
+      delete mesh;
+   }
+}
+
+TEST_CASE("PA ArrayMult", "[PartialAssembly]")
+{
+   const int nv = 6;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(3, 3, Element::QUADRILATERAL, true) :
+                   new Mesh(2, 2, 2, Element::HEXAHEDRON, true);
+      for (int order = 1; order <= 4; order++)
+      {
+         H1_FECollection fec(order, dim);
+         FiniteElementSpace fes(mesh, &fec);
+
+         BilinearForm pa(&fes);
+         pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         pa.AddDomainIntegrator(new DiffusionIntegrator);
+         pa.AddDomainIntegrator(new MassIntegrator);
+         pa.Assemble();
+
+         // Compare the batched application with one Mult() per vector
+         std::vector<Vector> x(nv), y(nv);
+         Array<const Vector *> xp(nv);
+         Array<Vector *> yp(nv);
+         for (int v = 0; v < nv; v++)
+         {
+            x[v].SetSize(fes.GetVSize());
+            x[v].Randomize(v+1);
+            y[v].SetSize(fes.GetVSize());
+            xp[v] = &x[v];
+            yp[v] = &y[v];
+         }
+         pa.ArrayMult(xp, yp);
+         for (int v = 0; v < nv; v++)
+         {
+            Vector y_ref(fes.GetVSize());
+            pa.Mult(x[v], y_ref);
+            y_ref -= y[v];
+            REQUIRE(y_ref.Normlinf() == Approx(0.0));
+         }
+      }
+      delete mesh;
+   }
+}
+
 //test convection
 int dimension;
 
@@ -446,4 +545,67 @@ TEST_CASE("PA Convection")
 
 }//test case
 
+static int coeff_evals = 0;
+
+double counted_coeff(const Vector &x)
+{
+   coeff_evals++;
+   return 1.0 + x(0)*x(0) + x(1);
+}
+
+static void TestIncrementalUpdate(Mesh &mesh)
+{
+   mesh.EnsureNCMesh();
+   H1_FECollection fec(2, mesh.Dimension());
+   FiniteElementSpace fes(&mesh, &fec);
+   FunctionCoefficient q(counted_coeff);
+
+   BilinearForm pa(&fes);
+   pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+   pa.EnableIncrementalPA();
+   pa.AddDomainIntegrator(new DiffusionIntegrator(q));
+   pa.AddDomainIntegrator(new MassIntegrator(q));
+   pa.Assemble();
+
+   for (int it = 0; it < 3; it++)
+   {
+      Array<int> refs;
+      for (int e = it; e < mesh.GetNE(); e += 5) { refs.Append(e); }
+      const int old_ne = mesh.GetNE();
+      mesh.GeneralRefinement(refs);
+      fes.Update();
+      pa.Update();
+
+      // only the new elements are computed
+      coeff_evals = 0;
+      pa.Assemble();
+      const int new_elems = mesh.GetNE() - (old_ne - refs.Size());
+      const int evals = coeff_evals;
+
+      BilinearForm pa_ref(&fes);
+      pa_ref.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      pa_ref.AddDomainIntegrator(new DiffusionIntegrator(q));
+      pa_ref.AddDomainIntegrator(new MassIntegrator(q));
+      coeff_evals = 0;
+      pa_ref.Assemble();
+      REQUIRE(evals * mesh.GetNE() == coeff_evals * new_elems);
+
+      Vector x(fes.GetVSize()), y(fes.GetVSize()), y_ref(fes.GetVSize());
+      x.Randomize(it);
+      pa.Mult(x, y);
+      pa_ref.Mult(x, y_ref);
+      y -= y_ref;
+      REQUIRE(y.Normlinf() < 1e-12 * y_ref.Normlinf());
+   }
+}
+
+TEST_CASE("PA Incremental Update", "[PartialAssembly]")
+{
+   Mesh mesh2d(4, 4, Element::QUADRILATERAL, true);
+   TestIncrementalUpdate(mesh2d);
+
+   Mesh mesh3d(2, 2, 2, Element::HEXAHEDRON, true);
+   TestIncrementalUpdate(mesh3d);
+}
+
 }// namespace pa_kernels
@@ -0,0 +1,97 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+static int SolveWithAMG(FiniteElementSpace &fes, BilinearForm &a,
+                        SmoothedAggregationAMG &amg)
+{
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(fes.GetMesh()->bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   a.Assemble();
+   GridFunction x(&fes), b(&fes);
+   x = 0.0;
+   b.Randomize(1);
+   SparseMatrix A;
+   Vector X, B;
+   a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+   amg.SetOperator(A);
+   REQUIRE(amg.GetNumLevels() > 1);
+   REQUIRE(amg.GetOperatorComplexity() < 3.0);
+
+   CGSolver cg;
+   cg.SetRelTol(1e-8);
+   cg.SetMaxIter(200);
+   cg.SetPrintLevel(0);
+   cg.SetOperator(A);
+   cg.SetPreconditioner(amg);
+   cg.Mult(B, X);
+   REQUIRE(cg.GetConverged());
+   return cg.GetNumIterations();
+}
+
+TEST_CASE("SmoothedAggregationAMG", "[SmoothedAggregationAMG]")
+{
+   ConstantCoefficient one(1.0);
+
+   SECTION("Scalar diffusion")
+   {
+      int its[2];
+      for (int r = 0; r < 2; r++)
+      {
+         const int ne = 16 << r;
+         Mesh mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+         H1_FECollection fec(1, 2);
+         FiniteElementSpace fes(&mesh, &fec);
+         BilinearForm a(&fes);
+         a.AddDomainIntegrator(new DiffusionIntegrator(one));
+
+         SmoothedAggregationAMG amg;
+         amg.SetMaxCoarseSize(20);
+         its[r] = SolveWithAMG(fes, a, amg);
+      }
+      REQUIRE(its[1] < 30);
+      REQUIRE(its[1] <= its[0] + 5);
+   }
+
+   SECTION("Jacobi smoother")
+   {
+      Mesh mesh(24, 24, Element::QUADRILATERAL, 1, 1.0, 1.0);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+
+      SmoothedAggregationAMG amg;
+      amg.SetSmoother(SmoothedAggregationAMG::SmootherType::JACOBI, 2);
+      REQUIRE(SolveWithAMG(fes, a, amg) < 30);
+   }
+
+   SECTION("Vector problem")
+   {
+      Mesh mesh(16, 16, Element::QUADRILATERAL, 1, 1.0, 1.0);
+      H1_FECollection fec(1, 2);
+      FiniteElementSpace fes(&mesh, &fec, 2, Ordering::byNODES);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new ElasticityIntegrator(one, one));
+
+      SmoothedAggregationAMG amg;
+      amg.SetSystemsOptions(2, true);
+      REQUIRE(SolveWithAMG(fes, a, amg) < 40);
+   }
+}
@@ -0,0 +1,186 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+static double ColumnError(DenseMatrix &X, int j, const Vector &x)
+{
+   Vector xj;
+   X.GetColumnReference(j, xj);
+   Vector diff(xj);
+   diff -= x;
+   return diff.Normlinf() / x.Normlinf();
+}
+
+TEST_CASE("Block Krylov solvers", "[BlockCGSolver][BlockGMRESSolver]")
+{
+   const int ne = 12, k = 4;
+   Mesh mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix A(a.SpMat());
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      A.EliminateRowCol(ess_tdof_list[i]);
+   }
+   const int n = A.Height();
+
+   // k right-hand sides, the last one is a copy of the first one
+   DenseMatrix B(n, k);
+   for (int j = 0; j < k; j++)
+   {
+      Vector bj;
+      B.GetColumnReference(j, bj);
+      bj.Randomize(j == k-1 ? 1 : j+1);
+      for (int i = 0; i < ess_tdof_list.Size(); i++)
+      {
+         bj(ess_tdof_list[i]) = 0.0;
+      }
+   }
+
+   SECTION("SparseMatrix ArrayMult")
+   {
+      DenseMatrix Y(n, k);
+      Array<const Vector *> xp(k);
+      Array<Vector *> yp(k);
+      std::vector<Vector> xv(k), yv(k);
+      for (int j = 0; j < k; j++)
+      {
+         B.GetColumnReference(j, xv[j]);
+         Y.GetColumnReference(j, yv[j]);
+         xp[j] = &xv[j];
+         yp[j] = &yv[j];
+      }
+      A.ArrayMult(xp, yp);
+      for (int j = 0; j < k; j++)
+      {
+         Vector y(n);
+         A.Mult(xv[j], y);
+         REQUIRE(ColumnError(Y, j, y) < 1e-14);
+      }
+   }
+
+   SECTION("Partial assembly ArrayMult")
+   {
+      BilinearForm pa(&fes);
+      pa.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      pa.AddDomainIntegrator(new DiffusionIntegrator(one));
+      pa.AddDomainIntegrator(new MassIntegrator(one));
+      pa.Assemble();
+      DenseMatrix Y(n, k);
+      Array<const Vector *> xp(k);
+      Array<Vector *> yp(k);
+      std::vector<Vector> xv(k), yv(k);
+      for (int j = 0; j < k; j++)
+      {
+         B.GetColumnReference(j, xv[j]);
+         Y.GetColumnReference(j, yv[j]);
+         xp[j] = &xv[j];
+         yp[j] = &yv[j];
+      }
+      pa.ArrayMult(xp, yp);
+      for (int j = 0; j < k; j++)
+      {
+         Vector y(n);
+         a.Mult(xv[j], y);
+         REQUIRE(ColumnError(Y, j, y) < 1e-12);
+      }
+   }
+
+   SECTION("BlockCGSolver")
+   {
+      DSmoother M(A);
+      BlockCGSolver bcg;
+      bcg.SetRelTol(1e-10);
+      bcg.SetMaxIter(500);
+      bcg.SetPrintLevel(-1);
+      bcg.SetOperator(A);
+      bcg.SetPreconditioner(M);
+      DenseMatrix X(n, k);
+      X = 0.0;
+      bcg.Mult(B, X);
+      REQUIRE(bcg.GetConverged());
+
+      CGSolver cg;
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(500);
+      cg.SetPrintLevel(-1);
+      cg.SetOperator(A);
+      cg.SetPreconditioner(M);
+      int max_its = 0;
+      for (int j = 0; j < k; j++)
+      {
+         Vector bj, x(n);
+         B.GetColumnReference(j, bj);
+         x = 0.0;
+         cg.Mult(bj, x);
+         max_its = std::max(max_its, cg.GetNumIterations());
+         REQUIRE(ColumnError(X, j, x) < 1e-6);
+      }
+      // the block method needs fewer iterations than the individual solves
+      REQUIRE(bcg.GetNumIterations() < max_its);
+   }
+
+   SECTION("BlockGMRESSolver")
+   {
+      BlockGMRESSolver bgmres;
+      bgmres.SetRelTol(1e-10);
+      bgmres.SetMaxIter(500);
+      bgmres.SetKDim(20);
+      bgmres.SetPrintLevel(-1);
+      bgmres.SetOperator(A);
+      DenseMatrix X(n, k);
+      X = 0.0;
+      bgmres.Mult(B, X);
+      REQUIRE(bgmres.GetConverged());
+
+      SparseLDLSolver ldl(A);
+      for (int j = 0; j < k; j++)
+      {
+         Vector bj, x(n);
+         B.GetColumnReference(j, bj);
+         ldl.Mult(bj, x);
+         REQUIRE(ColumnError(X, j, x) < 1e-6);
+      }
+
+      // a single right-hand side through the Vector interface
+      GMRESSolver gmres;
+      gmres.SetRelTol(1e-10);
+      gmres.SetMaxIter(500);
+      gmres.SetKDim(20);
+      gmres.SetPrintLevel(-1);
+      gmres.SetOperator(A);
+      Vector b0, x0(n), x1(n);
+      B.GetColumnReference(0, b0);
+      x0 = 0.0;
+      x1 = 0.0;
+      gmres.Mult(b0, x0);
+      bgmres.Mult(b0, x1);
+      REQUIRE(bgmres.GetNumIterations() == gmres.GetNumIterations());
+      x1 -= x0;
+      REQUIRE(x1.Normlinf() < 1e-6*x0.Normlinf());
+   }
+}
@@ -0,0 +1,147 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+// Total number of reductions (inner products) over all iterations.
+static int TotalDotCalls(const IterativeSolver &solver)
+{
+   const Array<IterationStats> &stats = solver.GetIterationStats();
+   int dots = 0;
+   for (int i = 1; i < stats.Size(); i++) { dots += stats[i].dot_calls; }
+   return dots;
+}
+
+TEST_CASE("GMRES orthogonalization", "[GMRESSolver][FGMRESSolver]")
+{
+   // convection-diffusion: a nonsymmetric system
+   const int ne = 16;
+   Mesh mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(mesh.bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+   ConstantCoefficient one(1.0);
+   Vector vel(2);
+   vel(0) = 20.0;
+   vel(1) = 10.0;
+   VectorConstantCoefficient velocity(vel);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new ConvectionIntegrator(velocity));
+   a.Assemble();
+   a.Finalize();
+   SparseMatrix A(a.SpMat());
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      A.EliminateRowCol(ess_tdof_list[i]);
+   }
+   const int n = A.Height();
+
+   Vector b(n), x_ex(n);
+   x_ex.Randomize(1);
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      x_ex(ess_tdof_list[i]) = 0.0;
+   }
+   A.Mult(x_ex, b);
+
+   DSmoother jacobi(A);
+
+   for (int p = 0; p < 2; p++)
+   {
+      GMRESSolver mgs;
+      mgs.SetRelTol(1e-10);
+      mgs.SetMaxIter(1000);
+      mgs.SetKDim(20);
+      mgs.SetPrintLevel(-1);
+      mgs.SetOperator(A);
+      if (p) { mgs.SetPreconditioner(jacobi); }
+      Vector x(n);
+      x = 0.0;
+      mgs.Mult(b, x);
+      REQUIRE(mgs.GetConverged());
+      x -= x_ex;
+      REQUIRE(x.Normlinf() < 1e-6*x_ex.Normlinf());
+      const int its = mgs.GetNumIterations();
+
+      // Orthogonalization variants
+      const int types[] = { GMRESSolver::CGS, GMRESSolver::CGS2 };
+      for (int t = 0; t < 2; t++)
+      {
+         GMRESSolver gmres;
+         gmres.SetRelTol(1e-10);
+         gmres.SetMaxIter(1000);
+         gmres.SetKDim(20);
+         gmres.SetPrintLevel(-1);
+         gmres.SetOrthogonalization(types[t]);
+         gmres.SetProfiling();
+         gmres.SetOperator(A);
+         if (p) { gmres.SetPreconditioner(jacobi); }
+         x = 0.0;
+         gmres.Mult(b, x);
+         REQUIRE(gmres.GetConverged());
+         REQUIRE(abs(gmres.GetNumIterations() - its) <= 2);
+         // one (CGS) or two (CGS2) reductions per iteration, plus one per
+         // restart
+         REQUIRE(TotalDotCalls(gmres) <= (t+1)*gmres.GetNumIterations() +
+                 gmres.GetNumIterations()/20 + 1);
+         x -= x_ex;
+         REQUIRE(x.Normlinf() < 1e-6*x_ex.Normlinf());
+      }
+
+      FGMRESSolver fgmres;
+      fgmres.SetRelTol(1e-10);
+      fgmres.SetMaxIter(1000);
+      fgmres.SetKDim(20);
+      fgmres.SetPrintLevel(-1);
+      fgmres.SetOrthogonalization(GMRESSolver::CGS2);
+      fgmres.SetOperator(A);
+      if (p) { fgmres.SetPreconditioner(jacobi); }
+      x = 0.0;
+      fgmres.Mult(b, x);
+      REQUIRE(fgmres.GetConverged());
+      x -= x_ex;
+      REQUIRE(x.Normlinf() < 1e-6*x_ex.Normlinf());
+
+      // s-step
+      for (int s = 2; s <= 4; s += 2)
+      {
+         GMRESSolver gmres;
+         gmres.SetRelTol(1e-10);
+         gmres.SetMaxIter(1000);
+         gmres.SetKDim(20);
+         gmres.SetPrintLevel(-1);
+         gmres.SetSStep(s);
+         gmres.SetProfiling();
+         gmres.SetOperator(A);
+         if (p) { gmres.SetPreconditioner(jacobi); }
+         x = 0.0;
+         gmres.Mult(b, x);
+         REQUIRE(gmres.GetConverged());
+         // convergence is checked for every column of a block, so the
+         // iteration counts agree up to rounding
+         REQUIRE(abs(gmres.GetNumIterations() - its) <= 2);
+         // three reductions per block of s iterations, plus one per restart
+         const int gits = gmres.GetNumIterations();
+         REQUIRE(TotalDotCalls(gmres) <= 3*((gits+s-1)/s) + gits/20 + 1);
+         x -= x_ex;
+         REQUIRE(x.Normlinf() < 1e-6*x_ex.Normlinf());
+      }
+   }
+}
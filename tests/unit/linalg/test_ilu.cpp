@@ -169,3 +169,43 @@ TEST_CASE("ILU Factorization", "[ILU]")
    REQUIRE(AB(0,1,6) == Approx(-13.0/9.0));
    REQUIRE(AB(1,1,6) == Approx(-2.0));
 }
+
+TEST_CASE("ILU Solve", "[ILU]")
+{
+   // Block tridiagonal matrix: the block ILU(0) factorization is exact, so
+   // applying the preconditioner must solve the linear system.
+   int N = 20;
+   int Nb = 2;
+   SparseMatrix A(N * Nb, N * Nb);
+   DenseMatrix Ab(Nb, Nb);
+   int counter = 0;
+   for (int i = 0; i < N; ++i)
+   {
+      for (int j = std::max(i - 1, 0); j <= std::min(i + 1, N - 1); ++j)
+      {
+         Array<int> rows, cols;
+         for (int ii = 0; ii < Nb; ++ii)
+         {
+            rows.Append(i * Nb + ii);
+            cols.Append(j * Nb + ii);
+         }
+         Vector Ab_data(Ab.GetData(), Nb * Nb);
+         Ab_data.Randomize(++counter);
+         if (i == j)
+         {
+            for (int ii = 0; ii < Nb; ++ii) { Ab(ii, ii) += 4.0; }
+         }
+         A.SetSubMatrix(rows, cols, Ab);
+      }
+   }
+   A.Finalize();
+
+   Vector b(N * Nb), x(N * Nb), r(N * Nb);
+   b.Randomize(1);
+
+   BlockILU ilu(A, Nb, BlockILU::Reordering::NONE);
+   ilu.Mult(b, x);
+   A.Mult(x, r);
+   r -= b;
+   REQUIRE(r.Normlinf() < 1e-10);
+}
@@ -0,0 +1,132 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+// Residual norm of the eigenpair (lambda, x) of A x = lambda M x.
+static double EigenResidual(const Operator &A, const Operator *M,
+                            double lambda, const Vector &x)
+{
+   Vector r(x.Size()), mx(x.Size());
+   A.Mult(x, r);
+   if (M) { M->Mult(x, mx); }
+   else { mx = x; }
+   r.Add(-lambda, mx);
+   return r.Norml2();
+}
+
+TEST_CASE("LOBPCGSolver", "[LOBPCGSolver]")
+{
+   SECTION("Finite difference Laplacian")
+   {
+      // eigenvalues 2 - 2 cos(k pi/(n+1)), k = 1, ..., n
+      const int n = 100, nev = 4;
+      SparseMatrix A(n);
+      for (int i = 0; i < n; i++)
+      {
+         A.Add(i, i, 2.0);
+         if (i > 0) { A.Add(i, i-1, -1.0); }
+         if (i < n-1) { A.Add(i, i+1, -1.0); }
+      }
+      A.Finalize();
+
+      SparseLDLSolver ldl(A);
+      for (int precond = 0; precond < 2; precond++)
+      {
+         LOBPCGSolver lobpcg;
+         lobpcg.SetNumModes(nev);
+         lobpcg.SetBlockSize(nev + 2);
+         lobpcg.SetRelTol(1e-9);
+         lobpcg.SetMaxIter(1000);
+         lobpcg.SetPrintLevel(-1);
+         if (precond) { lobpcg.SetPreconditioner(ldl); }
+         lobpcg.SetOperator(A);
+         lobpcg.Solve();
+         REQUIRE(lobpcg.GetConverged());
+         if (precond) { REQUIRE(lobpcg.GetNumIterations() < 10); }
+
+         Array<double> eigs;
+         lobpcg.GetEigenvalues(eigs);
+         REQUIRE(eigs.Size() == nev);
+         Vector x;
+         for (int k = 0; k < nev; k++)
+         {
+            const double exact = 2.0 - 2.0*cos((k+1)*M_PI/(n+1));
+            REQUIRE(fabs(eigs[k] - exact) < 1e-10*exact);
+            lobpcg.GetEigenvector(k, x);
+            REQUIRE(fabs(x.Norml2() - 1.0) < 1e-10);
+            REQUIRE(EigenResidual(A, NULL, eigs[k], x) < 1e-8*eigs[k]);
+         }
+      }
+   }
+
+   SECTION("Partial assembly")
+   {
+      // Neumann Laplacian on the unit square: eigenvalues 0, pi^2, pi^2,
+      // 2 pi^2, 4 pi^2, ...
+      const int ne = 8, nev = 4;
+      Mesh mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+      H1_FECollection fec(2, 2);
+      FiniteElementSpace fes(&mesh, &fec);
+
+      Array<double> eigs[2];
+      for (int pa = 0; pa < 2; pa++)
+      {
+         BilinearForm a(&fes), m(&fes);
+         if (pa)
+         {
+            a.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+            m.SetAssemblyLevel(AssemblyLevel::PARTIAL);
+         }
+         a.AddDomainIntegrator(new DiffusionIntegrator);
+         m.AddDomainIntegrator(new MassIntegrator);
+         a.Assemble();
+         m.Assemble();
+         if (!pa)
+         {
+            a.Finalize();
+            m.Finalize();
+         }
+
+         LOBPCGSolver lobpcg;
+         lobpcg.SetNumModes(nev);
+         lobpcg.SetRelTol(1e-8);
+         lobpcg.SetAbsTol(1e-8);
+         lobpcg.SetMaxIter(1000);
+         lobpcg.SetPrintLevel(-1);
+         lobpcg.SetOperator(a);
+         lobpcg.SetMassMatrix(m);
+         lobpcg.Solve();
+         REQUIRE(lobpcg.GetConverged());
+         lobpcg.GetEigenvalues(eigs[pa]);
+
+         Vector x;
+         for (int k = 0; k < nev; k++)
+         {
+            lobpcg.GetEigenvector(k, x);
+            REQUIRE(EigenResidual(a, &m, eigs[pa][k], x) <
+                    1e-8*std::max(eigs[pa][k], 1.0));
+         }
+      }
+
+      const double pi2 = M_PI*M_PI;
+      const double exact[nev] = { 0.0, pi2, pi2, 2*pi2 };
+      for (int k = 0; k < nev; k++)
+      {
+         const double scale = std::max(exact[k], 1.0);
+         REQUIRE(fabs(eigs[1][k] - eigs[0][k]) < 1e-8*scale);
+         REQUIRE(fabs(eigs[0][k] - exact[k]) < 1e-3*scale);
+      }
+   }
+}
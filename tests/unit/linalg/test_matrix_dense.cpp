@@ -245,3 +245,53 @@ TEST_CASE("LUFactors RightSolve", "[DenseMatrix]")
 
    REQUIRE(C.MaxMaxNorm() < tol);
 }
+
+TEST_CASE("DenseMatrix Eigensystem", "[DenseMatrix]")
+{
+   double tol = 1e-12;
+
+   double AData[16] = { 4.0, 1.0, 0.0, 2.0,
+                        1.0, 3.0, 1.0, 0.0,
+                        0.0, 1.0, 2.0, 1.0,
+                        2.0, 0.0, 1.0, 5.0
+                      };
+   double BData[16] = { 2.0, 1.0, 0.0, 0.0,
+                        1.0, 2.0, 1.0, 0.0,
+                        0.0, 1.0, 2.0, 1.0,
+                        0.0, 0.0, 1.0, 2.0
+                      };
+   DenseMatrix A(AData, 4, 4), B(BData, 4, 4);
+
+   SECTION("Standard")
+   {
+      DenseMatrix Acopy(A), V;
+      Vector ev;
+      Acopy.Eigensystem(ev, V);
+      for (int j = 0; j < 4; j++)
+      {
+         Vector v, Av(4);
+         V.GetColumnReference(j, v);
+         A.Mult(v, Av);
+         Av.Add(-ev(j), v);
+         REQUIRE(Av.Normlinf() < tol);
+         if (j > 0) { REQUIRE(ev(j-1) <= ev(j)); }
+      }
+   }
+
+   SECTION("Generalized")
+   {
+      DenseMatrix Acopy(A), Bcopy(B), V;
+      Vector ev;
+      Acopy.Eigensystem(Bcopy, ev, V);
+      for (int j = 0; j < 4; j++)
+      {
+         Vector v, Av(4), Bv(4);
+         V.GetColumnReference(j, v);
+         A.Mult(v, Av);
+         B.Mult(v, Bv);
+         Av.Add(-ev(j), Bv);
+         REQUIRE(Av.Normlinf() < tol);
+         if (j > 0) { REQUIRE(ev(j-1) <= ev(j)); }
+      }
+   }
+}
@@ -0,0 +1,158 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+// F(x) = A x + x^3, where A is the 1D finite difference Laplacian.
+class CubicOperator : public Operator
+{
+protected:
+   SparseMatrix A;
+   mutable SparseMatrix *J;
+
+public:
+   mutable int num_grad;
+
+   CubicOperator(int n) : Operator(n), A(n), J(NULL), num_grad(0)
+   {
+      const double h2 = 1.0/((n+1)*(n+1));
+      for (int i = 0; i < n; i++)
+      {
+         A.Add(i, i, 2.0/h2);
+         if (i > 0) { A.Add(i, i-1, -1.0/h2); }
+         if (i < n-1) { A.Add(i, i+1, -1.0/h2); }
+      }
+      A.Finalize();
+   }
+
+   virtual void Mult(const Vector &x, Vector &y) const
+   {
+      A.Mult(x, y);
+      for (int i = 0; i < height; i++) { y(i) += x(i)*x(i)*x(i); }
+   }
+
+   virtual Operator &GetGradient(const Vector &x) const
+   {
+      delete J;
+      J = new SparseMatrix(A);
+      for (int i = 0; i < height; i++) { J->Elem(i, i) += 3.0*x(i)*x(i); }
+      num_grad++;
+      return *J;
+   }
+
+   virtual ~CubicOperator() { delete J; }
+};
+
+// GMRES that accumulates the number of iterations of all solves.
+class CountingGMRES : public GMRESSolver
+{
+public:
+   mutable int total_its;
+   CountingGMRES() : total_its(0) { }
+
+   virtual void Mult(const Vector &b, Vector &x) const
+   {
+      GMRESSolver::Mult(b, x);
+      total_its += GetNumIterations();
+   }
+};
+
+TEST_CASE("NewtonSolver", "[NewtonSolver]")
+{
+   const int n = 100;
+   CubicOperator F(n);
+   Vector b(n), x_ref(n), x(n), r(n);
+   b = 1e3;
+
+   // Reference: Newton with an exact linear solver
+   SparseLDLSolver ldl;
+   NewtonSolver newton;
+   newton.SetSolver(ldl);
+   newton.SetOperator(F);
+   newton.SetRelTol(1e-12);
+   newton.SetMaxIter(20);
+   newton.SetPrintLevel(-1);
+   x_ref = 0.0;
+   newton.Mult(b, x_ref);
+   REQUIRE(newton.GetConverged());
+   const int its_ref = newton.GetNumIterations();
+
+   SECTION("Eisenstat-Walker")
+   {
+      for (int type = 0; type <= 2; type++)
+      {
+         CountingGMRES gmres;
+         GSSmoother gs;
+         gmres.SetPreconditioner(gs);
+         gmres.SetRelTol(1e-12);
+         gmres.SetKDim(100);
+         gmres.SetMaxIter(1000);
+         gmres.SetPrintLevel(-1);
+
+         NewtonSolver ew_newton;
+         ew_newton.SetSolver(gmres);
+         ew_newton.SetOperator(F);
+         ew_newton.SetRelTol(1e-10);
+         ew_newton.SetMaxIter(50);
+         ew_newton.SetPrintLevel(-1);
+         if (type > 0) { ew_newton.SetAdaptiveLinRtol(type, 0.1); }
+         x = 0.0;
+         ew_newton.Mult(b, x);
+         REQUIRE(ew_newton.GetConverged());
+         x -= x_ref;
+         REQUIRE(x.Normlinf() < 1e-8*x_ref.Normlinf());
+
+         static int its_fixed;
+         if (type == 0) { its_fixed = gmres.total_its; }
+         else { REQUIRE(gmres.total_its < its_fixed); }
+      }
+   }
+
+   SECTION("Jacobian-free Newton-Krylov")
+   {
+      for (int lag = 1; lag <= 3; lag += 2)
+      {
+         CountingGMRES gmres;
+         gmres.SetRelTol(1e-10);
+         gmres.SetKDim(100);
+         gmres.SetMaxIter(1000);
+         gmres.SetPrintLevel(-1);
+
+         SparseLDLSolver pc;
+         NewtonSolver jfnk;
+         jfnk.SetSolver(gmres);
+         jfnk.SetJacobianFree(true, &pc);
+         jfnk.SetJacobianLag(lag);
+         jfnk.SetAdaptiveLinRtol(2);
+         jfnk.SetOperator(F);
+         jfnk.SetRelTol(1e-10);
+         jfnk.SetMaxIter(50);
+         jfnk.SetPrintLevel(-1);
+
+         F.num_grad = 0;
+         x = 0.0;
+         jfnk.Mult(b, x);
+         REQUIRE(jfnk.GetConverged());
+         const int its = jfnk.GetNumIterations();
+         REQUIRE(F.num_grad == (its + lag - 1)/lag);
+         REQUIRE(its <= 3*its_ref);
+
+         F.Mult(x, r);
+         r -= b;
+         REQUIRE(r.Norml2() < 1e-10*b.Norml2());
+         x -= x_ref;
+         REQUIRE(x.Normlinf() < 1e-6*x_ref.Normlinf());
+      }
+   }
+}
@@ -181,6 +181,24 @@ TEST_CASE("First order ODE methods",
       REQUIRE(check.order(new RK4Solver) + tol > 4.0 );
    }
 
+   SECTION("LSRK33Solver")
+   {
+      std::cout <<"\nTesting LSRK33Solver" << std::endl;
+      REQUIRE(check.order(new LSRK33Solver) + tol > 3.0 );
+   }
+
+   SECTION("LSRK54Solver")
+   {
+      std::cout <<"\nTesting LSRK54Solver" << std::endl;
+      REQUIRE(check.order(new LSRK54Solver) + tol > 4.0 );
+   }
+
+   SECTION("SSPRK104Solver")
+   {
+      std::cout <<"\nTesting SSPRK104Solver" << std::endl;
+      REQUIRE(check.order(new SSPRK104Solver) + tol > 4.0 );
+   }
+
    SECTION("ImplicitMidpointSolver")
    {
       std::cout <<"\nTesting ImplicitMidpointSolver" << std::endl;
@@ -281,3 +299,215 @@ TEST_CASE("First order ODE methods",
    }
 }
 
+
+TEST_CASE("Adaptive explicit RK methods",
+          "[ODE1][EmbeddedRKSolver]")
+{
+   // du/dt = -lambda (u - cos(t)), u(0) = 0, with a fast initial transient
+   class Relaxation : public TimeDependentOperator
+   {
+   public:
+      double lambda;
+      Relaxation(double l) : TimeDependentOperator(1, 0.0), lambda(l) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         dudt(0) = -lambda*(u(0) - cos(GetTime()));
+      }
+
+      double Exact(double t) const
+      {
+         const double l2 = lambda*lambda;
+         return (l2*cos(t) + lambda*sin(t) - l2*exp(-lambda*t))/(l2 + 1.0);
+      }
+   };
+
+   // Error norm that counts its evaluations
+   class CountingNorm : public ODEWRMSNorm
+   {
+   public:
+      mutable int count;
+      CountingNorm(double tol) : ODEWRMSNorm(tol, tol), count(0) { }
+
+      virtual double Eval(const Vector &err, const Vector &x0,
+                          const Vector &x1) const
+      {
+         count++;
+         return ODEWRMSNorm::Eval(err, x0, x1);
+      }
+   };
+
+   Relaxation oper(50.0);
+   const double t_final = 2.0, dt_out = 0.25;
+
+   for (int m = 0; m < 2; m++)
+   {
+      double err_prev = 1.0;
+      int steps_prev = 0;
+      for (double tol = 1e-5; tol > 1e-10; tol *= 1e-2)
+      {
+         EmbeddedRKSolver *ode_solver;
+         if (m == 0) { ode_solver = new DormandPrince54Solver; }
+         else { ode_solver = new Verner65Solver; }
+         CountingNorm norm(tol);
+         ode_solver->SetErrorNorm(norm);
+         ode_solver->Init(oper);
+
+         Vector u(1);
+         u = 0.0;
+         double t = 0.0, dt = 1e-3;
+         for (int i = 1; t < t_final - 1e-12; i++)
+         {
+            dt = dt_out;
+            ode_solver->Step(u, t, dt);
+            REQUIRE(fabs(t - i*dt_out) < 1e-14);
+            REQUIRE(dt <= dt_out + 1e-14);
+         }
+         const double err = fabs(u(0) - oper.Exact(t));
+         const int steps = ode_solver->GetNumSteps();
+         std::cout << "method " << m << ", tol " << tol << ": error " << err
+                   << ", steps " << steps << ", rejected "
+                   << ode_solver->GetNumRejectedSteps() << std::endl;
+
+         REQUIRE(err < 100*tol);
+         REQUIRE(err < err_prev);
+         REQUIRE(steps > steps_prev);
+         REQUIRE(norm.count == steps + ode_solver->GetNumRejectedSteps());
+         err_prev = err;
+         steps_prev = steps;
+         delete ode_solver;
+      }
+   }
+}
+
+TEST_CASE("IMEX additive RK methods",
+          "[ODE1][IMEXRKSolver]")
+{
+   // du/dt + (A1 + A2) u = 0, where the rotation A1 + A2 is split into two
+   // non-commuting terms; the second one is treated implicitly.
+   class SplitODE : public TimeDependentOperator
+   {
+   protected:
+      DenseMatrix A1, A2, T;
+      Vector r;
+
+      const DenseMatrix &Term() const
+      { return (GetEvalMode() == ADDITIVE_TERM_1) ? A1 : A2; }
+
+   public:
+      SplitODE() : TimeDependentOperator(2, 0.0), A1(2), A2(2), T(2), r(2)
+      {
+         A1 = 0.0;
+         A2 = 0.0;
+         A1(0,1) = 1.0;
+         A2(1,0) = -1.0;
+      }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         if (GetEvalMode() == NORMAL)
+         {
+            A1.Mult(u, dudt);
+            A2.AddMult(u, dudt);
+         }
+         else
+         {
+            Term().Mult(u, dudt);
+         }
+         dudt.Neg();
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &dudt)
+      {
+         REQUIRE(GetEvalMode() == ADDITIVE_TERM_2);
+         A2.Mult(u, r);
+         r.Neg();
+         T = A2;
+         T *= dt;
+         T(0,0) += 1.0;
+         T(1,1) += 1.0;
+         T.Invert();
+         T.Mult(r, dudt);
+      }
+   };
+
+   // du/dt = -lambda (u - cos(t)) - sin(t), u(0) = 1, with the stiff
+   // relaxation term treated implicitly; the solution is u = cos(t).
+   class StiffODE : public TimeDependentOperator
+   {
+   public:
+      double lambda;
+      StiffODE(double l) : TimeDependentOperator(1, 0.0), lambda(l) { }
+
+      virtual void Mult(const Vector &u, Vector &dudt) const
+      {
+         const double t = GetTime();
+         const double f1 = -sin(t), f2 = -lambda*(u(0) - cos(t));
+         switch (GetEvalMode())
+         {
+            case ADDITIVE_TERM_1: dudt(0) = f1; break;
+            case ADDITIVE_TERM_2: dudt(0) = f2; break;
+            default: dudt(0) = f1 + f2;
+         }
+      }
+
+      virtual void ImplicitSolve(const double dt, const Vector &u, Vector &dudt)
+      {
+         dudt(0) = -lambda*(u(0) - cos(GetTime()))/(1.0 + lambda*dt);
+      }
+   };
+
+   const int num_methods = 3;
+   const int orders[num_methods] = { 2, 3, 4 };
+   for (int m = 0; m < num_methods; m++)
+   {
+      std::cout << "\nTesting ARK" << orders[m] << "Solver" << std::endl;
+      SplitODE split;
+      StiffODE stiff(1e4);
+      ODESolver *ode_solver;
+      switch (m)
+      {
+         case 0: ode_solver = new ARK2Solver; break;
+         case 1: ode_solver = new ARK3Solver; break;
+         default: ode_solver = new ARK4Solver;
+      }
+
+      // order of convergence for the non-commuting split
+      const int levels = 6;
+      int steps = 4;
+      Vector u(2), u0(2), err(levels);
+      u0 = 1.0;
+      for (int l = 0; l < levels; l++, steps *= 2)
+      {
+         double t = 0.0, dt = M_PI/steps;
+         u = u0;
+         ode_solver->Init(split);
+         for (int ti = 0; ti < steps; ti++)
+         {
+            ode_solver->Step(u, t, dt);
+         }
+         REQUIRE(split.GetEvalMode() == TimeDependentOperator::NORMAL);
+         u += u0;
+         err(l) = u.Norml2();
+         if (l > 0)
+         {
+            std::cout << std::setw(12) << err(l) << std::setw(12)
+                      << log(err(l-1)/err(l))/log(2) << std::endl;
+         }
+      }
+      REQUIRE(log(err(levels-2)/err(levels-1))/log(2) + 0.1 > orders[m]);
+
+      // stability for the stiff term at a time step far above 1/lambda
+      Vector v(1);
+      v = 1.0;
+      double t = 0.0, dt = 0.1;
+      ode_solver->Init(stiff);
+      for (int ti = 0; ti < 20; ti++)
+      {
+         ode_solver->Step(v, t, dt);
+      }
+      REQUIRE(fabs(v(0) - cos(t)) < 1e-3);
+
+      delete ode_solver;
+   }
+}
@@ -0,0 +1,156 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+static void velocity(const Vector &x, Vector &v)
+{
+   v(0) = 1.0 + x(1);
+   v(1) = 0.5 - x(0);
+}
+
+// Assemble the matrix of (eps K + c M + N) on a unit square, where K is the
+// stiffness, M the mass and N the convection matrix (if conv is true), with
+// homogeneous Dirichlet boundary conditions.
+static SparseMatrix *AssembleMatrix(FiniteElementSpace &fes, double eps,
+                                    double c, bool conv)
+{
+   ConstantCoefficient eps_coeff(eps), c_coeff(c);
+   VectorFunctionCoefficient vel(2, velocity);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(eps_coeff));
+   a.AddDomainIntegrator(new MassIntegrator(c_coeff));
+   if (conv) { a.AddDomainIntegrator(new ConvectionIntegrator(vel)); }
+   a.Assemble();
+   a.Finalize();
+   Array<int> ess_tdof_list;
+   Array<int> ess_bdr(fes.GetMesh()->bdr_attributes.Max());
+   ess_bdr = 1;
+   fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+   SparseMatrix *A = new SparseMatrix(a.SpMat());
+   for (int i = 0; i < ess_tdof_list.Size(); i++)
+   {
+      A->EliminateRowCol(ess_tdof_list[i]);
+   }
+   return A;
+}
+
+static double RelativeResidual(const Operator &A, const Vector &b,
+                               const Vector &x)
+{
+   Vector r(b.Size());
+   A.Mult(x, r);
+   r -= b;
+   return r.Norml2() / b.Norml2();
+}
+
+TEST_CASE("Recycling Krylov solvers", "[DeflatedCGSolver][GCRODRSolver]")
+{
+   const int ne = 16, nsteps = 4;
+   Mesh mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   H1_FECollection fec(2, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   const int n = fes.GetTrueVSize();
+
+   SECTION("DeflatedCGSolver")
+   {
+      DeflatedCGSolver dcg;
+      dcg.SetRelTol(1e-10);
+      dcg.SetMaxIter(1000);
+      dcg.SetPrintLevel(-1);
+      dcg.SetRecycleDim(8);
+      dcg.SetNumStoredDirections(100);
+
+      CGSolver cg;
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(1000);
+      cg.SetPrintLevel(-1);
+
+      int its_cg = 0, its_dcg = 0;
+      for (int step = 0; step < nsteps; step++)
+      {
+         // slowly changing operators, e.g. implicit time stepping
+         SparseMatrix *A = AssembleMatrix(fes, 1.0, 0.1*step, false);
+         DSmoother M(*A);
+         Vector b(n), x(n), xcg(n);
+         b.Randomize(step+1);
+         x = 0.0;
+         xcg = 0.0;
+
+         dcg.SetPreconditioner(M);
+         dcg.SetOperator(*A);
+         dcg.Mult(b, x);
+         REQUIRE(dcg.GetConverged());
+         REQUIRE(RelativeResidual(*A, b, x) < 1e-8);
+
+         cg.SetPreconditioner(M);
+         cg.SetOperator(*A);
+         cg.Mult(b, xcg);
+         REQUIRE(cg.GetConverged());
+
+         if (step == 0)
+         {
+            REQUIRE(dcg.GetNumIterations() == cg.GetNumIterations());
+            REQUIRE(dcg.GetRecycledSpace().Width() == 8);
+         }
+         else
+         {
+            its_cg += cg.GetNumIterations();
+            its_dcg += dcg.GetNumIterations();
+         }
+         delete A;
+      }
+      REQUIRE(its_dcg < 0.8*its_cg);
+   }
+
+   SECTION("GCRODRSolver")
+   {
+      GCRODRSolver gcrodr;
+      gcrodr.SetRelTol(1e-10);
+      gcrodr.SetMaxIter(2000);
+      gcrodr.SetPrintLevel(-1);
+      gcrodr.SetKDim(30);
+      gcrodr.SetRecycleDim(10);
+
+      GMRESSolver gmres;
+      gmres.SetRelTol(1e-10);
+      gmres.SetMaxIter(2000);
+      gmres.SetPrintLevel(-1);
+      gmres.SetKDim(30);
+
+      int its_gmres = 0, its_gcrodr = 0;
+      for (int step = 0; step < nsteps; step++)
+      {
+         SparseMatrix *A = AssembleMatrix(fes, 0.1, 0.1*step, true);
+         Vector b(n), x(n), xg(n);
+         b.Randomize(step+1);
+         x = 0.0;
+         xg = 0.0;
+
+         gcrodr.SetOperator(*A);
+         gcrodr.Mult(b, x);
+         REQUIRE(gcrodr.GetConverged());
+         REQUIRE(RelativeResidual(*A, b, x) < 1e-8);
+
+         gmres.SetOperator(*A);
+         gmres.Mult(b, xg);
+         REQUIRE(gmres.GetConverged());
+
+         its_gmres += gmres.GetNumIterations();
+         its_gcrodr += gcrodr.GetNumIterations();
+         delete A;
+      }
+      REQUIRE(its_gcrodr < its_gmres);
+   }
+}
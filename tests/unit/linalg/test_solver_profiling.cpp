@@ -0,0 +1,110 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+class CountingMonitor : public IterativeSolverMonitor
+{
+public:
+   int count = 0;
+   double last_norm = -1.0;
+
+   virtual void MonitorIteration(const IterationStats &stats)
+   {
+      REQUIRE(stats.iteration == count);
+      count++;
+      last_norm = stats.norm;
+   }
+};
+
+TEST_CASE("IterativeSolver profiling", "[IterativeSolver]")
+{
+   const int ne = 8;
+   Mesh mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   ConstantCoefficient one(1.0);
+   BilinearForm a(&fes);
+   a.AddDomainIntegrator(new DiffusionIntegrator(one));
+   a.AddDomainIntegrator(new MassIntegrator(one));
+   a.Assemble();
+   a.Finalize();
+   const SparseMatrix &A = a.SpMat();
+   DSmoother M(A);
+
+   Vector b(A.Height()), x(A.Height());
+   b.Randomize(1);
+
+   SECTION("CGSolver")
+   {
+      CGSolver cg;
+      cg.SetRelTol(1e-10);
+      cg.SetMaxIter(200);
+      cg.SetPrintLevel(-1);
+      cg.SetOperator(A);
+      cg.SetPreconditioner(M);
+
+      // no statistics unless enabled
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetIterationStats().Size() == 0);
+
+      CountingMonitor monitor;
+      cg.SetMonitor(monitor);
+      x = 0.0;
+      cg.Mult(b, x);
+      REQUIRE(cg.GetConverged());
+
+      const Array<IterationStats> &stats = cg.GetIterationStats();
+      REQUIRE(stats.Size() == cg.GetNumIterations() + 1);
+      REQUIRE(monitor.count == stats.Size());
+      REQUIRE(monitor.last_norm == cg.GetFinalNorm());
+      for (int i = 0; i < stats.Size(); i++)
+      {
+         REQUIRE(stats[i].iteration == i);
+         REQUIRE(stats[i].oper_calls == 1);
+         REQUIRE(stats[i].prec_calls == 1);
+         REQUIRE(stats[i].dot_calls >= 1);
+         REQUIRE(stats[i].oper_time >= 0.0);
+         REQUIRE(stats[i].prec_time >= 0.0);
+         REQUIRE(stats[i].dot_time >= 0.0);
+         REQUIRE(stats[i].update_time >= 0.0);
+      }
+   }
+
+   SECTION("GMRESSolver")
+   {
+      GMRESSolver gmres;
+      gmres.SetRelTol(1e-10);
+      gmres.SetMaxIter(200);
+      gmres.SetKDim(100);
+      gmres.SetPrintLevel(-1);
+      gmres.SetOperator(A);
+      gmres.SetPreconditioner(M);
+      gmres.SetProfiling();
+      x = 0.0;
+      gmres.Mult(b, x);
+      REQUIRE(gmres.GetConverged());
+
+      const Array<IterationStats> &stats = gmres.GetIterationStats();
+      REQUIRE(stats.Size() == gmres.GetNumIterations() + 1);
+      REQUIRE(stats.Last().norm == gmres.GetFinalNorm());
+      for (int i = 1; i < stats.Size(); i++)
+      {
+         REQUIRE(stats[i].oper_calls == 1);
+         REQUIRE(stats[i].prec_calls == 1);
+         REQUIRE(stats[i].dot_calls == i+1);
+      }
+   }
+}
@@ -0,0 +1,91 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+TEST_CASE("SparseLDLSolver", "[SparseLDLSolver]")
+{
+   for (int dim = 2; dim <= 3; ++dim)
+   {
+      const int ne = (dim == 2) ? 8 : 3;
+      Mesh *mesh = (dim == 2) ?
+                   new Mesh(ne, ne, Element::QUADRILATERAL, 1, 1.0, 1.0) :
+                   new Mesh(ne, ne, ne, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+      H1_FECollection fec(2, dim);
+      FiniteElementSpace fes(mesh, &fec);
+
+      Array<int> ess_tdof_list;
+      Array<int> ess_bdr(mesh->bdr_attributes.Max());
+      ess_bdr = 1;
+      fes.GetEssentialTrueDofs(ess_bdr, ess_tdof_list);
+
+      ConstantCoefficient one(1.0);
+      BilinearForm a(&fes);
+      a.AddDomainIntegrator(new DiffusionIntegrator(one));
+      a.AddDomainIntegrator(new MassIntegrator(one));
+      a.Assemble();
+
+      GridFunction x(&fes), b(&fes);
+      x = 0.0;
+      b.Randomize(1);
+      SparseMatrix A;
+      Vector X, B;
+      a.FormLinearSystem(ess_tdof_list, x, b, A, X, B);
+
+      Vector R(B.Size());
+      for (int ordering = 0; ordering < 2; ordering++)
+      {
+         SparseLDLSolver ldl(A, ordering == 0 ?
+                             SparseLDLSolver::Ordering::MINIMUM_DEGREE :
+                             SparseLDLSolver::Ordering::NATURAL);
+         REQUIRE(ldl.GetNumSupernodes() <= A.Height());
+         REQUIRE(ldl.GetFactorNNZ() >= (A.NumNonZeroElems() + A.Height())/2);
+
+         ldl.Mult(B, X);
+         A.Mult(X, R);
+         R -= B;
+         REQUIRE(R.Normlinf() < 1e-10*B.Normlinf());
+
+         // Reuse the symbolic factorization with a scaled matrix.
+         A *= 2.0;
+         ldl.SetOperator(A);
+         ldl.Mult(B, X);
+         A.Mult(X, R);
+         R -= B;
+         REQUIRE(R.Normlinf() < 1e-10*B.Normlinf());
+         A *= 0.5;
+
+         // Only the lower triangle, in the original ordering, is used.
+         SparseMatrix A_lower(A.Height());
+         for (int i = 0; i < A.Height(); i++)
+         {
+            for (int k = A.GetI()[i]; k < A.GetI()[i+1]; k++)
+            {
+               const int j = A.GetJ()[k];
+               if (j <= i) { A_lower.Add(i, j, A.GetData()[k]); }
+            }
+         }
+         A_lower.Finalize();
+         SparseLDLSolver ldl_lower(A_lower, ordering == 0 ?
+                                   SparseLDLSolver::Ordering::MINIMUM_DEGREE :
+                                   SparseLDLSolver::Ordering::NATURAL);
+         ldl_lower.Mult(B, X);
+         A.Mult(X, R);
+         R -= B;
+         REQUIRE(R.Normlinf() < 1e-10*B.Normlinf());
+      }
+
+      delete mesh;
+   }
+}
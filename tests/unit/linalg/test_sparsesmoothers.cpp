@@ -0,0 +1,73 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+TEST_CASE("Level-scheduled Gauss-Seidel", "[GSSmoother]")
+{
+   // 5-point Laplacian on an n x n grid with an additional nonsymmetric
+   // coupling to make the sparsity pattern unsymmetric.
+   int n = 12;
+   int N = n * n;
+   SparseMatrix A(N, N);
+   for (int j = 0; j < n; j++)
+   {
+      for (int i = 0; i < n; i++)
+      {
+         int k = i + n * j;
+         A.Add(k, k, 4.0);
+         if (i > 0) { A.Add(k, k - 1, -1.0); }
+         if (i < n - 1) { A.Add(k, k + 1, -1.0); }
+         if (j > 0) { A.Add(k, k - n, -1.0); }
+         if (j < n - 1) { A.Add(k, k + n, -1.0); }
+         if (k + 2 * n + 1 < N) { A.Add(k, k + 2 * n + 1, 0.5); }
+      }
+   }
+   A.Finalize();
+
+   Table levels;
+   A.GetGaussSeidelLevels(levels);
+   REQUIRE(levels.Size() > 1);
+   REQUIRE(levels.Size_of_connections() == N);
+
+   Vector b(N), y0(N), y1(N);
+   b.Randomize(1);
+   y0.Randomize(2);
+   y1 = y0;
+
+   SECTION("Forward and backward sweeps")
+   {
+      A.Gauss_Seidel_forw(b, y0);
+      A.Gauss_Seidel_forw(b, y1, levels);
+      y1 -= y0;
+      REQUIRE(y1.Normlinf() < 1e-14);
+
+      y1 = y0;
+      A.Gauss_Seidel_back(b, y0);
+      A.Gauss_Seidel_back(b, y1, levels);
+      y1 -= y0;
+      REQUIRE(y1.Normlinf() < 1e-14);
+   }
+
+   SECTION("GSSmoother")
+   {
+      GSSmoother S0(A, 0, 3), S1(A, 0, 3);
+      S0.SetLevelScheduling(false);
+      S1.SetLevelScheduling(true);
+      S0.Mult(b, y0);
+      S1.Mult(b, y1);
+      y1 -= y0;
+      REQUIRE(y1.Normlinf() < 1e-14);
+   }
+}
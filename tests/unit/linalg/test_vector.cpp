@@ -0,0 +1,76 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "catch.hpp"
+#include "mfem.hpp"
+
+using namespace mfem;
+
+TEST_CASE("Multi-vector operations", "[Vector][MultiDot][MultiAXPY]")
+{
+   // sizes spanning several chunks of the host kernels, and numbers of
+   // vectors that are not multiples of the blocking
+   const int sizes[] = { 0, 7, 3001 };
+   const int nvecs[] = { 1, 3, 6 };
+   for (int si = 0; si < 3; si++)
+   {
+      for (int ki = 0; ki < 3; ki++)
+      {
+         const int n = sizes[si], k = nvecs[ki];
+         // d is sized by MultiDot, except for empty vectors
+         Vector x(n), Y(n*k), a(k), d(n ? 0 : k), d2, x2(n), x3(n);
+         x.Randomize(1);
+         Y.Randomize(2);
+         a.Randomize(3);
+         Array<Vector*> y(k);
+         for (int j = 0; j < k; j++)
+         {
+            y[j] = new Vector;
+            y[j]->MakeRef(Y, j*n, n);
+         }
+
+         MultiDot(x, Y, d);
+         MultiDot(x, y, d2);
+         REQUIRE(d.Size() == k);
+         REQUIRE(d2.Size() == k);
+         for (int j = 0; j < k; j++)
+         {
+            const double dj = x * (*y[j]);
+            REQUIRE(fabs(d(j) - dj) <= 1e-12*(1.0 + fabs(dj)));
+            REQUIRE(fabs(d2(j) - dj) <= 1e-12*(1.0 + fabs(dj)));
+         }
+
+         // the summation order is fixed, so the results are reproducible
+         Vector d3(k);
+         MultiDot(x, Y, d3);
+         for (int j = 0; j < k; j++)
+         {
+            REQUIRE(d3(j) == d(j));
+            REQUIRE(d2(j) == d(j));
+         }
+
+         x2 = x;
+         x3 = x;
+         MultiAXPY(-0.5, a, Y, x2);
+         MultiAXPY(-0.5, a, y, x3);
+         for (int j = 0; j < k; j++)
+         {
+            x.Add(-0.5*a(j), *y[j]);
+         }
+         x2 -= x;
+         x3 -= x;
+         REQUIRE(x2.Normlinf() <= 1e-12);
+         REQUIRE(x3.Normlinf() <= 1e-12);
+
+         for (int j = 0; j < k; j++) { delete y[j]; }
+      }
+   }
+}
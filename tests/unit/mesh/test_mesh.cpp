@@ -95,3 +95,600 @@ TEST_CASE("Gecko integration in MFEM", "[Mesh]")
 }
 
 #endif
+
+static void CompareMeshes(Mesh &m1, Mesh &m2)
+{
+   REQUIRE(m1.Dimension() == m2.Dimension());
+   REQUIRE(m1.SpaceDimension() == m2.SpaceDimension());
+   REQUIRE(m1.GetNE() == m2.GetNE());
+   REQUIRE(m1.GetNBE() == m2.GetNBE());
+   REQUIRE(m1.GetNV() == m2.GetNV());
+   REQUIRE(m1.GetNEdges() == m2.GetNEdges());
+   REQUIRE(m1.GetNFaces() == m2.GetNFaces());
+
+   int mismatch = 0;
+   Array<int> v1, v2;
+   for (int i = 0; i < m1.GetNE(); i++)
+   {
+      m1.GetElementVertices(i, v1);
+      m2.GetElementVertices(i, v2);
+      if (v1 != v2 || m1.GetAttribute(i) != m2.GetAttribute(i) ||
+          m1.GetElementBaseGeometry(i) != m2.GetElementBaseGeometry(i))
+      {
+         mismatch++;
+      }
+   }
+   for (int i = 0; i < m1.GetNBE(); i++)
+   {
+      m1.GetBdrElementVertices(i, v1);
+      m2.GetBdrElementVertices(i, v2);
+      if (v1 != v2 || m1.GetBdrAttribute(i) != m2.GetBdrAttribute(i))
+      {
+         mismatch++;
+      }
+   }
+   for (int i = 0; i < m1.GetNV(); i++)
+   {
+      for (int d = 0; d < m1.SpaceDimension(); d++)
+      {
+         if (m1.GetVertex(i)[d] != m2.GetVertex(i)[d]) { mismatch++; }
+      }
+   }
+   REQUIRE(mismatch == 0);
+
+   REQUIRE((m1.GetNodes() == NULL) == (m2.GetNodes() == NULL));
+   if (m1.GetNodes())
+   {
+      const GridFunction &n1 = *m1.GetNodes(), &n2 = *m2.GetNodes();
+      REQUIRE(!strcmp(n1.FESpace()->FEColl()->Name(),
+                      n2.FESpace()->FEColl()->Name()));
+      REQUIRE(n1.FESpace()->GetOrdering() == n2.FESpace()->GetOrdering());
+      REQUIRE(n1.Size() == n2.Size());
+      Vector diff(n1);
+      diff -= n2;
+      REQUIRE(diff.Normlinf() == 0.0);
+   }
+}
+
+TEST_CASE("Binary mesh format", "[Mesh]")
+{
+   const char *filename = "binary_mesh_test.mesh";
+
+   SECTION("2D triangle mesh")
+   {
+      Mesh mesh(4, 3, Element::TRIANGLE, true, 2.0, 1.5);
+      mesh.SetAttributes();
+      for (int i = 0; i < mesh.GetNE(); i++)
+      {
+         mesh.SetAttribute(i, 1 + i % 3);
+      }
+
+      std::stringstream buf;
+      mesh.PrintBinary(buf);
+      Mesh mesh2(buf);
+      CompareMeshes(mesh, mesh2);
+   }
+
+   SECTION("Curved 3D mesh through a file")
+   {
+      Mesh mesh(3, 2, 2, Element::HEXAHEDRON);
+      mesh.SetCurvature(3, false, -1, Ordering::byVDIM);
+      GridFunction &nodes = *mesh.GetNodes();
+      for (int i = 0; i < nodes.Size(); i++)
+      {
+         nodes(i) += 0.01*sin(1.0*i);
+      }
+
+      {
+         std::ofstream out(filename, std::ios::binary);
+         mesh.PrintBinary(out);
+      }
+      Mesh mesh2(filename, 1, 1);
+      CompareMeshes(mesh, mesh2);
+      remove(filename);
+   }
+
+#ifdef MFEM_USE_EXCEPTIONS
+   SECTION("Truncated file")
+   {
+      Mesh mesh(3, 3, 3, Element::HEXAHEDRON);
+      std::stringstream buf;
+      mesh.PrintBinary(buf);
+      const std::string data = buf.str();
+      {
+         std::ofstream out(filename, std::ios::binary);
+         out.write(data.c_str(), data.size()/2);
+      }
+      REQUIRE_THROWS(Mesh(filename, 1, 1));
+      remove(filename);
+   }
+#endif
+}
+
+// Number of connected components of each part of the partitioning.
+static int MaxPartComponents(Mesh &mesh, const int *partitioning, int nparts)
+{
+   const Table &el_el = mesh.ElementToElementTable();
+   Array<int> comp(mesh.GetNE()), ncomp(nparts), stack;
+   comp = -1;
+   ncomp = 0;
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      if (comp[i] >= 0) { continue; }
+      const int p = partitioning[i];
+      comp[i] = ncomp[p]++;
+      stack.Append(i);
+      while (stack.Size())
+      {
+         const int e = stack.Last();
+         stack.DeleteLast();
+         for (int k = 0; k < el_el.RowSize(e); k++)
+         {
+            const int n = el_el.GetRow(e)[k];
+            if (partitioning[n] == p && comp[n] < 0)
+            {
+               comp[n] = comp[i];
+               stack.Append(n);
+            }
+         }
+      }
+   }
+   return ncomp.Max();
+}
+
+TEST_CASE("Space-filling curve partitioning", "[Mesh]")
+{
+   const int nparts = 7;
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh_ptr =
+         (dim == 2) ? new Mesh(16, 16, Element::QUADRILATERAL, 1, 1.0, 1.0) :
+         new Mesh(6, 5, 4, Element::TETRAHEDRON, 1, 1.0, 1.0, 1.0);
+      Mesh &mesh = *mesh_ptr;
+      const int ne = mesh.GetNE();
+      Vector weights(ne);
+      for (int i = 0; i < ne; i++)
+      {
+         const int v0 = mesh.GetElement(i)->GetVertices()[0];
+         weights(i) = (mesh.GetVertex(v0)[0] < 0.5) ? 1.0 : 3.0;
+      }
+
+      for (int morton = 0; morton <= 1; morton++)
+      {
+         Array<int> ordering;
+         if (morton) { mesh.GetMortonElementOrdering(ordering); }
+         else { mesh.GetHilbertElementOrdering(ordering); }
+         Array<int> curve(ne);
+         for (int i = 0; i < ne; i++) { curve[ordering[i]] = i; }
+
+         int *part = mesh.SpaceFillingCurvePartitioning(nparts, NULL, morton);
+         int *part_w = mesh.SpaceFillingCurvePartitioning(nparts, &weights,
+                                                          morton);
+         int *part_g = mesh.GeneratePartitioning(nparts, 6 + morton);
+
+         // the parts are consecutive segments of the curve
+         int mismatch = 0;
+         Array<int> size(nparts);
+         Vector wsize(nparts);
+         size = 0;
+         wsize = 0.0;
+         for (int k = 0; k < ne; k++)
+         {
+            const int e = curve[k];
+            if (k > 0 && part[e] < part[curve[k-1]]) { mismatch++; }
+            if (k > 0 && part_w[e] < part_w[curve[k-1]]) { mismatch++; }
+            if (part_g[e] != part[e]) { mismatch++; }
+            size[part[e]]++;
+            wsize(part_w[e]) += weights(e);
+         }
+         REQUIRE(mismatch == 0);
+
+         // balanced parts, equal up to one element
+         REQUIRE(size.Min() > 0);
+         REQUIRE(size.Max() - size.Min() <= 1);
+         const double avg = weights.Sum()/nparts;
+         for (int p = 0; p < nparts; p++)
+         {
+            REQUIRE(fabs(wsize(p) - avg) <= weights.Max());
+         }
+
+         // the Hilbert curve of a uniform grid gives connected parts
+         if (dim == 2 && !morton)
+         {
+            REQUIRE(MaxPartComponents(mesh, part, nparts) == 1);
+         }
+
+         delete [] part;
+         delete [] part_w;
+         delete [] part_g;
+      }
+      delete mesh_ptr;
+   }
+
+   // fewer elements than parts
+   Mesh mesh(2, 2, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   int *part = mesh.SpaceFillingCurvePartitioning(6);
+   Array<int> parts(part, mesh.GetNE());
+   parts.Sort();
+   REQUIRE(parts.Min() == 0);
+   REQUIRE(parts.Max() == mesh.GetNE() - 1);
+   parts.Unique();
+   REQUIRE(parts.Size() == mesh.GetNE());
+   delete [] part;
+}
+
+// Count the differences between the topology of 'mesh' and the numbering of
+// its edges and faces by DSTable and STable3D in the element order.
+static int CheckTopology(Mesh &mesh)
+{
+   const int dim = mesh.Dimension(), nv = mesh.GetNV();
+   int mismatch = 0;
+   Array<int> ents, ori, fent;
+
+   DSTable v_to_v(nv);
+   STable3D faces(nv);
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      const Element *el = mesh.GetElement(i);
+      const int *v = el->GetVertices();
+      for (int j = 0; j < el->GetNEdges(); j++)
+      {
+         const int *e = el->GetEdgeVertices(j);
+         v_to_v.Push(v[e[0]], v[e[1]]);
+      }
+      for (int j = 0; dim == 3 && j < el->GetNFaces(); j++)
+      {
+         const int *f = el->GetFaceVertices(j);
+         if (el->GetNFaceVertices(j) == 3)
+         {
+            faces.Push(v[f[0]], v[f[1]], v[f[2]]);
+         }
+         else
+         {
+            faces.Push4(v[f[0]], v[f[1]], v[f[2]], v[f[3]]);
+         }
+      }
+   }
+   if (dim > 1 && v_to_v.NumberOfEntries() != mesh.GetNEdges()) { mismatch++; }
+   if (dim == 3 && faces.NumberOfElements() != mesh.GetNFaces()) { mismatch++; }
+
+   // element and boundary element edges and faces; 'fent' collects the face
+   // of each local face of the elements
+   for (int i = 0; i < mesh.GetNE(); i++)
+   {
+      const Element *el = mesh.GetElement(i);
+      const int *v = el->GetVertices();
+      if (dim > 1)
+      {
+         mesh.GetElementEdges(i, ents, ori);
+         for (int j = 0; j < el->GetNEdges(); j++)
+         {
+            const int *e = el->GetEdgeVertices(j);
+            if (ents[j] != v_to_v(v[e[0]], v[e[1]])) { mismatch++; }
+         }
+      }
+      if (dim == 3)
+      {
+         mesh.GetElementFaces(i, ents, ori);
+         for (int j = 0; j < el->GetNFaces(); j++)
+         {
+            const int *f = el->GetFaceVertices(j);
+            const int ref = (el->GetNFaceVertices(j) == 3) ?
+                            faces(v[f[0]], v[f[1]], v[f[2]]) :
+                            faces(v[f[0]], v[f[1]], v[f[2]], v[f[3]]);
+            if (ents[j] != ref) { mismatch++; }
+         }
+      }
+      else if (dim == 1)
+      {
+         ents.SetSize(2);
+         ents[0] = v[0];
+         ents[1] = v[1];
+      }
+      fent.Append(ents);
+   }
+   for (int i = 0; dim > 1 && i < mesh.GetNBE(); i++)
+   {
+      const Element *el = mesh.GetBdrElement(i);
+      const int *v = el->GetVertices();
+      mesh.GetBdrElementEdges(i, ents, ori);
+      for (int j = 0; j < el->GetNEdges(); j++)
+      {
+         const int *e = el->GetEdgeVertices(j);
+         if (ents[j] != v_to_v(v[e[0]], v[e[1]])) { mismatch++; }
+      }
+      if (dim == 3)
+      {
+         int f, o;
+         mesh.GetBdrElementFace(i, &f, &o);
+         const int ref = (el->GetNVertices() == 3) ?
+                         faces(v[0], v[1], v[2]) :
+                         faces(v[0], v[1], v[2], v[3]);
+         if (f != ref) { mismatch++; }
+      }
+   }
+
+   // the first element of a face is the first one containing it and the
+   // second element is the last one
+   Array<int> elem1(mesh.GetNumFaces()), inf1(mesh.GetNumFaces());
+   Array<int> elem2(mesh.GetNumFaces());
+   elem1 = -1;
+   elem2 = -1;
+   for (int i = 0, k = 0; i < mesh.GetNE(); i++)
+   {
+      const int nf = fent.Size() / mesh.GetNE();
+      for (int j = 0; j < nf; j++, k++)
+      {
+         const int f = fent[k];
+         if (elem1[f] < 0) { elem1[f] = i; inf1[f] = 64*j; }
+         else { elem2[f] = i; }
+      }
+   }
+   for (int f = 0; f < mesh.GetNumFaces(); f++)
+   {
+      int e1, e2, i1, i2;
+      mesh.GetFaceElements(f, &e1, &e2);
+      mesh.GetFaceInfos(f, &i1, &i2);
+      if (e1 != elem1[f] || e2 != elem2[f] || i1 != inf1[f]) { mismatch++; }
+   }
+   return mismatch;
+}
+
+TEST_CASE("Topology construction", "[Mesh]")
+{
+   // both the serial and the threaded construction match the reference
+   const bool threaded = Mesh::threaded_topology;
+   for (int t = 0; t < 12; t++)
+   {
+      Mesh::threaded_topology = (t % 2);
+      Mesh *mesh;
+      switch (t / 2)
+      {
+         case 0: mesh = new Mesh(9, 1.0); break;
+         case 1:
+            mesh = new Mesh(5, 4, Element::QUADRILATERAL, 1, 1.0, 1.0);
+            break;
+         case 2:
+            mesh = new Mesh(5, 4, Element::TRIANGLE, 1, 1.0, 1.0);
+            break;
+         case 3:
+            mesh = new Mesh(3, 3, 2, Element::HEXAHEDRON, 1, 1.0, 1.0, 1.0);
+            break;
+         case 4:
+            mesh = new Mesh(3, 2, 3, Element::TETRAHEDRON, 1, 1.0, 1.0, 1.0);
+            break;
+         default:
+            mesh = new Mesh(2, 3, 2, Element::WEDGE, 1, 1.0, 1.0, 1.0);
+            break;
+      }
+      REQUIRE(CheckTopology(*mesh) == 0);
+
+      // the numbering follows the element order
+      const int ne = mesh->GetNE();
+      Array<int> ordering(ne);
+      for (int i = 0; i < ne; i++)
+      {
+         ordering[i] = (ne % 5) ? (5*i + 3) % ne : ne-1-i;
+      }
+      mesh->ReorderElements(ordering);
+      REQUIRE(CheckTopology(*mesh) == 0);
+
+      mesh->UniformRefinement();
+      REQUIRE(CheckTopology(*mesh) == 0);
+      delete mesh;
+   }
+   Mesh::threaded_topology = threaded;
+}
+
+TEST_CASE("NCMesh memory after derefinement", "[Mesh][NCMesh]")
+{
+   Mesh mesh(4, 4, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   mesh.EnsureNCMesh();
+   const int ne0 = mesh.GetNE();
+
+   // a linear function is preserved exactly by refinement and derefinement
+   H1_FECollection fec(1, 2);
+   FiniteElementSpace fes(&mesh, &fec);
+   GridFunction x(&fes);
+   FunctionCoefficient f([](const Vector &p) { return 1.0 + p(0) - 2*p(1); });
+   x.ProjectCoefficient(f);
+
+   const long initial_mem = mesh.ncmesh->MemoryUsage();
+   long peak_mem = 0;
+   for (int cycle = 0; cycle < 3; cycle++)
+   {
+      // refine beyond the block size of the NCMesh containers
+      for (int i = 0; i < 5; i++)
+      {
+         mesh.UniformRefinement();
+         fes.Update();
+         x.Update();
+      }
+      peak_mem = std::max(peak_mem, mesh.ncmesh->MemoryUsage());
+
+      while (mesh.GetNE() > ne0)
+      {
+         Vector zero(mesh.GetNE());
+         zero = 0.0;
+         REQUIRE(mesh.DerefineByError(zero, 1.0));
+         fes.Update();
+         x.Update();
+      }
+      REQUIRE(x.ComputeL2Error(f) < 1e-12);
+
+      // the storage of the derefined elements, nodes and faces is released
+      const long coarse_mem = mesh.ncmesh->MemoryUsage();
+      REQUIRE(coarse_mem < initial_mem + 64*1024);
+      REQUIRE(coarse_mem < peak_mem / 3);
+   }
+}
+
+// Sum of the quadrature weights times the Jacobian determinants (the volume).
+static double GeomFactorsVolume(const GeometricFactors &gf,
+                                const IntegrationRule &ir)
+{
+   double vol = 0.0;
+   const int NQ = ir.GetNPoints();
+   for (int i = 0; i < gf.detJ.Size(); i++)
+   {
+      vol += ir.IntPoint(i % NQ).weight * gf.detJ(i);
+   }
+   return vol;
+}
+
+TEST_CASE("Geometric factors cache", "[Mesh]")
+{
+   const int flags = GeometricFactors::JACOBIANS |
+                     GeometricFactors::DETERMINANTS;
+   for (int type = 0; type < 2; type++)
+   {
+      Mesh mesh(3, 2, type ? Element::TRIANGLE : Element::QUADRILATERAL,
+                1, 2.0, 1.0);
+      const Geometry::Type geom = mesh.GetElementBaseGeometry(0);
+      const IntegrationRule &ir = IntRules.Get(geom, 4);
+
+      // a copy of the rule shares the factors, also for a subset of the flags
+      IntegrationRule ir_copy(ir);
+      const GeometricFactors *gf = mesh.GetGeometricFactors(ir, flags);
+      REQUIRE(mesh.GetGeometricFactors(ir_copy, flags) == gf);
+      REQUIRE(mesh.GetGeometricFactors(ir, GeometricFactors::JACOBIANS) == gf);
+      REQUIRE(fabs(GeomFactorsVolume(*gf, ir) - 2.0) < 1e-12);
+
+      // requesting more flags computes the union
+      const GeometricFactors *gf2 =
+         mesh.GetGeometricFactors(ir, GeometricFactors::COORDINATES);
+      REQUIRE(gf2 != gf);
+      REQUIRE((gf2->computed_factors & flags) == flags);
+      REQUIRE(mesh.GetGeometricFactors(ir, flags |
+                                       GeometricFactors::COORDINATES) == gf2);
+
+      // moving the nodes invalidates the cache
+      Vector disp(mesh.GetNodes()->Size());
+      disp = 0.0;
+      for (int i = 0; i < mesh.GetNodes()->Size()/2; i++)
+      {
+         disp(2*i) = (*mesh.GetNodes())(2*i); // x -> 2x
+      }
+      mesh.MoveNodes(disp);
+      gf = mesh.GetGeometricFactors(ir, flags);
+      REQUIRE(fabs(GeomFactorsVolume(*gf, ir) - 4.0) < 1e-12);
+
+      // and so does the refinement
+      mesh.UniformRefinement();
+      gf = mesh.GetGeometricFactors(ir, flags);
+      REQUIRE(gf->detJ.Size() == ir.GetNPoints()*mesh.GetNE());
+      REQUIRE(fabs(GeomFactorsVolume(*gf, ir) - 4.0) < 1e-12);
+   }
+}
+
+// Map the point 'x' of the unit cube, with a smooth curved deformation.
+static void CurvedMap(const Vector &x, Vector &y)
+{
+   y = x;
+   for (int d = 0; d < x.Size(); d++)
+   {
+      y(d) += 0.05*sin(M_PI*x(d))*sin(M_PI*x((d+1) % x.Size()));
+   }
+}
+
+// Check that FindPoints locates quasi-random points between the element centers
+// and the element corners, using 'inv' (if not NULL) for the inversion.
+static void CheckFindPoints(Mesh &mesh,
+                            InverseElementTransformation *inv = NULL)
+{
+   const int sdim = mesh.SpaceDimension();
+   const int npts = 500;
+   DenseMatrix points(sdim, npts + 1);
+   IntegrationPoint rp;
+   Vector pt;
+   for (int k = 0; k < npts; k++)
+   {
+      // golden ratio sequences for the element and the reference point
+      double a = fmod(0.6180339887*(k+1), 1.0);
+      double b = fmod(0.7548776662*(k+1), 1.0);
+      int el = std::min(int(a*mesh.GetNE()), mesh.GetNE()-1);
+      const Geometry::Type geom = mesh.GetElementBaseGeometry(el);
+      const IntegrationRule *verts = Geometries.GetVertices(geom);
+      rp = Geometries.GetCenter(geom);
+      const IntegrationPoint &v = verts->IntPoint(k % verts->GetNPoints());
+      rp.x += 0.98*b*(v.x - rp.x);
+      rp.y += 0.98*b*(v.y - rp.y);
+      if (mesh.Dimension() == 3) { rp.z += 0.98*b*(v.z - rp.z); }
+      pt.SetDataAndSize(points.GetColumn(k), sdim);
+      mesh.GetElementTransformation(el)->Transform(rp, pt);
+   }
+   // a point outside of the mesh
+   for (int d = 0; d < sdim; d++) { points(d, npts) = 1.5; }
+
+   Array<int> elem_ids;
+   Array<IntegrationPoint> ips;
+   REQUIRE(mesh.FindPoints(points, elem_ids, ips, false, inv) == npts);
+   REQUIRE(elem_ids[npts] == -1);
+
+   double err = 0.0;
+   Vector x(sdim);
+   for (int k = 0; k < npts; k++)
+   {
+      REQUIRE(elem_ids[k] >= 0);
+      mesh.GetElementTransformation(elem_ids[k])->Transform(ips[k], x);
+      pt.SetDataAndSize(points.GetColumn(k), sdim);
+      err = std::max(err, x.DistanceTo(pt));
+   }
+   REQUIRE(err < 1e-10);
+}
+
+TEST_CASE("Point location", "[Mesh]")
+{
+   for (int type = 0; type < 3; type++)
+   {
+      Mesh *mesh_ptr = (type == 0) ?
+                       new Mesh(8, 8, Element::TRIANGLE, 1, 1.0, 1.0) :
+                       new Mesh(4, 4, 4, (type == 1) ? Element::HEXAHEDRON :
+                                Element::TETRAHEDRON, 1, 1.0, 1.0, 1.0);
+      Mesh &mesh = *mesh_ptr;
+      CheckFindPoints(mesh);
+
+      // the hierarchy is balanced and the leaves have few elements
+      const ElementBVH &bvh = mesh.GetElementBVH();
+      REQUIRE(&mesh.GetElementBVH() == &bvh);
+      REQUIRE(bvh.GetDepth() <= 1 + int(ceil(log2(mesh.GetNE()))));
+      Array<int> cand;
+      double c[3] = { 0.3, 0.3, 0.3 };
+      bvh.FindCandidates(c, cand);
+      REQUIRE(cand.Size() > 0);
+      REQUIRE(cand.Size() <= 24);
+
+      // the hierarchy is rebuilt when the vertices are moved in place
+      for (int i = 0; i < mesh.GetNV(); i++) { mesh.GetVertex(i)[0] += 2.0; }
+      CheckFindPoints(mesh);
+
+      // curved high-order nodes; the Newton iteration may stagnate just above
+      // the default reference tolerance on these elements
+      mesh.SetCurvature(3);
+      mesh.Transform(CurvedMap);
+      InverseElementTransformation inv;
+      inv.SetReferenceTol(1e-12);
+      CheckFindPoints(mesh, &inv);
+
+      // ... and when the nodes are modified through GetNodes()
+      Vector &nodes = *mesh.GetNodes();
+      nodes *= 0.5;
+      CheckFindPoints(mesh, &inv);
+
+      // the hierarchy is rebuilt after refinement
+      mesh.UniformRefinement();
+      CheckFindPoints(mesh, &inv);
+      REQUIRE(mesh.GetElementBVH().sequence == mesh.GetSequence());
+      delete mesh_ptr;
+   }
+
+   // nonconforming refinement swaps the mesh with a new one, see Swap()
+   Mesh mesh(4, 4, Element::QUADRILATERAL, 1, 1.0, 1.0);
+   mesh.EnsureNCMesh();
+   CheckFindPoints(mesh);
+   Array<int> refs;
+   refs.Append(5);
+   mesh.GeneralRefinement(refs);
+   REQUIRE(mesh.GetElementBVH().mesh == &mesh);
+   CheckFindPoints(mesh);
+}
@@ -0,0 +1,175 @@
+// Copyright (c) 2010, Lawrence Livermore National Security, LLC. Produced at
+// the Lawrence Livermore National Laboratory. LLNL-CODE-443211. All Rights
+// reserved. See file COPYRIGHT for details.
+//
+// This file is part of the MFEM library. For more information and source code
+// availability see http://mfem.org.
+//
+// MFEM is free software; you can redistribute it and/or modify it under the
+// terms of the GNU Lesser General Public License (as published by the Free
+// Software Foundation) version 2.1 dated February 1999.
+
+#include "mfem.hpp"
+using namespace mfem;
+
+#include "catch.hpp"
+
+#ifdef MFEM_USE_MPI
+
+// Number of shared vertices, edges, triangles and quadrilaterals.
+static void CountShared(ParMesh &pmesh, int count[4])
+{
+   for (int j = 0; j < 4; j++) { count[j] = 0; }
+   for (int g = 1; g < pmesh.GetNGroups(); g++)
+   {
+      count[0] += pmesh.GroupNVertices(g);
+      count[1] += pmesh.GroupNEdges(g);
+      count[2] += pmesh.GroupNTriangles(g);
+      count[3] += pmesh.GroupNQuadrilaterals(g);
+   }
+}
+
+// Average of the vertex coordinates of element 'i'.
+static void ElementCenter(Mesh &mesh, int i, Vector &center)
+{
+   Array<int> v;
+   mesh.GetElementVertices(i, v);
+   center.SetSize(mesh.SpaceDimension());
+   center = 0.0;
+   for (int j = 0; j < v.Size(); j++)
+   {
+      const double *x = mesh.GetVertex(v[j]);
+      for (int d = 0; d < center.Size(); d++) { center(d) += x[d]; }
+   }
+   center /= v.Size();
+}
+
+// Read 'mesh' in parallel from a binary file and compare with the ParMesh
+// constructed from the same partitioning of the serial mesh.
+static void CompareParallelRead(Mesh &mesh)
+{
+   const char *filename = "pmesh_binary_test.mesh";
+   int np, rank;
+   MPI_Comm_size(MPI_COMM_WORLD, &np);
+   MPI_Comm_rank(MPI_COMM_WORLD, &rank);
+
+   if (rank == 0)
+   {
+      std::ofstream out(filename, std::ios::binary);
+      mesh.PrintBinary(out);
+   }
+   MPI_Barrier(MPI_COMM_WORLD);
+   ParMesh pmesh1(MPI_COMM_WORLD, filename);
+   MPI_Barrier(MPI_COMM_WORLD);
+   if (rank == 0) { remove(filename); }
+
+   // the file is read in contiguous slices of the elements
+   const int ne = mesh.GetNE();
+   Array<int> partitioning(ne);
+   for (int p = 0, i = 0; p < np; p++)
+   {
+      const int end = (int)((long long) ne*(p+1)/np);
+      for ( ; i < end; i++) { partitioning[i] = p; }
+   }
+   ParMesh pmesh2(MPI_COMM_WORLD, mesh, partitioning.GetData());
+
+   REQUIRE(pmesh1.GetNE() == pmesh2.GetNE());
+   REQUIRE(pmesh1.GetNBE() == pmesh2.GetNBE());
+   REQUIRE(pmesh1.GetNV() == pmesh2.GetNV());
+   REQUIRE(pmesh1.GetNEdges() == pmesh2.GetNEdges());
+   REQUIRE(pmesh1.GetNFaces() == pmesh2.GetNFaces());
+   REQUIRE(pmesh1.GetNGroups() == pmesh2.GetNGroups());
+   REQUIRE(pmesh1.GetNSharedFaces() == pmesh2.GetNSharedFaces());
+   int count1[4], count2[4];
+   CountShared(pmesh1, count1);
+   CountShared(pmesh2, count2);
+   for (int j = 0; j < 4; j++)
+   {
+      REQUIRE(count1[j] == count2[j]);
+   }
+   REQUIRE(pmesh1.GetGlobalNE() == mesh.GetNE());
+
+   // both meshes keep the local elements in the order of the serial mesh
+   Vector c1, c2;
+   for (int i = 0; i < pmesh1.GetNE(); i++)
+   {
+      REQUIRE(pmesh1.GetAttribute(i) == pmesh2.GetAttribute(i));
+      ElementCenter(pmesh1, i, c1);
+      ElementCenter(pmesh2, i, c2);
+      c1 -= c2;
+      REQUIRE(c1.Normlinf() < 1e-12);
+   }
+   REQUIRE(pmesh1.bdr_attributes.Size() == pmesh2.bdr_attributes.Size());
+   REQUIRE(pmesh1.attributes.Size() == pmesh2.attributes.Size());
+}
+
+TEST_CASE("Parallel binary mesh reader", "[Parallel], [ParMesh]")
+{
+   SECTION("2D triangle mesh")
+   {
+      Mesh mesh(6, 5, Element::TRIANGLE, true);
+      CompareParallelRead(mesh);
+   }
+
+   SECTION("3D hexahedral mesh")
+   {
+      Mesh mesh(4, 3, 3, Element::HEXAHEDRON);
+      CompareParallelRead(mesh);
+   }
+
+   SECTION("3D tetrahedral mesh")
+   {
+      Mesh mesh(3, 3, 3, Element::TETRAHEDRON);
+      CompareParallelRead(mesh);
+   }
+}
+
+// Compare the true dof action of a partially assembled mass + diffusion form
+// with and without ParBilinearForm::EnablePAOverlap().
+static void ComparePAOverlap(ParFiniteElementSpace &fes)
+{
+   ParBilinearForm a1(&fes), a2(&fes);
+   ParBilinearForm *a[2] = { &a1, &a2 };
+   OperatorHandle A[2];
+   Array<int> ess_tdof_list;
+   for (int i = 0; i < 2; i++)
+   {
+      a[i]->SetAssemblyLevel(AssemblyLevel::PARTIAL);
+      a[i]->AddDomainIntegrator(new DiffusionIntegrator);
+      a[i]->AddDomainIntegrator(new MassIntegrator);
+      if (i == 1) { a[i]->EnablePAOverlap(); }
+      a[i]->Assemble();
+      a[i]->FormSystemMatrix(ess_tdof_list, A[i]);
+   }
+
+   Vector x(fes.GetTrueVSize()), y1(x.Size()), y2(x.Size());
+   x.Randomize(fes.GetMyRank() + 1);
+   A[0]->Mult(x, y1);
+   A[1]->Mult(x, y2);
+   const double norm = y1.Normlinf();
+   y2 -= y1;
+   REQUIRE(y2.Normlinf() <= 1e-12*std::max(norm, 1.0));
+}
+
+TEST_CASE("Parallel PA overlap operator", "[Parallel], [ParBilinearForm]")
+{
+   for (int dim = 2; dim <= 3; dim++)
+   {
+      Mesh *mesh = (dim == 2) ? new Mesh(6, 5, Element::QUADRILATERAL) :
+                   new Mesh(4, 3, 3, Element::HEXAHEDRON);
+      ParMesh pmesh(MPI_COMM_WORLD, *mesh);
+      delete mesh;
+      for (int order = 1; order <= 3; order++)
+      {
+         H1_FECollection fec(order, dim);
+         ParFiniteElementSpace fes(&pmesh, &fec);
+         ComparePAOverlap(fes);
+
+         // vector spaces are not supported, the default operator is used
+         ParFiniteElementSpace vfes(&pmesh, &fec, 2);
+         ComparePAOverlap(vfes);
+      }
+   }
+}
+
+#endif // MFEM_USE_MPI